@@ -109,6 +109,49 @@ int my_aes_decrypt(const unsigned char *source, uint32 source_length,
                    uint32 key_length, enum my_aes_opmode mode,
                    const unsigned char *iv, bool padding = true);
 
+/** AES cipher context which keeps its expanded key between operations */
+struct my_aes_ctx;
+
+/**
+  Create an AES context, to encrypt or decrypt many buffers with the same
+  key without expanding the key for each of them.
+
+  @param key            Key to be used
+  @param key_length     Length of the key. Will handle keys of any length
+  @param mode           encryption mode
+  @param encrypt        true to encrypt, false to decrypt
+  @param padding        if padding needed.
+  @return the context, or NULL in case of error
+*/
+
+my_aes_ctx *my_aes_ctx_create(const unsigned char *key, uint32 key_length,
+                              enum my_aes_opmode mode, bool encrypt,
+                              bool padding = true);
+
+/**
+  Encrypt or decrypt a buffer with an AES context
+
+  @param ctx            context created by my_aes_ctx_create()
+  @param source         Pointer to data to encrypt or decrypt
+  @param source_length  Size of the data
+  @param dest           Buffer to place the result (must be large enough)
+  @param iv             16 bytes initialization vector if needed.
+  Otherwise NULL
+  @return size of the result, or negative in case of error
+*/
+
+int my_aes_ctx_crypt(my_aes_ctx *ctx, const unsigned char *source,
+                     uint32 source_length, unsigned char *dest,
+                     const unsigned char *iv);
+
+/**
+  Free an AES context
+
+  @param ctx            context created by my_aes_ctx_create(), or NULL
+*/
+
+void my_aes_ctx_free(my_aes_ctx *ctx);
+
 /**
   Calculate the size of a buffer large enough for encrypted data.
 
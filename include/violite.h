@@ -269,6 +269,19 @@ struct st_VioSSLFd *new_VioSSLConnectorFd(
 
 long process_tls_version(const char *tls_version);
 
+/*
+  SSL_CTX option letting OpenSSL install the keys of established connections
+  into the socket (Linux kTLS), so that the kernel encrypts and decrypts the
+  records. 0 if the library can't do it.
+*/
+#ifdef SSL_OP_ENABLE_KTLS
+#define VIO_SSL_CTX_KTLS ((long)SSL_OP_ENABLE_KTLS)
+#else
+#define VIO_SSL_CTX_KTLS 0L
+#endif /* SSL_OP_ENABLE_KTLS */
+
+const char *vio_ssl_ktls_state(SSL *ssl);
+
 int set_fips_mode(const uint fips_mode, char *err_string);
 
 uint get_fips_mode();
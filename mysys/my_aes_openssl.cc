@@ -24,6 +24,8 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
   @file mysys/my_aes_openssl.cc
 */
 
+#include <new>
+
 #include <openssl/aes.h>
 #include <openssl/bio.h>
 #include <openssl/err.h>
@@ -217,6 +219,75 @@ aes_error:
   return MY_AES_BAD_DATA;
 }
 
+struct my_aes_ctx {
+  EVP_CIPHER_CTX *ctx;
+  int encrypt;
+  bool padding;
+};
+
+my_aes_ctx *my_aes_ctx_create(const unsigned char *key, uint32 key_length,
+                              enum my_aes_opmode mode, bool encrypt,
+                              bool padding) {
+  const EVP_CIPHER *cipher = aes_evp_type(mode);
+  /* The real key to be used */
+  unsigned char rkey[MAX_AES_KEY_LENGTH / 8];
+
+  if (!cipher) return NULL;
+
+  my_aes_ctx *aes_ctx = new (std::nothrow) my_aes_ctx();
+  if (!aes_ctx) return NULL;
+
+  aes_ctx->ctx = EVP_CIPHER_CTX_new();
+  aes_ctx->encrypt = encrypt ? 1 : 0;
+  aes_ctx->padding = padding;
+
+  my_aes_create_key(key, key_length, rkey, mode);
+
+  /* Expand the key once, each operation only sets its IV */
+  if (!aes_ctx->ctx ||
+      !EVP_CipherInit_ex(aes_ctx->ctx, cipher, NULL, rkey, NULL,
+                         aes_ctx->encrypt)) {
+    ERR_clear_error();
+    my_aes_ctx_free(aes_ctx);
+    aes_ctx = NULL;
+  }
+
+  memset(rkey, 0, sizeof(rkey));
+  return aes_ctx;
+}
+
+int my_aes_ctx_crypt(my_aes_ctx *aes_ctx, const unsigned char *source,
+                     uint32 source_length, unsigned char *dest,
+                     const unsigned char *iv) {
+  EVP_CIPHER_CTX *ctx = aes_ctx->ctx;
+  int u_len, f_len;
+
+  if (EVP_CIPHER_CTX_iv_length(ctx) > 0 && !iv) return MY_AES_BAD_DATA;
+
+  if (!EVP_CipherInit_ex(ctx, NULL, NULL, NULL, iv, aes_ctx->encrypt))
+    goto aes_error; /* Error */
+  if (!EVP_CIPHER_CTX_set_padding(ctx, aes_ctx->padding))
+    goto aes_error; /* Error */
+  if (!EVP_CipherUpdate(ctx, dest, &u_len, source, source_length))
+    goto aes_error; /* Error */
+  if (!EVP_CipherFinal_ex(ctx, dest + u_len, &f_len))
+    goto aes_error; /* Error */
+
+  return u_len + f_len;
+
+aes_error:
+  /* need to explicitly clean up the error if we want to ignore it */
+  ERR_clear_error();
+  return MY_AES_BAD_DATA;
+}
+
+void my_aes_ctx_free(my_aes_ctx *aes_ctx) {
+  if (!aes_ctx) return;
+
+  if (aes_ctx->ctx) EVP_CIPHER_CTX_free(aes_ctx->ctx);
+  delete aes_ctx;
+}
+
 int my_aes_get_size(uint32 source_length, my_aes_opmode opmode) {
   const EVP_CIPHER *cipher = aes_evp_type(opmode);
   size_t block_size;
@@ -665,6 +665,7 @@ conn *conn_new(const SOCKET sfd, STATE_FUNC init_state,
     c->icurr = c->ilist;
     c->suffixcurr = c->suffixlist;
     c->ileft = 0;
+    c->bin_multi_get = false;
     c->suffixleft = 0;
     c->iovused = 0;
     c->msgcurr = 0;
@@ -716,6 +717,7 @@ static void conn_cleanup(conn *c) {
             settings.engine.v1->release(settings.engine.v0, c, *(c->icurr));
         }
     }
+    c->bin_multi_get = false;
 
     if (c->suffixleft != 0) {
         for (; c->suffixleft > 0; c->suffixleft--, c->suffixcurr++) {
@@ -1717,6 +1719,61 @@ static void complete_update_bin(conn *c) {
     }
 }
 
+/**
+ * Check if the request following the current one is a get that is already
+ * complete in the input buffer. Pipelined gets are passed to the engine as
+ * one multi-get, so it can serve them from the same cursor and read view
+ * instead of opening a new one per request. Only complete requests that
+ * dispatch_bin_command will accept count, so the batch always ends with a
+ * get that reaches the engine. The items of the batch are kept in the item
+ * list until it ends (releasing one ends the engine's multi-get), so the
+ * batch is also bounded by the initial size of that list.
+ */
+static bool bin_next_request_is_get(conn *c) {
+    protocol_binary_request_header req;
+
+    if (c->rbytes < sizeof(req) || c->ileft + 2 > ITEM_LIST_INITIAL) {
+        return false;
+    }
+
+    memcpy(&req, c->rcurr, sizeof(req));
+    if (req.request.magic != PROTOCOL_BINARY_REQ) {
+        return false;
+    }
+
+    switch (req.request.opcode) {
+    case PROTOCOL_BINARY_CMD_GET:
+    case PROTOCOL_BINARY_CMD_GETQ:
+    case PROTOCOL_BINARY_CMD_GETK:
+    case PROTOCOL_BINARY_CMD_GETKQ:
+        break;
+    default:
+        return false;
+    }
+
+    uint16_t keylen = ntohs(req.request.keylen);
+    uint32_t bodylen = ntohl(req.request.bodylen);
+    if (req.request.extlen != 0 || keylen == 0 || keylen > KEY_MAX_LENGTH ||
+        bodylen != keylen) {
+        return false;
+    }
+
+    return c->rbytes - sizeof(req) >= bodylen;
+}
+
+/**
+ * Release the items kept for a pipelined multi-get once its last response
+ * no longer needs them.
+ */
+static void bin_release_multi_get(conn *c) {
+    c->bin_multi_get = false;
+    while (c->ileft > 0) {
+        settings.engine.v1->release(settings.engine.v0, c, *(c->icurr));
+        c->icurr++;
+        c->ileft--;
+    }
+}
+
 static void process_bin_get(conn *c) {
     item *it = NULL;
 
@@ -1733,11 +1790,12 @@ static void process_bin_get(conn *c) {
         }
     }
 
+    bool next_get = bin_next_request_is_get(c);
     ENGINE_ERROR_CODE ret = c->aiostat;
     c->aiostat = ENGINE_SUCCESS;
     if (ret == ENGINE_SUCCESS) {
         ret = settings.engine.v1->get(settings.engine.v0, c, &it, key, nkey,
-                                      c->binary_header.request.vbucket);
+                                      next_get);
     }
 
     uint16_t keylen;
@@ -1778,7 +1836,14 @@ static void process_bin_get(conn *c) {
         add_iov(c, info.value[0].iov_base, info.value[0].iov_len);
         conn_set_state(c, conn_mwrite);
         /* Remember this item so we can garbage collect it later */
-        c->item = it;
+        if (c->bin_multi_get || next_get) {
+            if (c->ileft == 0) {
+                c->icurr = c->ilist;
+            }
+            c->ilist[c->ileft++] = it;
+        } else {
+            c->item = it;
+        }
         break;
     case ENGINE_KEY_ENOENT:
         STATS_MISS(c, get, key, nkey);
@@ -1821,6 +1886,19 @@ static void process_bin_get(conn *c) {
         abort();
     }
 
+    if (ret != ENGINE_EWOULDBLOCK) {
+        if (next_get) {
+            c->bin_multi_get = true;
+        } else if (c->bin_multi_get) {
+            /* The last response releases the batch once it is written */
+            if (c->state == conn_mwrite) {
+                c->bin_multi_get = false;
+            } else {
+                bin_release_multi_get(c);
+            }
+        }
+    }
+
     if (settings.detail_enabled && ret != ENGINE_EWOULDBLOCK) {
         stats_prefix_record_get(key, nkey, ret == ENGINE_SUCCESS);
     }
@@ -5524,7 +5602,8 @@ bool conn_mwrite(conn *c) {
     switch (transmit(c)) {
     case TRANSMIT_COMPLETE:
         if (c->state == conn_mwrite) {
-            while (c->ileft > 0) {
+            /* Items of an open binary multi-get stay until its last get */
+            while (c->ileft > 0 && !c->bin_multi_get) {
                 item *it = *(c->icurr);
                 settings.engine.v1->release(settings.engine.v0, c, it);
                 c->icurr++;
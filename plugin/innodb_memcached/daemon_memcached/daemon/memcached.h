@@ -339,6 +339,7 @@ struct conn {
     int    isize;
     item   **icurr;
     int    ileft;
+    bool   bin_multi_get; /* ilist holds the items of a pipelined binary get */
 
     char   **suffixlist;
     int    suffixsize;
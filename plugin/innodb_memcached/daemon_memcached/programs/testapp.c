@@ -1512,6 +1512,123 @@ static enum test_return test_binary_getkq(void) {
     return test_binary_getq_impl("test_binary_getkq", PROTOCOL_BINARY_CMD_GETKQ);
 }
 
+/*
+ * Pipeline more gets than fit in one multi-get batch, mixing hits, quiet
+ * and loud misses, and check that every response arrives in order with the
+ * right value and that the connection still serves other commands after.
+ */
+static enum test_return test_binary_pipeline_get(void) {
+    const char *keys[] = { "test_binary_pipeline_get_0",
+                           "test_binary_pipeline_get_1",
+                           "test_binary_pipeline_get_2",
+                           "test_binary_pipeline_get_3" };
+    const char *missing = "test_binary_pipeline_get_missing";
+    const int nreq = 500;
+    union {
+        protocol_binary_request_no_extras request;
+        protocol_binary_response_no_extras response;
+        char bytes[1024];
+    } temp, receive;
+    size_t len;
+    int ii;
+
+    for (ii = 0; ii < 4; ++ii) {
+        len = storage_command(temp.bytes, sizeof(temp.bytes),
+                              PROTOCOL_BINARY_CMD_SET,
+                              keys[ii], strlen(keys[ii]),
+                              keys[ii], strlen(keys[ii]), 0, 0);
+        safe_send(temp.bytes, len, false);
+        safe_recv_packet(receive.bytes, sizeof(receive.bytes));
+        validate_response_header(&receive.response, PROTOCOL_BINARY_CMD_SET,
+                                 PROTOCOL_BINARY_RESPONSE_SUCCESS);
+    }
+
+    char *send = malloc((size_t)(nreq + 1) * sizeof(temp.bytes));
+    assert(send != NULL);
+    len = 0;
+    for (ii = 0; ii < nreq; ++ii) {
+        const char *key = keys[ii % 4];
+        uint8_t cmd;
+        switch (ii % 5) {
+        case 0:
+            cmd = PROTOCOL_BINARY_CMD_GETK;
+            break;
+        case 1:
+            cmd = PROTOCOL_BINARY_CMD_GETKQ;
+            key = missing;
+            break;
+        case 2:
+            cmd = PROTOCOL_BINARY_CMD_GET;
+            break;
+        case 3:
+            cmd = PROTOCOL_BINARY_CMD_GET;
+            key = missing;
+            break;
+        default:
+            cmd = PROTOCOL_BINARY_CMD_GETQ;
+            break;
+        }
+        size_t l = raw_command(temp.bytes, sizeof(temp.bytes), cmd,
+                               key, strlen(key), NULL, 0);
+        temp.request.message.header.request.opaque = ii;
+        memcpy(send + len, temp.bytes, l);
+        len += l;
+    }
+    len += raw_command(send + len, sizeof(temp.bytes),
+                       PROTOCOL_BINARY_CMD_NOOP, NULL, 0, NULL, 0);
+    safe_send(send, len, false);
+    free(send);
+
+    for (ii = 0; ii < nreq; ++ii) {
+        if (ii % 5 == 1) {
+            /* A quiet miss doesn't answer */
+            continue;
+        }
+        safe_recv_packet(receive.bytes, sizeof(receive.bytes));
+        protocol_binary_response_header *rsp =
+            &receive.response.message.header;
+        assert(rsp->response.magic == PROTOCOL_BINARY_RES);
+        assert(rsp->response.opaque == ii);
+        if (ii % 5 == 3) {
+            assert(rsp->response.opcode == PROTOCOL_BINARY_CMD_GET);
+            assert(rsp->response.status == PROTOCOL_BINARY_RESPONSE_KEY_ENOENT);
+            continue;
+        }
+
+        const char *key = keys[ii % 4];
+        assert(rsp->response.status == PROTOCOL_BINARY_RESPONSE_SUCCESS);
+        assert(rsp->response.extlen == 4);
+        assert(rsp->response.keylen == (ii % 5 == 0 ? strlen(key) : 0));
+        assert(rsp->response.bodylen ==
+               4 + rsp->response.keylen + strlen(key));
+        const char *value = receive.bytes + sizeof(*rsp) + 4 +
+                            rsp->response.keylen;
+        assert(memcmp(value, key, strlen(key)) == 0);
+    }
+
+    safe_recv_packet(receive.bytes, sizeof(receive.bytes));
+    validate_response_header(&receive.response, PROTOCOL_BINARY_CMD_NOOP,
+                             PROTOCOL_BINARY_RESPONSE_SUCCESS);
+
+    /* The batch is over, a single get and a store work as usual */
+    len = raw_command(temp.bytes, sizeof(temp.bytes), PROTOCOL_BINARY_CMD_GET,
+                      keys[0], strlen(keys[0]), NULL, 0);
+    safe_send(temp.bytes, len, false);
+    safe_recv_packet(receive.bytes, sizeof(receive.bytes));
+    validate_response_header(&receive.response, PROTOCOL_BINARY_CMD_GET,
+                             PROTOCOL_BINARY_RESPONSE_SUCCESS);
+
+    len = storage_command(temp.bytes, sizeof(temp.bytes),
+                          PROTOCOL_BINARY_CMD_SET,
+                          keys[0], strlen(keys[0]), NULL, 0, 0, 0);
+    safe_send(temp.bytes, len, false);
+    safe_recv_packet(receive.bytes, sizeof(receive.bytes));
+    validate_response_header(&receive.response, PROTOCOL_BINARY_CMD_SET,
+                             PROTOCOL_BINARY_RESPONSE_SUCCESS);
+
+    return TEST_PASS;
+}
+
 static enum test_return test_binary_incr_impl(const char* key, uint8_t cmd) {
     union {
         protocol_binary_request_no_extras request;
@@ -2137,6 +2254,7 @@ struct testcase testcases[] = {
     { "binary_getq", test_binary_getq },
     { "binary_getk", test_binary_getk },
     { "binary_getkq", test_binary_getkq },
+    { "binary_pipeline_get", test_binary_pipeline_get },
     { "binary_incr", test_binary_incr },
     { "binary_incrq", test_binary_incrq },
     { "binary_decr", test_binary_decr },
@@ -37,18 +37,19 @@
 
 /**
   Class that builds the rewritten query by appending literals in the order
-  they appear in the parse tree.
+  they appear in the parse tree. The pattern and replacement belong to a
+  loaded rule and are only referenced, they must outlive the builder.
 */
 class Query_builder : public services::Literal_visitor {
  public:
   Query_builder(const Pattern *pattern, const Replacement *replacement)
-      : m_previous_slot(0),
-        m_replacement(replacement->query_string),
-        m_slots(replacement->slots()),
-        m_slots_iter(m_slots.begin()),
+      : m_segments(replacement->segments()),
+        m_segments_iter(m_segments.begin()),
         m_pattern_literals(pattern->literals),
         m_pattern_literals_iter(m_pattern_literals.begin()),
-        m_matches_so_far(true) {}
+        m_matches_so_far(true) {
+    m_built_query.reserve(replacement->query_string.length());
+  }
 
   /**
     Implementation of the visit() function that bridges to add_next_literal().
@@ -63,8 +64,12 @@ class Query_builder : public services::Literal_visitor {
     string to yield a complete query.
   */
   const std::string &get_built_query() {
-    // Append trailing segment of replacement.
-    m_built_query += m_replacement.substr(m_previous_slot);
+    // Append trailing segments of replacement, unfilled slots stay markers.
+    m_built_query += *m_segments_iter;
+    while (++m_segments_iter != m_segments.end()) {
+      m_built_query += '?';
+      m_built_query += *m_segments_iter;
+    }
     return m_built_query;
   }
 
@@ -81,21 +86,15 @@ class Query_builder : public services::Literal_visitor {
 
  private:
   /**
-    The index of the character in 'm_replacement' after the last slot that we
-    filled.
+    The replacement cut at its slots, the iterator is on the segment that
+    precedes the next slot to fill.
   */
-  int m_previous_slot;
-
-  /// Query we copy from (replacement string.)
-  std::string m_replacement;
-
-  /// The slots in the replacement string.
-  std::vector<int> m_slots;
-  std::vector<int>::iterator m_slots_iter;
+  const std::vector<std::string> &m_segments;
+  std::vector<std::string>::const_iterator m_segments_iter;
 
   /// All literals in the pattern, in order of appearance in parse tree.
-  std::vector<std::string> m_pattern_literals;
-  std::vector<std::string>::iterator m_pattern_literals_iter;
+  const std::vector<std::string> &m_pattern_literals;
+  std::vector<std::string>::const_iterator m_pattern_literals_iter;
 
   /// The query under construction.
   std::string m_built_query;
@@ -121,19 +120,17 @@ class Query_builder : public services::Literal_visitor {
 
 bool Query_builder::add_next_literal(MYSQL_ITEM item) {
   std::string query_literal = services::print_item(item);
-  std::string pattern_literal = *m_pattern_literals_iter;
+  const std::string &pattern_literal = *m_pattern_literals_iter;
 
   if (pattern_literal.compare("?") ==
       0) {  // Literal corresponds to a parameter marker in the pattern.
 
-    if (m_slots_iter != m_slots.end())  // There are more slots to fill
+    if (m_segments_iter + 1 !=
+        m_segments.end())  // There are more slots to fill
     {
       // The part of the replacement leading up to its corresponding slot.
-      m_built_query += m_replacement.substr(m_previous_slot,
-                                            *m_slots_iter - m_previous_slot);
+      m_built_query += *m_segments_iter++;
       m_built_query += query_literal;
-
-      m_previous_slot = *m_slots_iter++ + sizeof('?');
     }
   } else if (pattern_literal.compare(query_literal) != 0) {
     // The literal does not match the pattern nor a parameter marker, we
@@ -27,8 +27,10 @@
 #include <mysql/service_parser.h>
 #include <mysql/service_rules_table.h>
 #include <stddef.h>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
 
 #include "m_string.h"  // Needed because debug_sync.h is not self-sufficient.
 #include "my_dbug.h"
@@ -46,33 +48,44 @@ using rules_table_service::Cursor;
 using std::string;
 namespace messages = rewriter_messages;
 
-namespace {
-
-std::string hash_key_from_digest(const uchar *digest) {
-  return std::string(pointer_cast<const char *>(digest),
-                     PARSER_SERVICE_DIGEST_LENGTH);
-}
-
-}  // namespace
-
 /**
   @file rewriter.cc
   Implementation of the Rewriter class's member functions.
 */
 
-Rewriter::Rewriter() {}
+Rewriter::Rewriter()
+    : m_rules(new Rule_table(PSI_INSTRUMENT_ME)), m_epoch(0) {
+  m_readers[0] = 0;
+  m_readers[1] = 0;
+}
 
-Rewriter::~Rewriter() {}
+Rewriter::~Rewriter() { delete m_rules.load(); }
 
-bool Rewriter::load_rule(MYSQL_THD thd, Persisted_rule *diskrule) {
+/*
+  A reader registers in the slot of the epoch parity it read, then loads
+  the rules, so one that could have loaded the replaced table is counted in
+  one of the slots until it is done. Both slots are drained after the swap,
+  each right after the epoch moved away from it so that new readers do not
+  keep it busy.
+*/
+void Rewriter::wait_for_readers() {
+  for (int i = 0; i < 2; i++) {
+    const uint64 epoch = m_epoch.fetch_add(1);
+    while (m_readers[epoch & 1].load() > 0)
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+bool Rewriter::load_rule(MYSQL_THD thd, Persisted_rule *diskrule,
+                         Rule_table *rules) {
   std::unique_ptr<Rule> memrule_ptr(new Rule);
   Rule *memrule = memrule_ptr.get();
   Rule::Load_status load_status = memrule->load(thd, diskrule);
 
   switch (load_status) {
     case Rule::OK:
-      m_digests.emplace(hash_key_from_digest(memrule_ptr->digest_buffer()),
-                        std::move(memrule_ptr));
+      rules->emplace(Digest_key(memrule_ptr->digest_buffer()),
+                     std::move(memrule_ptr));
       diskrule->message = Nullable<string>();
       diskrule->pattern_digest =
           services::print_digest(memrule->digest_buffer());
@@ -130,7 +143,7 @@ void Rewriter::do_refresh(MYSQL_THD session_thd) {
     m_refresh_status = ER_REWRITER_TABLE_MALFORMED_ERROR;
     return;
   }
-  m_digests.clear();
+  std::unique_ptr<Rule_table> rules(new Rule_table(PSI_INSTRUMENT_ME));
 
   for (; c != rules_table_service::end(); ++c) {
     Persisted_rule diskrule(&c);
@@ -142,10 +155,14 @@ void Rewriter::do_refresh(MYSQL_THD session_thd) {
         diskrule.set_message("Replacement is NULL.");
         saw_rule_error = true;
       } else
-        saw_rule_error |= load_rule(session_thd, &diskrule);
+        saw_rule_error |= load_rule(session_thd, &diskrule, rules.get());
       diskrule.write_to(&c);
     }
   }
+  const Rule_table *old_rules = m_rules.exchange(rules.release());
+  wait_for_readers();
+  delete old_rules;
+
   if (c.had_serious_read_error())
     m_refresh_status = ER_REWRITER_READ_FAILED;
   else if (saw_rule_error)
@@ -184,14 +201,20 @@ longlong Rewriter::refresh(MYSQL_THD thd) {
   return m_refresh_status;
 }
 
-Rewrite_result Rewriter::rewrite_query(MYSQL_THD thd, const uchar *key) {
+Rewrite_result Rewriter::rewrite_query(MYSQL_THD thd,
+                                       const uchar *key) const {
   Rewrite_result result;
   bool digest_matched = false;
+  Rules_guard rules(this);
+
+  auto it_range = rules->equal_range(Digest_key(key));
+  if (it_range.first == it_range.second) return result;
 
-  auto it_range = m_digests.equal_range(hash_key_from_digest(key));
+  // All the candidate rules are compared to the same normalized query.
+  string normalized_query = services::get_current_query_normalized(thd);
   for (auto it = it_range.first; it != it_range.second; ++it) {
-    Rule *rule = it->second.get();
-    if (rule->matches(thd)) {
+    const Rule *rule = it->second.get();
+    if (rule->matches(normalized_query)) {
       result = rule->create_new_query(thd);
       if (result.was_rewritten) return result;
     } else {
@@ -24,6 +24,8 @@
 
 #include "my_config.h"
 
+#include <string.h>
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -41,6 +43,36 @@
 
 class Persisted_rule;
 
+/// Key of the rules hash table, the binary statement digest.
+struct Digest_key {
+  uchar buf[PARSER_SERVICE_DIGEST_LENGTH];
+
+  explicit Digest_key(const uchar *digest) {
+    memcpy(buf, digest, sizeof(buf));
+  }
+
+  bool operator==(const Digest_key &other) const {
+    return memcmp(buf, other.buf, sizeof(buf)) == 0;
+  }
+};
+
+/**
+  Digests are cryptographic hashes of the normalized statement, so their
+  leading bytes are already evenly distributed.
+*/
+struct Digest_key_hash {
+  size_t operator()(const Digest_key &key) const {
+    size_t hash;
+    memcpy(&hash, key.buf, sizeof(hash));
+    return hash;
+  }
+};
+
+/// The in-memory rules hash table.
+typedef malloc_unordered_multimap<Digest_key, std::unique_ptr<Rule>,
+                                  Digest_key_hash>
+    Rule_table;
+
 /**
   Implementation of the post parse query rewriter. The public interface
   consists of two operations: refresh(), which loads the rules from the disk
@@ -55,18 +87,27 @@ class Rewriter {
     that fail to load, this number will be lower than the number of rows in
     the database.
   */
-  int get_number_loaded_rules() const { return m_digests.size(); }
+  int get_number_loaded_rules() const {
+    Rules_guard rules(this);
+    return rules->size();
+  }
 
   ~Rewriter();
 
   /**
-    Attempts to rewrite thd's current query with digest in 'key'.
+    Attempts to rewrite thd's current query with digest in 'key'. Works on
+    the rules published when it starts and takes no lock, refresh() may run
+    concurrently.
 
     @return A Rewrite_result object.
   */
-  Rewrite_result rewrite_query(MYSQL_THD thd, const uchar *key);
+  Rewrite_result rewrite_query(MYSQL_THD thd, const uchar *key) const;
 
-  /// Empty the hashtable and reload all rules from disk table.
+  /**
+    Reload all rules from disk table into a new hash table, then swap it in
+    and free the previous one once no query is reading it. Concurrent
+    refreshes must be serialized by the caller.
+  */
   longlong refresh(MYSQL_THD thd);
 
   /**
@@ -82,12 +123,37 @@ class Rewriter {
  private:
   longlong m_refresh_status;
 
-  /// The in-memory rules hash table.
-  malloc_unordered_multimap<std::string, std::unique_ptr<Rule>> m_digests{
-      PSI_INSTRUMENT_ME};
+  /**
+    The current rules, never modified once published. Readers register in
+    the m_readers slot of the current m_epoch parity before loading it, so
+    that refresh() knows when the table it replaced can be freed.
+  */
+  std::atomic<const Rule_table *> m_rules;
+  mutable std::atomic<uint64> m_epoch;
+  mutable std::atomic<int64> m_readers[2];
+
+  /// Keeps the rules loaded at construction alive until destruction.
+  class Rules_guard {
+   public:
+    explicit Rules_guard(const Rewriter *rewriter)
+        : m_readers(&rewriter->m_readers[rewriter->m_epoch.load() & 1]) {
+      m_readers->fetch_add(1);
+      m_rules = rewriter->m_rules.load();
+    }
+    ~Rules_guard() { m_readers->fetch_sub(1); }
+
+    const Rule_table *operator->() const { return m_rules; }
+
+   private:
+    std::atomic<int64> *m_readers;
+    const Rule_table *m_rules;
+  };
+
+  /// Waits until no reader can still see a table replaced before the call.
+  void wait_for_readers();
 
   /// Loads the rule retrieved from the database in the hash table.
-  bool load_rule(MYSQL_THD thd, Persisted_rule *diskrule);
+  bool load_rule(MYSQL_THD thd, Persisted_rule *diskrule, Rule_table *rules);
 };
 
 #endif /* REWRITER_INCLUDED */
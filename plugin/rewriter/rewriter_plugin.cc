@@ -70,6 +70,10 @@ static const size_t MAX_QUERY_LENGTH_IN_LOG = 100;
 
 static MYSQL_PLUGIN plugin_info;
 
+/**
+  Serializes the reloads. Queries are rewritten against a snapshot of the
+  rules and don't take it.
+*/
 static mysql_rwlock_t LOCK_table;
 static Rewriter *rewriter;
 
@@ -333,8 +337,6 @@ static int rewrite_query_notify(
 
   if (needs_initial_load) lock_and_reload(thd);
 
-  mysql_rwlock_rdlock(&LOCK_table);
-
   Rewrite_result rewrite_result;
   try {
     rewrite_result = rewriter->rewrite_query(thd, digest);
@@ -342,8 +344,6 @@ static int rewrite_query_notify(
     LogPluginErr(ERROR_LEVEL, ER_REWRITER_OOM);
   }
 
-  mysql_rwlock_unlock(&LOCK_table);
-
   int parse_error = 0;
   if (!rewrite_result.was_rewritten)
     log_nonrewritten_query(thd, digest, rewrite_result);
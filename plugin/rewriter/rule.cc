@@ -159,10 +159,19 @@ bool Replacement::load(MYSQL_THD thd, const string replacement) {
 
   query_string = replacement;
 
+  m_segments.clear();
+  int previous_slot = 0;
+  for (int slot : m_param_slots) {
+    m_segments.push_back(
+        query_string.substr(previous_slot, slot - previous_slot));
+    previous_slot = slot + sizeof('?');
+  }
+  m_segments.push_back(query_string.substr(previous_slot));
+
   return false;
 }
 
-Rewrite_result Rule::create_new_query(MYSQL_THD thd) {
+Rewrite_result Rule::create_new_query(MYSQL_THD thd) const {
   Query_builder builder(&m_pattern, &m_replacement);
 
   services::visit_parse_tree(thd, &builder);
@@ -178,6 +187,5 @@ Rewrite_result Rule::create_new_query(MYSQL_THD thd) {
 }
 
 bool Rule::matches(MYSQL_THD thd) const {
-  string normalized_query = services::get_current_query_normalized(thd);
-  return normalized_query.compare(m_pattern.normalized_pattern) == 0;
+  return matches(services::get_current_query_normalized(thd));
 }
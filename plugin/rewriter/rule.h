@@ -112,10 +112,19 @@ class Replacement {
 
   std::vector<int> slots() const { return m_param_slots; }
 
+  /**
+    The query string cut at the parameter markers, number_parameters + 1
+    pieces. Rewrites put the literals between them without looking at the
+    query string again.
+  */
+  const std::vector<std::string> &segments() const { return m_segments; }
+
  private:
   /// The positions in query_string of each parameter ('?')
   std::vector<int> m_param_slots;
 
+  std::vector<std::string> m_segments;
+
   std::string m_parse_error_message;
 };
 
@@ -171,7 +180,7 @@ class Rule {
     @retval false Everything worked, the new query is pointed to by 'query'.
     @retval true The query did not match the pattern, nothing is allocated.
   */
-  Rewrite_result create_new_query(MYSQL_THD thd);
+  Rewrite_result create_new_query(MYSQL_THD thd) const;
 
   /**
     Asks the parser service for the current query in normalized form and
@@ -183,6 +192,11 @@ class Rule {
   */
   bool matches(MYSQL_THD thd) const;
 
+  /// Same as above with the current normalized query already at hand.
+  bool matches(const std::string &normalized_query) const {
+    return normalized_query.compare(m_pattern.normalized_pattern) == 0;
+  }
+
   std::string pattern_parse_error_message() {
     return m_pattern.parse_error_message();
   }
@@ -20,10 +20,16 @@
 
 #include "plugin/x/src/galaxy_stmt_command_handler.h"
 
+#include <algorithm>
+#include <atomic>
 #include <string>
 
+#include "plugin/x/ngs/include/ngs/mysqlx/getter_any.h"
 #include "plugin/x/src/admin_cmd_arguments.h"
+#include "plugin/x/src/custom_command_delegates.h"
 #include "plugin/x/src/notices.h"
+#include "plugin/x/src/prepare_param_handler.h"
+#include "plugin/x/src/sql_data_result.h"
 #include "plugin/x/src/sql_statement_builder.h"
 #include "plugin/x/src/xpl_client.h"
 #include "plugin/x/src/xpl_error.h"
@@ -46,6 +52,9 @@ ngs::Error_code Galaxy_stmt_command_handler::execute(
   if (msg.namespace_() == Admin_command_handler::k_mysqlx_namespace)
     return admin_stmt_execute(msg);
 
+  if (msg.namespace_() == Galaxy_kv_command_handler::k_kv_namespace)
+    return m_kv_handler.execute(msg);
+
   return ngs::Error(ER_X_INVALID_NAMESPACE, "Unknown namespace %s",
                     msg.namespace_().c_str());
 }
@@ -119,4 +128,306 @@ ngs::Error_code Galaxy_stmt_command_handler::admin_stmt_execute(
                                                   &args);
 }
 
+const char *const Galaxy_kv_command_handler::k_kv_namespace = "kv";
+
+namespace {
+/** Tables whose statements are kept prepared in one session. */
+const std::size_t k_max_cached_tables = 64;
+
+/** Max keys of one multi_get. */
+const uint32_t k_max_multi_get_keys = 1024;
+
+/** Statements kept prepared by all the sessions, well below the default
+max_prepared_stmt_count so that the kv namespace can't exhaust it. */
+const uint32_t k_max_prepared_stmts = 4096;
+
+std::atomic<uint32_t> prepared_stmts{0};
+}  // namespace
+
+ngs::Error_code Galaxy_kv_command_handler::execute(
+    const Mysqlx::Sql::GalaxyStmtExecute &msg) {
+  log_debug("%s: kv %s", m_session->client().client_id(), msg.stmt().c_str());
+
+  Op op;
+  if (msg.stmt() == "get")
+    op = Op::k_get;
+  else if (msg.stmt() == "multi_get")
+    op = Op::k_multi_get;
+  else if (msg.stmt() == "put")
+    op = Op::k_put;
+  else if (msg.stmt() == "delete")
+    op = Op::k_delete;
+  else
+    return ngs::Error(ER_X_INVALID_ADMIN_COMMAND, "Invalid %s command %s",
+                      k_kv_namespace, msg.stmt().c_str());
+
+  if (!msg.has_db_name())
+    return ngs::Error(ER_NO_DB_ERROR, "No database selected");
+
+  if (msg.args_size() < 2)
+    return ngs::Error(ER_X_CMD_NUM_ARGUMENTS,
+                      "Invalid number of arguments, expected the table and "
+                      "its values");
+
+  ngs::Error_code error;
+  const Table_key key{msg.db_name(),
+                      ngs::Getter_any::get_string_value(msg.args(0), &error)};
+  if (error) return error;
+
+  Table_info *info = nullptr;
+  error = get_table_info(key, &info);
+  if (error) return error;
+
+  const uint32_t values = msg.args_size() - 1;
+  const uint32_t row_values = op == Op::k_put
+                                  ? static_cast<uint32_t>(info->columns.size())
+                                  : static_cast<uint32_t>(
+                                        info->key_columns.size());
+  if (row_values == 0)
+    return ngs::Error(ER_X_CMD_ARGUMENT_VALUE,
+                      "Table '%s.%s' has no writable column",
+                      key.first.c_str(), key.second.c_str());
+
+  const uint32_t rows = values / row_values;
+  if (values % row_values != 0 || (op != Op::k_multi_get && rows != 1) ||
+      rows > k_max_multi_get_keys)
+    return ngs::Error(ER_X_CMD_NUM_ARGUMENTS,
+                      "Invalid number of arguments, expected %" PRIu32
+                      " values per row",
+                      row_values);
+
+  // Keys of a multi_get are padded with the last one up to a power of two,
+  // which bounds the number of statements prepared per table.
+  uint32_t stmt_rows = 1;
+  while (stmt_rows < rows) stmt_rows <<= 1;
+
+  Prepare_param_handler::Placeholder_list placeholders;
+  placeholders.reserve(stmt_rows * row_values);
+  for (uint32_t i = 0; i < stmt_rows * row_values; ++i) {
+    const uint32_t row = std::min(i / row_values, rows - 1);
+    placeholders.emplace_back(1 + row * row_values + i % row_values);
+  }
+
+  uint32_t stmt_id = 0;
+  bool one_shot = false;
+  error = get_stmt(key, info, op, stmt_rows, &stmt_id, &one_shot);
+  if (error) return error;
+
+  Prepare_param_handler param_handler(placeholders);
+  error = param_handler.prepare_parameters(msg.args());
+  if (error) return error;
+
+  Prepare_command_delegate::Notice_level notice_level;
+  if (op == Op::k_put || op == Op::k_delete)
+    notice_level.set(Prepare_command_delegate::k_send_affected_rows);
+
+  Streaming_resultset<Prepare_command_delegate> resultset(
+      m_session, msg.compact_metadata());
+  resultset.get_delegate().set_notice_level(notice_level);
+
+  auto &da = m_session->data_context();
+  error =
+      da.execute_prep_stmt(stmt_id, false, param_handler.get_params().data(),
+                           param_handler.get_params().size(), &resultset);
+  if (one_shot) deallocate_stmt(stmt_id);
+  if (error) {
+    // The table may have been altered under the prepared statements
+    evict(key);
+    if (m_session->get_notice_configuration().is_notice_enabled(
+            ngs::Notice_type::k_warning))
+      notices::send_warnings(da, m_session->proto(), true);
+  }
+  return error;
+}
+
+ngs::Error_code Galaxy_kv_command_handler::get_table_info(const Table_key &key,
+                                                          Table_info **info) {
+  auto it = m_tables.find(key);
+  if (it != m_tables.end()) {
+    *info = &it->second;
+    return ngs::Success();
+  }
+
+  if (m_tables.size() >= k_max_cached_tables) {
+    while (!m_tables.empty()) evict(m_tables.begin()->first);
+  }
+
+  Table_info table_info;
+  Sql_data_result result(&m_session->data_context());
+  try {
+    m_qb.clear();
+    m_qb.put("SELECT COLUMN_NAME FROM information_schema.KEY_COLUMN_USAGE "
+             "WHERE CONSTRAINT_NAME = 'PRIMARY' AND TABLE_SCHEMA = ")
+        .quote_string(key.first)
+        .put(" AND TABLE_NAME = ")
+        .quote_string(key.second)
+        .put(" ORDER BY ORDINAL_POSITION");
+    result.query(m_qb.get());
+    if (result.size() > 0) {
+      do {
+        table_info.key_columns.push_back(result.get<std::string>());
+      } while (result.next_row());
+    }
+
+    m_qb.clear();
+    m_qb.put("SELECT COLUMN_NAME FROM information_schema.COLUMNS "
+             "WHERE GENERATION_EXPRESSION = '' AND TABLE_SCHEMA = ")
+        .quote_string(key.first)
+        .put(" AND TABLE_NAME = ")
+        .quote_string(key.second)
+        .put(" ORDER BY ORDINAL_POSITION");
+    result.query(m_qb.get());
+    if (result.size() > 0) {
+      do {
+        table_info.columns.push_back(result.get<std::string>());
+      } while (result.next_row());
+    }
+  } catch (const ngs::Error_code &e) {
+    return e;
+  }
+
+  if (table_info.key_columns.empty())
+    return ngs::Error(ER_X_CMD_ARGUMENT_VALUE,
+                      "Table '%s.%s' doesn't exist or has no primary key",
+                      key.first.c_str(), key.second.c_str());
+
+  *info = &m_tables.emplace(key, std::move(table_info)).first->second;
+  return ngs::Success();
+}
+
+ngs::Error_code Galaxy_kv_command_handler::get_stmt(
+    const Table_key &key, Table_info *info, const Op op, const uint32_t rows,
+    uint32_t *stmt_id, bool *one_shot) {
+  const auto stmt_key = std::make_pair(op, rows);
+  auto it = info->stmt_ids.find(stmt_key);
+  if (it != info->stmt_ids.end()) {
+    *stmt_id = it->second;
+    return ngs::Success();
+  }
+
+  // "info" stays valid, only the other tables are evicted
+  *one_shot = !reserve_stmt(key);
+
+  build_query(key, *info, op, rows);
+  log_debug("KV query: %s", m_qb.get().c_str());
+
+  Prepare_resultset rset;
+  ngs::Error_code error = m_session->data_context().prepare_prep_stmt(
+      m_qb.get().data(), m_qb.get().length(), &rset);
+  if (error) {
+    if (!*one_shot) --prepared_stmts;
+    return error;
+  }
+
+  *stmt_id = rset.get_stmt_id();
+  if (!*one_shot) {
+    info->stmt_ids.emplace(stmt_key, *stmt_id);
+    ++m_prepared_stmts;
+  }
+  return ngs::Success();
+}
+
+bool Galaxy_kv_command_handler::reserve_stmt(const Table_key &key) {
+  for (bool evicted = false;; evicted = true) {
+    uint32_t n = prepared_stmts.load();
+    while (n < k_max_prepared_stmts)
+      if (prepared_stmts.compare_exchange_weak(n, n + 1)) return true;
+
+    if (evicted) return false;
+
+    // Make room with the statements of the other tables of this session
+    for (auto it = m_tables.begin(); it != m_tables.end();) {
+      const Table_key other = (it++)->first;
+      if (other != key) evict(other);
+    }
+  }
+}
+
+void Galaxy_kv_command_handler::deallocate_stmt(const uint32_t stmt_id) {
+  Empty_resultset rset;
+  m_session->data_context().deallocate_prep_stmt(stmt_id, &rset);
+}
+
+void Galaxy_kv_command_handler::build_query(const Table_key &key,
+                                            const Table_info &info,
+                                            const Op op, const uint32_t rows) {
+  m_qb.clear();
+  switch (op) {
+    case Op::k_get:
+    case Op::k_multi_get:
+      m_qb.put("SELECT * FROM ");
+      break;
+    case Op::k_put:
+      m_qb.put("INSERT INTO ");
+      break;
+    case Op::k_delete:
+      m_qb.put("DELETE FROM ");
+      break;
+  }
+  m_qb.quote_identifier(key.first).dot().quote_identifier(key.second);
+
+  // Generated columns can't be written, "put" leaves them to the server.
+  // An existing row is updated in place rather than deleted and inserted
+  // again like REPLACE does, which would fire the delete triggers and
+  // cascade to the child rows.
+  if (op == Op::k_put) {
+    m_qb.put(" (");
+    m_qb.put_list(info.columns.begin(), info.columns.end(),
+                  [](const std::string &column, Query_string_builder *qb) {
+                    qb->quote_identifier(column);
+                  });
+    m_qb.put(") VALUES (");
+    for (std::size_t i = 0; i < info.columns.size(); ++i)
+      m_qb.put(i ? ",?" : "?");
+    m_qb.put(") ON DUPLICATE KEY UPDATE ");
+
+    std::vector<std::string> values;
+    for (const auto &column : info.columns)
+      if (std::find(info.key_columns.begin(), info.key_columns.end(),
+                    column) == info.key_columns.end())
+        values.push_back(column);
+    // Only key columns, keep the row as it is
+    if (values.empty()) values.push_back(info.key_columns.front());
+
+    m_qb.put_list(values.begin(), values.end(),
+                  [](const std::string &column, Query_string_builder *qb) {
+                    qb->quote_identifier(column)
+                        .put("=VALUES(")
+                        .quote_identifier(column)
+                        .put(")");
+                  });
+    return;
+  }
+
+  m_qb.put(" WHERE (");
+  m_qb.put_list(info.key_columns.begin(), info.key_columns.end(),
+                [](const std::string &column, Query_string_builder *qb) {
+                  qb->quote_identifier(column);
+                });
+  m_qb.put(") IN (");
+  for (uint32_t row = 0; row < rows; ++row) {
+    m_qb.put(row ? ",(" : "(");
+    for (std::size_t i = 0; i < info.key_columns.size(); ++i)
+      m_qb.put(i ? ",?" : "?");
+    m_qb.put(")");
+  }
+  m_qb.put(")");
+}
+
+void Galaxy_kv_command_handler::evict(const Table_key &key) {
+  auto it = m_tables.find(key);
+  if (it == m_tables.end()) return;
+
+  const auto n_stmts = static_cast<uint32_t>(it->second.stmt_ids.size());
+  for (const auto &stmt : it->second.stmt_ids) deallocate_stmt(stmt.second);
+  m_prepared_stmts -= n_stmts;
+  prepared_stmts -= n_stmts;
+  m_tables.erase(it);
+}
+
+void Galaxy_kv_command_handler::forget_stmts() {
+  prepared_stmts -= m_prepared_stmts;
+  m_prepared_stmts = 0;
+}
+
 }  // namespace xpl
@@ -21,6 +21,12 @@
 #ifndef PLUGIN_X_SRC_GALAXY_STMT_COMMAND_HANDLER_H_
 #define PLUGIN_X_SRC_GALAXY_STMT_COMMAND_HANDLER_H_
 
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "plugin/x/ngs/include/ngs/error_code.h"
 #include "plugin/x/ngs/include/ngs/interface/sql_session_interface.h"
 #include "plugin/x/ngs/include/ngs/protocol_fwd.h"
@@ -29,6 +35,66 @@
 
 namespace xpl {
 
+/**
+  Point access by primary key on a table, the "kv" namespace of
+  GalaxyStmtExecute. The statement is one of "get", "multi_get", "put" and
+  "delete", the first argument is the table of the schema in db_name and the
+  others are the primary key values (for "put", a value for every column
+  that is not generated, in table order). The statements of a table are
+  prepared on first use and reused for the rest of the session, so the point
+  reads and writes skip the parser. They run in the session transaction like
+  any other statement. The statements kept prepared are bounded for the
+  whole server, past the bound a statement is prepared for one execution.
+*/
+class Galaxy_kv_command_handler {
+ public:
+  static const char *const k_kv_namespace;
+
+  explicit Galaxy_kv_command_handler(ngs::Session_interface *session)
+      : m_session{session} {}
+
+  /** The server frees the statements with the session. */
+  ~Galaxy_kv_command_handler() { forget_stmts(); }
+
+  ngs::Error_code execute(const Mysqlx::Sql::GalaxyStmtExecute &msg);
+
+  /** Forget the prepared statements, the server freed them on reset. */
+  void reset() {
+    forget_stmts();
+    m_tables.clear();
+  }
+
+ private:
+  enum class Op { k_get, k_multi_get, k_put, k_delete };
+
+  struct Table_info {
+    std::vector<std::string> key_columns;
+    /** Columns that are not generated, the ones "put" writes. */
+    std::vector<std::string> columns;
+    /** Server statement ids by operation and number of keys. */
+    std::map<std::pair<Op, uint32_t>, uint32_t> stmt_ids;
+  };
+
+  using Table_key = std::pair<std::string, std::string>;
+
+  ngs::Error_code get_table_info(const Table_key &key, Table_info **info);
+  ngs::Error_code get_stmt(const Table_key &key, Table_info *info, const Op op,
+                           const uint32_t rows, uint32_t *stmt_id,
+                           bool *one_shot);
+  void build_query(const Table_key &key, const Table_info &info, const Op op,
+                   const uint32_t rows);
+  bool reserve_stmt(const Table_key &key);
+  void deallocate_stmt(const uint32_t stmt_id);
+  void evict(const Table_key &key);
+  void forget_stmts();
+
+  xpl::Query_string_builder m_qb{1024};
+  ngs::Session_interface *m_session;
+  std::map<Table_key, Table_info> m_tables;
+  /** Statements of m_tables, counted in the server wide bound. */
+  uint32_t m_prepared_stmts{0};
+};
+
 class Galaxy_stmt_command_handler {
  public:
   explicit Galaxy_stmt_command_handler(ngs::Session_interface *session)
@@ -36,6 +102,8 @@ class Galaxy_stmt_command_handler {
 
   ngs::Error_code execute(const Mysqlx::Sql::GalaxyStmtExecute &msg);
 
+  void reset() { m_kv_handler.reset(); }
+
  private:
   ngs::Error_code sql_stmt_execute(const Mysqlx::Sql::GalaxyStmtExecute &msg);
   ngs::Error_code deprecated_admin_stmt_execute(
@@ -45,6 +113,7 @@ class Galaxy_stmt_command_handler {
   xpl::Query_string_builder m_qb{1024};
   ngs::Session_interface *m_session;
   xpl::Admin_command_handler m_admin_handler{m_session};
+  Galaxy_kv_command_handler m_kv_handler{m_session};
 };
 
 }  // namespace xpl
@@ -142,5 +142,6 @@ ngs::Error_code Dispatcher::on_expect_close() {
 
 void Dispatcher::reset() {
   m_prepare_handler = Prepare_command_handler{m_session};
+  m_galaxy_stmt_handler.reset();
 }
 }  // namespace xpl
@@ -18,8 +18,12 @@
    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
 
 #include "sql/ccl/ccl.h"
+
+#include <algorithm>
+
 #include "errmsg.h"
 #include "mysql/plugin.h"
+#include "my_systime.h"
 #include "mysqld_error.h"
 #include "mysys_err.h"
 #include "sql/ccl/ccl_common.h"
@@ -44,6 +48,13 @@ ulong ccl_wait_timeout = CCL_LONG_WAIT;
 /* The max waiting count when concurrency control */
 ulonglong ccl_max_waiting_count = CCL_DEFAULT_WAITING_COUNT; 
 
+/* The latency (percent of the baseline) adaptive concurrency control
+   tolerates */
+ulong ccl_adaptive_latency_tolerance = 0;
+
+/* The lowest limit that adaptive concurrency control shrinks to */
+ulong ccl_adaptive_min_concurrency = CCL_ADAPTIVE_MIN_CONCURRENCY_DEFAULT;
+
 /**
   Comply the rule when execute the statement.
 
@@ -78,7 +89,7 @@ bool Ccl_comply::comply_rule(enum_sql_command sql_command,
   if ((slot = rule_set->comply_rule(all_tables, query, &version))) {
     m_version = version;
     m_slot = slot;
-    m_slot->enter_cond(m_thd, m_version);
+    m_start_time = m_slot->enter_cond(m_thd, m_version) ? my_micro_time() : 0;
     DBUG_RETURN(true);
   }
   DBUG_RETURN(false);
@@ -114,7 +125,7 @@ bool Ccl_comply::comply_queue(THD *thd, LEX *lex, Ccl_queue_hint *hint) {
   if ((slot = rule_set->comply_queue(hash_value, &version))) {
     m_version = version;
     m_slot = slot;
-    m_slot->enter_cond(m_thd, m_version);
+    m_start_time = m_slot->enter_cond(m_thd, m_version) ? my_micro_time() : 0;
     DBUG_RETURN(true);
   }
 
@@ -127,9 +138,13 @@ bool Ccl_comply::comply_queue(THD *thd, LEX *lex, Ccl_queue_hint *hint) {
 */
 void Ccl_comply::comply_end() {
   if (m_slot) {
-    m_slot->exit_cond();
+    ulonglong latency = 0;
+    if (m_start_time != 0)
+      latency = std::max<ulonglong>(my_micro_time() - m_start_time, 1);
+    m_slot->exit_cond(latency);
     m_slot = nullptr;
     m_version = 0;
+    m_start_time = 0;
   }
 }
 
@@ -645,6 +660,7 @@ static Ccl_show_result *get_ccl_result(MEM_ROOT *mem_root,
   result->ordered.length = 1;
 
   result->concurrency_count = rule->get_concurrency_count();
+  result->current_limit = rule->get_slot()->get_limit();
   result->matched = rule->get_matched();
   result->running = rule->get_slot()->get_running();
   result->waiting = rule->get_slot()->get_waiting();
@@ -906,12 +922,70 @@ bool Ccl_slot::acquire(ulonglong version, ulonglong cc_count) {
   DBUG_RETURN(success);
 }
 
+/**
+  The limit in force, the last adapted limit kept between floor and ceiling.
+*/
+ulonglong Ccl_adaptive_limit::get(ulonglong ceiling, ulonglong floor) const {
+  return std::min<ulonglong>(std::max<ulonglong>(m_limit, floor), ceiling);
+}
+
+/**
+  Sample the latency of one statement, once a limit worth of statements have
+  been sampled, the baseline follows the average latency and the limit is
+  adjusted by the gradient between the target and the average.
+*/
+void Ccl_adaptive_limit::sample(ulonglong latency, ulonglong ceiling,
+                                ulonglong floor, ulonglong tolerance,
+                                bool waiting) {
+  if (tolerance == 0 || ceiling == 0 || latency == 0) return;
+
+  ulonglong limit = get(ceiling, floor);
+  m_sample_count++;
+  m_sample_latency += latency;
+  if (m_sample_count < limit) return;
+
+  ulonglong average = m_sample_latency / m_sample_count;
+  if (m_baseline == 0 || average < m_baseline)
+    m_baseline = average;
+  else
+    m_baseline += (average - m_baseline) / CCL_ADAPTIVE_BASELINE_DRIFT;
+
+  ulonglong target =
+      m_baseline * std::max<ulonglong>(tolerance, CCL_ADAPTIVE_MIN_TOLERANCE) /
+      100;
+  if (average > target)
+    limit = std::max<ulonglong>(
+        static_cast<ulonglong>(limit * (static_cast<double>(target) / average)),
+        limit / 2);
+  else if (waiting)
+    limit++;
+
+  m_limit = std::min<ulonglong>(std::max<ulonglong>(limit, floor), ceiling);
+  m_sample_count = 0;
+  m_sample_latency = 0;
+}
+
+/**
+  The limit currently applied, it's the concurrency count of the rule
+  unless adaptive concurrency control is enabled.
+*/
+ulonglong Ccl_slot::get_limit() const {
+  if (ccl_adaptive_latency_tolerance == 0 || m_concurrency_count == 0)
+    return m_concurrency_count;
+
+  return m_adaptive.get(m_concurrency_count, ccl_adaptive_min_concurrency);
+}
+
 /**
   Enter the condition.
 
   @param[in]    version     the thread local version.
+
+  @retval       true        Admitted
+  @retval       false       Refused
 */
-void Ccl_slot::enter_cond(THD *thd, ulonglong version) {
+bool Ccl_slot::enter_cond(THD *thd, ulonglong version) {
+  bool admitted = false;
   int wait_result = 0;
   struct timespec abs_timeout;
   ulonglong timeout_cnt = 0;
@@ -944,11 +1018,12 @@ void Ccl_slot::enter_cond(THD *thd, ulonglong version) {
     1) retry times is not more than ccl_wait_timeout.
     2) slot is active.
     3) version is equal thread local version. it demostrate rule is not changed.
-    4) running thread is more than concurrency control limit.
+    4) running thread is more than concurrency control limit, which is
+       adjusted by statement latency if adaptive.
     5) thd is not killed.
   */
   while (timeout_cnt < max_times && m_state.load() == true &&
-         version == m_version && m_running > m_concurrency_count &&
+         version == m_version && m_running > get_limit() &&
          !thd->is_killed()) {
     /* Decrease the running and increase the waiting */
     m_running--;
@@ -960,6 +1035,7 @@ void Ccl_slot::enter_cond(THD *thd, ulonglong version) {
     m_waiting--;
     m_running++;
   }
+  admitted = true;
 
 end:
   thd_wait_end(thd);
@@ -975,15 +1051,20 @@ end:
     my_sleep(10 * 1000 * 1000);
   });
 
-  DBUG_VOID_RETURN;
+  DBUG_RETURN(admitted);
 }
 /**
   Exit the condition.
+
+  @param[in]    latency     statement latency (microsecond),
+                            0 if it wasn't admitted.
 */
-void Ccl_slot::exit_cond() {
+void Ccl_slot::exit_cond(ulonglong latency) {
   DBUG_ENTER("Ccl_slot::exit_cond");
   lock();
   m_running--;
+  m_adaptive.sample(latency, m_concurrency_count, ccl_adaptive_min_concurrency,
+                    ccl_adaptive_latency_tolerance, m_waiting > 0);
   mysql_cond_broadcast(&m_cond);
   unlock();
   DBUG_VOID_RETURN;
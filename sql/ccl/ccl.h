@@ -41,6 +41,15 @@
 /* The default max wait thread */
 #define CCL_DEFAULT_WAITING_COUNT ((ulonglong)0L)
 
+/* The default lowest limit that adaptive concurrency control shrinks to */
+#define CCL_ADAPTIVE_MIN_CONCURRENCY_DEFAULT ((ulong)1L)
+
+/* The lowest tolerance (percent of the baseline latency) that makes sense */
+#define CCL_ADAPTIVE_MIN_TOLERANCE 100
+
+/* The baseline latency moves 1/N of the way up to a slower window */
+#define CCL_ADAPTIVE_BASELINE_DRIFT 16
+
 class TABLE_LIST;
 class THD;
 class LEX;
@@ -56,6 +65,14 @@ extern ulong ccl_wait_timeout;
 /* The max waiting count when concurrency control */
 extern ulonglong ccl_max_waiting_count;
 
+/* The latency (percent of the baseline latency of each rule) that adaptive
+   concurrency control tolerates, 0 means the rule concurrency count is
+   applied as it is */
+extern ulong ccl_adaptive_latency_tolerance;
+
+/* The lowest limit that adaptive concurrency control shrinks to */
+extern ulong ccl_adaptive_min_concurrency;
+
 /* Result structure for show_ccl_rule */
 typedef struct Ccl_show_result {
   ulonglong id;
@@ -63,6 +80,7 @@ typedef struct Ccl_show_result {
   LEX_STRING schema;
   LEX_STRING table;
   ulonglong concurrency_count;
+  ulonglong current_limit;
   LEX_STRING state;
   LEX_STRING ordered;
   ulonglong matched;
@@ -77,6 +95,7 @@ typedef struct Ccl_show_result {
     schema = {nullptr, 0};
     table = {nullptr, 0};
     concurrency_count = 0;
+    current_limit = 0;
     matched = 0;
     running = 0;
     waiting = 0;
@@ -88,7 +107,8 @@ typedef struct Ccl_show_result {
 */
 class Ccl_comply {
  public:
-  explicit Ccl_comply(THD *thd) : m_thd(thd), m_slot(nullptr), m_version(0) {}
+  explicit Ccl_comply(THD *thd)
+      : m_thd(thd), m_slot(nullptr), m_version(0), m_start_time(0) {}
 
   ~Ccl_comply();
 
@@ -132,6 +152,8 @@ class Ccl_comply {
   THD *m_thd;
   Ccl_slot *m_slot;
   ulonglong m_version;
+  /* When the statement was admitted, 0 if it was refused */
+  ulonglong m_start_time;
 };
 
 /**
@@ -647,6 +669,60 @@ class System_ccl : public PSI_memory_base, public Disable_copy_base {
   Ccl_rule_set m_queue_bucket_set;
 };
 
+/**
+  Gradient style adaptive limit of one ccl slot.
+
+  The baseline is the lowest average latency the slot has shown, it drifts
+  up slowly when the workload gets lastingly slower. Once a limit worth of
+  statements have finished, the limit is scaled by target / average if the
+  average latency is over the target (baseline * tolerance), but at most
+  halved; it's raised by one if the target is met while others are waiting.
+*/
+class Ccl_adaptive_limit {
+ public:
+  Ccl_adaptive_limit() { reset(0); }
+
+  void reset(ulonglong limit) {
+    m_limit = limit;
+    m_sample_count = 0;
+    m_sample_latency = 0;
+    m_baseline = 0;
+  }
+
+  /**
+    The limit in force.
+
+    @param[in]    ceiling     concurrency count of the rule
+    @param[in]    floor       the lowest limit
+  */
+  ulonglong get(ulonglong ceiling, ulonglong floor) const;
+
+  /**
+    Sample the latency of one statement, adjust the limit once enough
+    statements have been sampled.
+
+    @param[in]    latency     statement latency (microsecond)
+    @param[in]    ceiling     concurrency count of the rule
+    @param[in]    floor       the lowest limit
+    @param[in]    tolerance   percent of the baseline latency tolerated
+    @param[in]    waiting     whether statements are waiting
+  */
+  void sample(ulonglong latency, ulonglong ceiling, ulonglong floor,
+              ulonglong tolerance, bool waiting);
+
+  ulonglong get_baseline() const { return m_baseline; }
+
+ private:
+  /* Adaptive limit */
+  ulonglong m_limit;
+  /* Statements sampled since the limit was last adjusted */
+  ulonglong m_sample_count;
+  /* Total latency of the sampled statements */
+  ulonglong m_sample_latency;
+  /* Baseline latency (microsecond), 0 until the first window */
+  ulonglong m_baseline;
+};
+
 /**
   Ccl rule only keeped the static configure.
   Every valid rule will has corresponding slot which maintained
@@ -677,16 +753,27 @@ class Ccl_slot {
 
     @param[in]    thd         thread context.
     @param[in]    version     the thread local version.
+
+    @retval       true        Admitted
+    @retval       false       Refused
   */
-  void enter_cond(THD *thd, ulonglong version);
+  bool enter_cond(THD *thd, ulonglong version);
 
   /**
     Exit the condition.
+
+    @param[in]    latency     statement latency (microsecond),
+                              0 if it wasn't admitted.
   */
-  void exit_cond();
+  void exit_cond(ulonglong latency);
 
-  void set_concurrency(ulonglong value) { m_concurrency_count = value; }
-  void reset_concurrency() { m_concurrency_count = 0; }
+  void set_concurrency(ulonglong value) {
+    m_concurrency_count = value;
+    m_adaptive.reset(value);
+  }
+  void reset_concurrency() { set_concurrency(0); }
+  /* The limit currently applied */
+  ulonglong get_limit() const;
   ulonglong get_version() const { return m_version; }
   ulonglong get_running() const { return m_running; }
   ulonglong get_waiting() const { return m_waiting; }
@@ -697,8 +784,10 @@ class Ccl_slot {
  private:
   mysql_mutex_t m_mutex;
   mysql_cond_t m_cond;
-  /* Concurrency count from ccl rule */
+  /* Concurrency count from ccl rule, the ceiling of the adaptive limit */
   ulonglong m_concurrency_count;
+  /* Limit adapted to the statement latency */
+  Ccl_adaptive_limit m_adaptive;
   /* Running count */
   ulonglong m_running;
   /* Waiting count */
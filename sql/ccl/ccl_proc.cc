@@ -290,6 +290,7 @@ void Sql_cmd_ccl_proc_show::send_result(THD *thd, bool error) {
     protocol->store_string(result->ordered.str, result->ordered.length,
                            system_charset_info);
     protocol->store(result->concurrency_count);
+    protocol->store(result->current_limit);
     protocol->store(result->matched);
     protocol->store(result->running);
     protocol->store(result->waiting);
@@ -335,6 +336,7 @@ void Sql_cmd_ccl_proc_show_queue::send_result(THD *thd, bool error) {
     protocol->store_string(result->type.str, result->type.length,
                            system_charset_info);
     protocol->store(result->concurrency_count);
+    protocol->store(result->current_limit);
     protocol->store(result->matched);
     protocol->store(result->running);
     protocol->store(result->waiting);
@@ -302,6 +302,7 @@ class Ccl_proc_show : public Ccl_proc_base {
     COLUMN_STATE,
     COLUMN_ORDERED,
     COLUMN_CCC,
+    COLUMN_LIMIT,
     COLUMN_MATCHED,
     COLUMN_RUNNING,
     COLUMN_WAITTING,
@@ -322,6 +323,7 @@ class Ccl_proc_show : public Ccl_proc_base {
         {MYSQL_TYPE_VARCHAR, C_STRING_WITH_LEN("STATE"), 16},
         {MYSQL_TYPE_VARCHAR, C_STRING_WITH_LEN("ORDER"), 16},
         {MYSQL_TYPE_LONGLONG, C_STRING_WITH_LEN("CONCURRENCY_COUNT"), 0},
+        {MYSQL_TYPE_LONGLONG, C_STRING_WITH_LEN("CURRENT_LIMIT"), 0},
         {MYSQL_TYPE_LONGLONG, C_STRING_WITH_LEN("MATCHED"), 0},
         {MYSQL_TYPE_LONGLONG, C_STRING_WITH_LEN("RUNNING"), 0},
         {MYSQL_TYPE_LONGLONG, C_STRING_WITH_LEN("WAITTING"), 0},
@@ -427,6 +429,7 @@ class Ccl_proc_show_queue : public Ccl_proc_base {
     COLUMN_ID = 0,
     COLUMN_TYPE,
     COLUMN_CCC,
+    COLUMN_LIMIT,
     COLUMN_MATCHED,
     COLUMN_RUNNING,
     COLUMN_WAITTING,
@@ -442,6 +445,7 @@ class Ccl_proc_show_queue : public Ccl_proc_base {
         {MYSQL_TYPE_LONGLONG, C_STRING_WITH_LEN("ID"), 0},
         {MYSQL_TYPE_VARCHAR, C_STRING_WITH_LEN("TYPE"), 64},
         {MYSQL_TYPE_LONGLONG, C_STRING_WITH_LEN("CONCURRENCY_COUNT"), 0},
+        {MYSQL_TYPE_LONGLONG, C_STRING_WITH_LEN("CURRENT_LIMIT"), 0},
         {MYSQL_TYPE_LONGLONG, C_STRING_WITH_LEN("MATCHED"), 0},
         {MYSQL_TYPE_LONGLONG, C_STRING_WITH_LEN("RUNNING"), 0},
         {MYSQL_TYPE_LONGLONG, C_STRING_WITH_LEN("WAITTING"), 0}};
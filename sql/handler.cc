@@ -7819,6 +7819,50 @@ int handler::ha_write_row(uchar *buf) {
   return 0;
 }
 
+int handler::write_rows(uchar **records, uint count) {
+  int error = 0;
+  for (uint i = 0; i < count; i++) {
+    if (records[i] != table->record[0])
+      memcpy(table->record[0], records[i], table->s->reclength);
+    if ((error = write_row(table->record[0]))) break;
+  }
+  return error;
+}
+
+int handler::ha_write_rows(uchar **records, uint count) {
+  int error;
+  Log_func *log_func = Write_rows_log_event::binlog_row_logging_function;
+  DBUG_ASSERT(table_share->tmp_table != NO_TMP_TABLE || m_lock_type == F_WRLCK);
+  DBUG_ASSERT(table->next_number_field == nullptr);
+  DBUG_ASSERT(has_transactions());
+
+  DBUG_TRACE;
+  DBUG_EXECUTE_IF("inject_error_ha_write_row", return HA_ERR_INTERNAL_ERROR;);
+
+  if (operating_on_xengine_during_xa(ha_thd(), ht)) {
+    // X-Engine currently do not support executing xa dml
+    return HA_ERR_UNSUPPORTED;
+  }
+
+  mark_trx_read_write();
+
+  MYSQL_TABLE_IO_WAIT(PSI_TABLE_WRITE_ROW, MAX_KEY, error,
+                      { error = write_rows(records, count); })
+
+  /* The statement is rolled back, with whatever rows got inserted */
+  if (unlikely(error)) return error;
+
+  /* Logged from record[0], as the write set extraction reads it */
+  for (uint i = 0; i < count; i++) {
+    if (records[i] != table->record[0])
+      memcpy(table->record[0], records[i], table->s->reclength);
+    if (unlikely((error = binlog_log_row(table, 0, table->record[0], log_func))))
+      return error; /* purecov: inspected */
+  }
+
+  return 0;
+}
+
 int handler::ha_update_row(const uchar *old_data, uchar *new_data) {
   int error;
   DBUG_ASSERT(table_share->tmp_table != NO_TMP_TABLE || m_lock_type == F_WRLCK);
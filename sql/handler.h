@@ -525,6 +525,13 @@ enum enum_alter_inplace_result {
 */
 #define HA_MULTI_VALUED_KEY_SUPPORT (1LL << 55)
 
+/**
+  The storage engine inserts a batch of rows given to write_rows() cheaper
+  than one by one, the SQL layer then buffers rows of plain INSERT
+  statements and hands them over in batches.
+*/
+#define HA_CAN_WRITE_ROWS_BATCH (1LL << 56)
+
 /*
   Bits in index_flags(index_number) for what you can do with index.
   If you do not implement indexes, just return zero here.
@@ -4391,6 +4398,14 @@ class handler {
   */
   int ha_external_lock(THD *thd, int lock_type);
   int ha_write_row(uchar *buf);
+  /**
+    Insert a batch of rows, the statement is rolled back if it fails.
+
+    @param records  the row images, in record[0] format
+    @param count    number of rows
+    @return error status of the failed row, which is left in record[0]
+  */
+  int ha_write_rows(uchar **records, uint count);
   /**
     Update the current row.
 
@@ -6033,6 +6048,28 @@ class handler {
   */
   virtual int delete_table(const char *name, const dd::Table *table_def);
 
+  /**
+    Write a batch of rows.
+
+    The caller makes sure that no auto-increment value is to be generated,
+    and rolls the statement back if a row fails. So the engine may insert
+    the rows in any order, e.g. sorted by key, and stop at the first row
+    that fails, leaving it in record[0] so that the error can be reported
+    as for write_row().
+
+    The default implementation copies every row to record[0] and calls
+    write_row(), engines announcing HA_CAN_WRITE_ROWS_BATCH override it and
+    may call it for the rows they do not batch themselves.
+
+    @param records  the row images, in record[0] format
+    @param count    number of rows
+
+    @return Operation status of the failed row.
+      @retval    0  Success.
+      @retval != 0  Error code.
+  */
+  virtual int write_rows(uchar **records, uint count);
+
  private:
   /* Private helpers */
   void mark_trx_read_write();
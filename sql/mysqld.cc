@@ -8413,6 +8413,16 @@ static int show_ssl_get_version(THD *thd, SHOW_VAR *var, char *) {
   return 0;
 }
 
+static int show_ssl_get_ktls_state(THD *thd, SHOW_VAR *var, char *) {
+  SSL_handle ssl = thd->get_ssl();
+  var->type = SHOW_CHAR;
+  if (ssl)
+    var->value = const_cast<char *>(vio_ssl_ktls_state(ssl));
+  else
+    var->value = const_cast<char *>("");
+  return 0;
+}
+
 static int show_ssl_session_reused(THD *thd, SHOW_VAR *var, char *buff) {
   SSL_handle ssl = thd->get_ssl();
   var->type = SHOW_LONG;
@@ -8749,6 +8759,8 @@ SHOW_VAR status_vars[] = {
     {"Ssl_finished_connects",
      (char *)&SslAcceptorContext::show_ssl_ctx_sess_connect_good, SHOW_FUNC,
      SHOW_SCOPE_GLOBAL},
+    {"Ssl_kernel_offload", (char *)&show_ssl_get_ktls_state, SHOW_FUNC,
+     SHOW_SCOPE_ALL},
     {"Ssl_session_cache_hits",
      (char *)&SslAcceptorContext::show_ssl_ctx_sess_hits, SHOW_FUNC,
      SHOW_SCOPE_GLOBAL},
@@ -29,6 +29,7 @@
 #include <errno.h>
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include <atomic>
 #include <map>
 #include <utility>
@@ -107,6 +108,11 @@ namespace dd {
 class Table;
 }  // namespace dd
 
+ulong write_rows_batch_size = WRITE_ROWS_BATCH_SIZE_DEFAULT;
+
+/* The max memory of the rows buffered by Write_rows_batch */
+static const size_t WRITE_ROWS_BATCH_MAX_BYTES = 1024 * 1024;
+
 static bool check_view_insertability(THD *thd, TABLE_LIST *view,
                                      const TABLE_LIST *insert_table_ref);
 
@@ -508,6 +514,11 @@ bool Sql_cmd_insert_values::execute_inner(THD *thd) {
         return true;
     }
 
+    Write_rows_batch write_rows_batch;
+    if (insert_many_values.elements > 1 && !returning_stmt.is_returning() &&
+        write_rows_batch.init(thd, insert_table, info))
+      return true; /* purecov: inspected */
+
     THD_STAGE_INFO(thd, stage_update);
     if (duplicates == DUP_REPLACE &&
         (!insert_table->triggers ||
@@ -618,7 +629,12 @@ bool Sql_cmd_insert_values::execute_inner(THD *thd) {
         continue;
       }
 
-      if (write_record(thd, insert_table, &info, &update)) {
+      if (write_rows_batch.is_active()) {
+        if (write_rows_batch.add(&info)) {
+          has_error = true;
+          break;
+        }
+      } else if (write_record(thd, insert_table, &info, &update)) {
         has_error = true;
         break;
       }
@@ -631,6 +647,8 @@ bool Sql_cmd_insert_values::execute_inner(THD *thd) {
 
       thd->get_stmt_da()->inc_current_row_for_condition();
     }
+
+    if (!has_error && write_rows_batch.flush(&info)) has_error = true;
   }  // Statement plan is available within these braces
 
   DBUG_ASSERT(has_error == thd->get_stmt_da()->is_error());
@@ -2021,6 +2039,89 @@ before_trg_err:
   return true;
 }
 
+/**
+  Set up the buffer if the statement can insert rows in batches: the engine
+  supports it, and no row needs to be seen by anything before the next one
+  is inserted.
+
+  @param thd    Thread context
+  @param table  The table inserted into
+  @param info   The INSERT part of the statement
+
+  @returns true if out of memory
+*/
+bool Write_rows_batch::init(THD *thd, TABLE *table, const COPY_INFO &info) {
+  DBUG_ASSERT(!is_active());
+  if (write_rows_batch_size <= 1 ||
+      !(table->file->ha_table_flags() & HA_CAN_WRITE_ROWS_BATCH) ||
+      !table->file->has_transactions() ||
+      (thd->lex->sql_command != SQLCOM_INSERT &&
+       thd->lex->sql_command != SQLCOM_INSERT_SELECT) ||
+      info.get_duplicate_handling() != DUP_ERROR || thd->lex->is_ignore() ||
+      /* Functions of the statement may read the table */
+      thd->locked_tables_mode > LTM_LOCK_TABLES || thd->lex->is_explain() ||
+      table->triggers != nullptr || table->found_next_number_field != nullptr ||
+      /* The blob values aren't copied along with the record */
+      table->s->blob_fields > 0 || table->s->foreign_keys > 0 ||
+      table->file->referenced_by_foreign_key())
+    return false;
+
+  m_size = static_cast<uint>(std::min<size_t>(
+      write_rows_batch_size, WRITE_ROWS_BATCH_MAX_BYTES / table->s->reclength));
+  if (m_size <= 1) return false;
+
+  uchar **records = static_cast<uchar **>(
+      thd->alloc(m_size * (sizeof(uchar *) + table->s->reclength)));
+  if (records == nullptr) return true; /* purecov: inspected */
+
+  uchar *record = reinterpret_cast<uchar *>(records + m_size);
+  for (uint i = 0; i < m_size; i++, record += table->s->reclength)
+    records[i] = record;
+  m_table = table;
+  m_records = records;
+  m_count = 0;
+  return false;
+}
+
+/**
+  Buffer the row in record[0], the batch is inserted once full.
+
+  @param info   The INSERT part of the statement
+
+  @returns true if an error is reported
+*/
+bool Write_rows_batch::add(COPY_INFO *info) {
+  DBUG_ASSERT(is_active() && m_count < m_size);
+  info->stats.records++;
+  memcpy(m_records[m_count++], m_table->record[0], m_table->s->reclength);
+  return m_count == m_size ? flush(info) : false;
+}
+
+/**
+  Insert the buffered rows, a failed row is reported as by write_record()
+  and the statement is rolled back.
+
+  @param info   The INSERT part of the statement
+
+  @returns true if an error is reported
+*/
+bool Write_rows_batch::flush(COPY_INFO *info) {
+  if (m_count == 0) return false;
+
+  const uint count = m_count;
+  m_count = 0;
+  const int error = m_table->file->ha_write_rows(m_records, count);
+  if (error) {
+    info->last_errno = error;
+    myf error_flags = MYF(0);
+    if (m_table->file->is_fatal_error(error)) error_flags |= ME_FATALERROR;
+    m_table->file->print_error(error, error_flags);
+    return true;
+  }
+  info->stats.copied += count;
+  return false;
+}
+
 /**
   Check that all fields with arn't null_fields are used
 
@@ -2130,7 +2231,7 @@ bool Query_result_insert::start_execution(THD *thd) {
     table->file->ha_start_bulk_insert((ha_rows)0);
     bulk_insert_started = true;
   }
-  return false;
+  return m_write_rows_batch.init(thd, table, info);
 }
 
 void Query_result_insert::cleanup(THD *thd) {
@@ -2176,7 +2277,10 @@ bool Query_result_insert::send_data(THD *thd, List<Item> &values) {
     return thd->is_error();
   }
 
-  error = write_record(thd, table, &info, &update);
+  if (m_write_rows_batch.is_active())
+    error = m_write_rows_batch.add(&info);
+  else
+    error = write_record(thd, table, &info, &update);
 
   DEBUG_SYNC(thd, "create_select_after_write_rows_event");
 
@@ -2242,6 +2346,9 @@ bool Query_result_insert::send_eof(THD *thd) {
              ("trans_table=%d, table_type='%s'",
               table->file->has_transactions(), table->file->table_type()));
 
+  /* Insert the rows still buffered, abort_result_set() cleans up on error */
+  if (m_write_rows_batch.flush(&info)) return true;
+
   error = (bulk_insert_started ? table->file->ha_end_bulk_insert() : 0);
   if (!error && thd->is_error()) error = thd->get_stmt_da()->mysql_errno();
 
@@ -2350,6 +2457,7 @@ void Query_result_insert::abort_result_set(THD *thd) {
       in this case).
     */
     if (bulk_insert_started) table->file->ha_end_bulk_insert();
+    m_write_rows_batch.discard();
 
     /*
       If at least one row has been inserted/modified and will stay in
@@ -52,6 +52,58 @@ void prepare_triggers_for_insert_stmt(THD *thd, TABLE *table);
 bool write_record(THD *thd, TABLE *table, COPY_INFO *info, COPY_INFO *update);
 bool validate_default_values_of_unset_fields(THD *thd, TABLE *table);
 
+#define WRITE_ROWS_BATCH_SIZE_DEFAULT 64
+
+/* The max rows handed to handler::write_rows() at a time, 1 disables it */
+extern ulong write_rows_batch_size;
+
+/**
+  Rows of a plain INSERT buffered to be inserted in batches through
+  handler::write_rows(), when no per row processing like triggers,
+  duplicate handling or auto-increment is needed in between.
+*/
+class Write_rows_batch {
+ public:
+  Write_rows_batch()
+      : m_table(nullptr), m_records(nullptr), m_size(0), m_count(0) {}
+
+  /**
+    Set up the buffer if the statement can insert rows in batches.
+
+    @param thd    Thread context
+    @param table  The table inserted into
+    @param info   The INSERT part of the statement
+
+    @returns true if out of memory
+  */
+  bool init(THD *thd, TABLE *table, const COPY_INFO &info);
+
+  bool is_active() const { return m_records != nullptr; }
+
+  /**
+    Buffer the row in record[0], the batch is inserted once full.
+
+    @returns true if an error is reported
+  */
+  bool add(COPY_INFO *info);
+
+  /**
+    Insert the buffered rows.
+
+    @returns true if an error is reported
+  */
+  bool flush(COPY_INFO *info);
+
+  /* Forget the buffered rows, the statement is rolled back */
+  void discard() { m_count = 0; }
+
+ private:
+  TABLE *m_table;
+  uchar **m_records;
+  uint m_size;
+  uint m_count;
+};
+
 class Query_result_insert : public Query_result_interceptor {
  public:
   /// The table used for insertion of rows
@@ -70,6 +122,9 @@ class Query_result_insert : public Query_result_interceptor {
   /// ha_start_bulk_insert has been called. Never cleared.
   bool bulk_insert_started;
 
+  /// Rows not inserted yet, for plain INSERT ... SELECT
+  Write_rows_batch m_write_rows_batch;
+
  public:
   ulonglong autoinc_value_of_last_inserted_row;  // autogenerated or not
   COPY_INFO info;
@@ -49,6 +49,7 @@ static const char *opt_ssl_cert = nullptr;
 static char *opt_ssl_capath = NULL, *opt_ssl_cipher = NULL,
             *opt_tls_ciphersuites = NULL, *opt_ssl_crl = NULL,
             *opt_ssl_crlpath = NULL, *opt_tls_version = NULL;
+static bool opt_tls_kernel_offload = false;
 
 static PolyLock_mutex lock_ssl_ctx(&LOCK_tls_ctx_options);
 
@@ -521,20 +522,28 @@ static const char *verify_store_cert(SSL_CTX *ctx, SSL *ssl) {
 
 SslAcceptorContext::SslAcceptorContext(bool use_ssl_arg, bool report_ssl_error,
                                        enum enum_ssl_init_error *out_error)
-    : ssl_acceptor_fd(nullptr), acceptor(nullptr) {
+    : ssl_acceptor_fd(nullptr),
+      acceptor(nullptr),
+      current_kernel_offload_(false) {
   enum enum_ssl_init_error error = SSL_INITERR_NOERROR;
 
   read_parameters(&current_ca_, &current_capath_, &current_version_,
                   &current_cert_, &current_cipher_, &current_ciphersuites_,
-                  &current_key_, &current_crl_, &current_crlpath_);
+                  &current_key_, &current_crl_, &current_crlpath_,
+                  &current_kernel_offload_);
 
   if (use_ssl_arg) {
+    long ssl_ctx_flags = process_tls_version(current_version_.c_str());
+
+    /* A negative value is an invalid version, reported by the factory */
+    if (current_kernel_offload_ && ssl_ctx_flags >= 0)
+      ssl_ctx_flags |= VIO_SSL_CTX_KTLS;
+
     ssl_acceptor_fd = new_VioSSLAcceptorFd(
         current_key_.c_str(), current_cert_.c_str(), current_ca_.c_str(),
         current_capath_.c_str(), current_cipher_.c_str(),
         current_ciphersuites_.c_str(), &error, current_crl_.c_str(),
-        current_crlpath_.c_str(),
-        process_tls_version(current_version_.c_str()));
+        current_crlpath_.c_str(), ssl_ctx_flags);
 
     if (!ssl_acceptor_fd && report_ssl_error)
       LogErr(WARNING_LEVEL, ER_SSL_LIBRARY_ERROR, sslGetErrString(error));
@@ -685,7 +694,8 @@ int SslAcceptorContext::warn_self_signed_ca() {
 void SslAcceptorContext::read_parameters(
     OptionalString *ca, OptionalString *capath, OptionalString *version,
     OptionalString *cert, OptionalString *cipher, OptionalString *ciphersuites,
-    OptionalString *key, OptionalString *crl, OptionalString *crl_path) {
+    OptionalString *key, OptionalString *crl, OptionalString *crl_path,
+    bool *kernel_offload) {
   AutoRLock lock(&lock_ssl_ctx);
   if (ca) ca->assign(opt_ssl_ca);
   if (capath) capath->assign(opt_ssl_capath);
@@ -696,6 +706,7 @@ void SslAcceptorContext::read_parameters(
   if (key) key->assign(opt_ssl_key);
   if (crl) crl->assign(opt_ssl_crl);
   if (crl_path) crl_path->assign(opt_ssl_crlpath);
+  if (kernel_offload) *kernel_offload = opt_tls_kernel_offload;
 }
 
 /*
@@ -763,3 +774,10 @@ static Sys_var_charptr Sys_ssl_crlpath(
     PERSIST_AS_READONLY GLOBAL_VAR(opt_ssl_crlpath),
     CMD_LINE(REQUIRED_ARG, OPT_SSL_CRLPATH), IN_FS_CHARSET, DEFAULT(0),
     &lock_ssl_ctx);
+
+static Sys_var_bool Sys_tls_kernel_offload(
+    "tls_kernel_offload",
+    "Let the kernel encrypt established TLS connections (Linux kTLS) when "
+    "OpenSSL, the kernel and the negotiated cipher support it",
+    PERSIST_AS_READONLY GLOBAL_VAR(opt_tls_kernel_offload), CMD_LINE(OPT_ARG),
+    DEFAULT(false), &lock_ssl_ctx);
@@ -229,13 +229,14 @@ class SslAcceptorContext {
     @param [out] key
     @param [out] crl
     @param [out] crl_path
+    @param [out] kernel_offload
   */
   static void read_parameters(
       OptionalString *ca = nullptr, OptionalString *capath = nullptr,
       OptionalString *version = nullptr, OptionalString *cert = nullptr,
       OptionalString *cipher = nullptr, OptionalString *ciphersuites = nullptr,
       OptionalString *key = nullptr, OptionalString *crl = nullptr,
-      OptionalString *crl_path = nullptr);
+      OptionalString *crl_path = nullptr, bool *kernel_offload = nullptr);
 
  protected:
   /**
@@ -280,6 +281,7 @@ class SslAcceptorContext {
   OptionalString current_ca_, current_capath_, current_version_, current_cert_,
       current_cipher_, current_ciphersuites_, current_key_, current_crl_,
       current_crlpath_;
+  bool current_kernel_offload_;
 
   /** singleton lock */
   static SslAcceptorContextLockType *lock;
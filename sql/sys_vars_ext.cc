@@ -42,6 +42,7 @@
 #include "sql/outline/outline_interface.h"
 #include "sql/recycle_bin/recycle_scheduler.h"
 #include "sql/recycle_bin/recycle_table.h"
+#include "sql/sql_insert.h"
 #include "sql/sys_vars.h"
 
 static Sys_var_ulong Sys_ccl_wait_timeout(
@@ -55,6 +56,24 @@ static Sys_var_ulong Sys_ccl_max_waiting(
     VALID_RANGE(0, INT_MAX64), DEFAULT(CCL_DEFAULT_WAITING_COUNT),
     BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0), ON_UPDATE(0));
 
+static Sys_var_ulong Sys_ccl_adaptive_latency_tolerance(
+    "ccl_adaptive_latency_tolerance",
+    "Latency that the statements complying one ccl rule or bucket may reach, "
+    "as a percent of the lowest latency the rule has shown. The concurrency "
+    "limit is adjusted between ccl_adaptive_min_concurrency and the "
+    "concurrency count to keep it, values below 100 act as 100. "
+    "0 means the concurrency count is applied as it is",
+    GLOBAL_VAR(im::ccl_adaptive_latency_tolerance), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(0, 100000), DEFAULT(0), BLOCK_SIZE(1), NO_MUTEX_GUARD,
+    NOT_IN_BINLOG, ON_CHECK(0), ON_UPDATE(0));
+
+static Sys_var_ulong Sys_ccl_adaptive_min_concurrency(
+    "ccl_adaptive_min_concurrency",
+    "The lowest concurrency limit adaptive concurrency control shrinks to",
+    GLOBAL_VAR(im::ccl_adaptive_min_concurrency), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(1, INT_MAX32), DEFAULT(CCL_ADAPTIVE_MIN_CONCURRENCY_DEFAULT),
+    BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0), ON_UPDATE(0));
+
 static bool update_ccl_queue(sys_var *, THD *, enum_var_type) {
   im::System_ccl::instance()->get_queue_buckets()->init_queue_buckets(
       im::ccl_queue_bucket_count, im::ccl_queue_bucket_size,
@@ -76,6 +95,14 @@ static Sys_var_ulong Sys_ccl_queue_bucket(
     DEFAULT(CCL_QUEUE_BUCKET_COUNT_DEFAULT), BLOCK_SIZE(1), NO_MUTEX_GUARD,
     NOT_IN_BINLOG, ON_CHECK(0), ON_UPDATE(update_ccl_queue));
 
+static Sys_var_ulong Sys_write_rows_batch_size(
+    "write_rows_batch_size",
+    "The max rows of a plain INSERT handed to the storage engine at a time, "
+    "if it can insert rows in batches. 1 inserts them one by one",
+    GLOBAL_VAR(write_rows_batch_size), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(1, 4096), DEFAULT(WRITE_ROWS_BATCH_SIZE_DEFAULT),
+    BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(0), ON_UPDATE(0));
+
 static Sys_var_bool Sys_recycle_bin(
     "recycle_bin", "Whether recycle the table which is going to be dropped",
     SESSION_VAR(recycle_bin), CMD_LINE(OPT_ARG), DEFAULT(false), NO_MUTEX_GUARD,
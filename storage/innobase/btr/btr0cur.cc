@@ -595,6 +595,63 @@ static bool btr_cur_need_opposite_intention(const page_t *page,
   ut_error;
 }
 
+/** Logical read-ahead: collect the leaf pages whose node pointers follow the
+one the search descends through on a level 1 page. Unlike linear read-ahead,
+this does not depend on the leaf pages being allocated in the same extent.
+@param[in]	index		index tree
+@param[in]	node_ptr	node pointer to the leaf page being searched
+@param[in]	n_pages		maximum number of following leaf pages
+@param[out]	page_nos	numbers of the following leaf pages
+@param[in,out]	offsets		work area for the node pointer offsets
+@param[in,out]	heap		memory heap for offsets
+@return number of following leaf pages found on the page */
+static ulint btr_cur_read_ahead_collect(const dict_index_t *index,
+                                        const rec_t *node_ptr, ulint n_pages,
+                                        page_no_t *page_nos, ulint *&offsets,
+                                        mem_heap_t *&heap) {
+  ulint n_found = 0;
+
+  for (const rec_t *rec = page_rec_get_next_const(node_ptr);
+       n_found < n_pages && !page_rec_is_supremum(rec);
+       rec = page_rec_get_next_const(rec)) {
+    offsets = rec_get_offsets(rec, index, offsets, ULINT_UNDEFINED, &heap);
+
+    page_nos[n_found++] = btr_node_ptr_get_child_page_no(rec, offsets);
+  }
+
+  return (n_found);
+}
+
+/** Issue asynchronous reads of the leaf pages collected by
+btr_cur_read_ahead_collect(). Must be called without the latch on their
+parent page, so that it is not held during the read requests.
+@param[in]	index		index tree
+@param[in]	page_size	page size of the index
+@param[in]	page_nos	numbers of the leaf pages
+@param[in]	n_pages		number of leaf pages
+@return number of read requests issued */
+static ulint btr_cur_read_ahead_issue(const dict_index_t *index,
+                                      const page_size_t &page_size,
+                                      const page_no_t *page_nos,
+                                      ulint n_pages) {
+  const space_id_t space = dict_index_get_space(index);
+  ulint n_reads = 0;
+
+  for (ulint i = 0; i < n_pages; ++i) {
+    /* Does nothing if the page is in the buffer pool already */
+    if (buf_read_page_background(page_id_t(space, page_nos[i]), page_size,
+                                 false)) {
+      ++n_reads;
+    }
+  }
+
+  if (n_reads > 0) {
+    os_aio_simulated_wake_handler_threads();
+  }
+
+  return (n_reads);
+}
+
 /** Searches an index tree and positions a tree cursor on a given level.
  NOTE: n_fields_cmp in tuple must be set so that it cannot be compared
  to node pointer page number fields on the upper levels of the tree!
@@ -761,6 +818,19 @@ void btr_cur_search_to_nth_level(
   cursor->flag = BTR_CUR_BINARY;
   cursor->index = index;
 
+  /* Leaf pages to read ahead, the request is consumed by this search. */
+  const ulint read_ahead_n_pages =
+      (latch_mode == BTR_SEARCH_LEAF && level == 0 &&
+       !dict_index_is_spatial(index) && !dict_index_is_ibuf(index))
+          ? cursor->read_ahead_n_pages
+          : 0;
+
+  cursor->read_ahead_n_pages = 0;
+  cursor->read_ahead_n_reads = 0;
+
+  /* Leaf pages found for read-ahead, read once the parent is released */
+  page_no_t *read_ahead_page_nos = nullptr;
+
 #ifndef BTR_CUR_ADAPT
   guess = NULL;
 #else
@@ -1545,6 +1615,24 @@ retry_page_get:
       }
     }
 
+    if (height == 0 && read_ahead_n_pages > 0 &&
+        !srv_startup_is_before_trx_rollback_phase) {
+      /* The page is a parent of leaf pages. Its latch keeps the node
+      pointers stable while collecting them. */
+      ulint *ra_offsets = nullptr;
+
+      if (heap == nullptr) {
+        heap = mem_heap_create(read_ahead_n_pages * sizeof(page_no_t));
+      }
+
+      read_ahead_page_nos = static_cast<page_no_t *>(
+          mem_heap_alloc(heap, read_ahead_n_pages * sizeof(page_no_t)));
+
+      cursor->read_ahead_n_pages = btr_cur_read_ahead_collect(
+          index, node_ptr, read_ahead_n_pages, read_ahead_page_nos, ra_offsets,
+          heap);
+    }
+
     /* Go to the child node */
     page_id.reset(space, btr_node_ptr_get_child_page_no(node_ptr, offsets));
 
@@ -1690,6 +1778,13 @@ retry_page_get:
 
 func_exit:
 
+  if (cursor->read_ahead_n_pages > 0) {
+    /* The latch of the parent page was released with the upper blocks
+    when the leaf page was reached. */
+    cursor->read_ahead_n_reads = btr_cur_read_ahead_issue(
+        index, page_size, read_ahead_page_nos, cursor->read_ahead_n_pages);
+  }
+
   if (UNIV_LIKELY_NULL(heap)) {
     mem_heap_free(heap);
   }
@@ -1709,6 +1804,97 @@ func_exit:
   }
 }
 
+/** Positions a tree cursor on a leaf page remembered from a previous search,
+without descending the tree. The page is latched optimistically, and the
+guess is only taken if the tuple falls into the key range of the page, so
+that the cursor ends up where btr_cur_search_to_nth_level() with
+PAGE_CUR_LE and BTR_MODIFY_LEAF would put it.
+@param[in]	index		index
+@param[in]	tuple		data tuple
+@param[in]	block		guessed leaf block
+@param[in]	modify_clock	modify clock of the block when it was guessed
+@param[out]	cursor		tree cursor, x-latched on the leaf on success
+@param[in]	file		file name
+@param[in]	line		line where called
+@param[in,out]	mtr		mini-transaction
+@return true if success */
+bool btr_cur_search_leaf_hint(dict_index_t *index, const dtuple_t *tuple,
+                              buf_block_t *block, uint64_t modify_clock,
+                              btr_cur_t *cursor, const char *file, ulint line,
+                              mtr_t *mtr) {
+  ut_ad(!dict_index_is_spatial(index));
+  ut_ad(!index->table->is_intrinsic());
+
+  cursor->m_fetch_mode = Page_fetch::NORMAL;
+
+  if (!buf_page_optimistic_get(RW_X_LATCH, block, modify_clock,
+                               Page_fetch::NORMAL, file, line, mtr)) {
+    return (false);
+  }
+
+  const page_t *page = buf_block_get_frame(block);
+
+  if (index->space != block->page.id.space() ||
+      !fil_page_index_page_check(page) ||
+      btr_page_get_index_id(page) != index->id || !page_is_leaf(page)) {
+    btr_leaf_page_release(block, BTR_MODIFY_LEAF, mtr);
+    return (false);
+  }
+
+  mem_heap_t *heap = nullptr;
+  ulint offsets_[REC_OFFS_NORMAL_SIZE];
+  ulint *offsets = offsets_;
+  rec_offs_init(offsets_);
+
+  const ulint n_unique = dict_index_get_n_unique_in_tree(index);
+  const rec_t *first = page_rec_get_next_const(page_get_infimum_rec(page));
+  const rec_t *last = page_rec_get_prev_const(page_get_supremum_rec(page));
+
+  /* The tuple must not belong to a neighbour page: it must not be less
+  than the first record unless there is no left page, and not greater
+  than the last record unless there is no right page. */
+  bool in_range;
+
+  if (page_rec_is_supremum(first)) {
+    in_range = btr_page_get_prev(page, mtr) == FIL_NULL &&
+               btr_page_get_next(page, mtr) == FIL_NULL;
+  } else {
+    offsets = rec_get_offsets(first, index, offsets, n_unique, &heap);
+    in_range = btr_page_get_prev(page, mtr) == FIL_NULL ||
+               tuple->compare(first, index, offsets) >= 0;
+
+    if (in_range && btr_page_get_next(page, mtr) != FIL_NULL) {
+      offsets = rec_get_offsets(last, index, offsets, n_unique, &heap);
+      in_range = tuple->compare(last, index, offsets) <= 0;
+    }
+  }
+
+  if (UNIV_LIKELY_NULL(heap)) {
+    mem_heap_free(heap);
+  }
+
+  if (!in_range) {
+    btr_leaf_page_release(block, BTR_MODIFY_LEAF, mtr);
+    return (false);
+  }
+
+  ulint up_match = 0;
+  ulint low_match = 0;
+
+  cursor->index = index;
+  cursor->flag = BTR_CUR_BINARY;
+
+  page_cur_search_with_match(block, index, tuple, PAGE_CUR_LE, &up_match,
+                             &low_match, btr_cur_get_page_cur(cursor), NULL);
+
+  cursor->up_match = up_match;
+  cursor->up_bytes = 0;
+  cursor->low_match = low_match;
+  cursor->low_bytes = 0;
+
+  return (true);
+}
+
 /** Searches an index tree and positions a tree cursor on a given level.
 This function will avoid latching the traversal path and so should be
 used only for cases where-in latching is not needed.
@@ -0,0 +1,187 @@
+/* Copyright (c) 2018, 2021, Alibaba and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/** @file btr/btr0est.cc
+ Cache of the index range estimation (index dive) results.
+
+ Created 2021-03-02 by Galaxy SQL
+ *******************************************************/
+
+#include "btr0est.h"
+#include "dict0dict.h"
+#include "os0once.h"
+#include "ut0ut.h"
+
+#ifdef UNIV_PFS_MUTEX
+/* Range estimation cache mutex PFS key */
+mysql_pfs_key_t btr_range_est_cache_mutex_key;
+#endif
+
+/** Max count of cached range estimations per index, 0 means disabled */
+ulong srv_btr_range_est_cache_size = 0;
+
+/** Time (seconds) that a cached range estimation keeps valid */
+ulong srv_btr_range_est_cache_ttl = 60;
+
+Range_est_cache::Range_est_cache() : m_lru(), m_map() {
+  mutex_create(LATCH_ID_BTR_RANGE_EST_CACHE, &m_mutex);
+}
+
+Range_est_cache::~Range_est_cache() { mutex_free(&m_mutex); }
+
+/** Whether the entry can still be used */
+bool Range_est_cache::is_valid(const dict_table_t *table, const Entry &entry,
+                               ib_time_monotonic_t now) const {
+  /* Statistics have been recalculated. */
+  if (entry.stats_last_recalc != table->stats_last_recalc) return false;
+
+  if (now - entry.cached_time >
+      static_cast<ib_time_monotonic_t>(srv_btr_range_est_cache_ttl)) {
+    return false;
+  }
+
+  /* The counter is reset when the table is queued for recalculation,
+  dirty read is fine, it's only an estimation. */
+  ib_uint64_t counter = table->stat_modified_counter;
+  if (counter < entry.modified_counter) return false;
+
+  return counter - entry.modified_counter <=
+         table->stat_n_rows / BTR_RANGE_EST_CACHE_MODIFIED_RATIO;
+}
+
+/**
+  Look up a cached estimation.
+
+  @param[in]      table       table of the index
+  @param[in]      key         normalized range
+  @param[out]     n_rows      cached estimation
+
+  @retval         true        found a valid entry
+*/
+bool Range_est_cache::lookup(const dict_table_t *table, const std::string &key,
+                             int64_t *n_rows) {
+  bool found = false;
+  ib_time_monotonic_t now = ut_time_monotonic();
+
+  mutex_enter(&m_mutex);
+
+  Entry_map::iterator it = m_map.find(key);
+
+  if (it != m_map.end()) {
+    if (is_valid(table, it->second, now)) {
+      *n_rows = it->second.n_rows;
+      m_lru.splice(m_lru.begin(), m_lru, it->second.lru_pos);
+      found = true;
+    } else {
+      m_lru.erase(it->second.lru_pos);
+      m_map.erase(it);
+    }
+  }
+
+  mutex_exit(&m_mutex);
+
+  return found;
+}
+
+/**
+  Cache an estimation, evict the least recently used entry if full.
+
+  @param[in]      table       table of the index
+  @param[in]      key         normalized range
+  @param[in]      n_rows      estimation
+*/
+void Range_est_cache::insert(const dict_table_t *table, const std::string &key,
+                             int64_t n_rows) {
+  Entry entry;
+  entry.n_rows = n_rows;
+  entry.modified_counter = table->stat_modified_counter;
+  entry.stats_last_recalc = table->stats_last_recalc;
+  entry.cached_time = ut_time_monotonic();
+
+  mutex_enter(&m_mutex);
+
+  Entry_map::iterator it = m_map.find(key);
+
+  if (it != m_map.end()) {
+    entry.lru_pos = it->second.lru_pos;
+    m_lru.splice(m_lru.begin(), m_lru, entry.lru_pos);
+    it->second = entry;
+  } else {
+    while (!m_lru.empty() && m_lru.size() >= srv_btr_range_est_cache_size) {
+      m_map.erase(m_lru.back());
+      m_lru.pop_back();
+    }
+
+    m_lru.push_front(key);
+    entry.lru_pos = m_lru.begin();
+    m_map.insert(Entry_map::value_type(key, entry));
+  }
+
+  mutex_exit(&m_mutex);
+}
+
+/** Allocate the range estimation cache of an index.
+@param[in,out]	index_void	index whose cache is to be created */
+static void btr_range_est_cache_alloc(void *index_void) {
+  dict_index_t *index = static_cast<dict_index_t *>(index_void);
+  index->range_est_cache = UT_NEW_NOKEY(Range_est_cache());
+  ut_a(index->range_est_cache != NULL);
+}
+
+/** Look up the cached estimation of the range of index.
+@param[in]	index	index to estimate
+@param[in]	key	normalized range
+@param[out]	n_rows	cached estimation
+@return true if found a valid one */
+bool btr_range_est_cache_lookup(dict_index_t *index, const std::string &key,
+                                int64_t *n_rows) {
+  if (srv_btr_range_est_cache_size == 0 ||
+      index->range_est_cache_created != os_once::DONE) {
+    return false;
+  }
+
+  return index->range_est_cache->lookup(index->table, key, n_rows);
+}
+
+/** Cache the estimation of the range of index.
+@param[in]	index	index to estimate
+@param[in]	key	normalized range
+@param[in]	n_rows	estimation */
+void btr_range_est_cache_insert(dict_index_t *index, const std::string &key,
+                                int64_t n_rows) {
+  if (srv_btr_range_est_cache_size == 0) return;
+
+  os_once::do_or_wait_for_done(&index->range_est_cache_created,
+                               btr_range_est_cache_alloc, index);
+
+  index->range_est_cache->insert(index->table, key, n_rows);
+}
+
+/** Free the estimation cache of an index.
+@param[in]	index	index being freed */
+void btr_range_est_cache_free(dict_index_t *index) {
+  if (index->range_est_cache_created == os_once::DONE &&
+      index->range_est_cache != NULL) {
+    UT_DELETE(index->range_est_cache);
+    index->range_est_cache = NULL;
+  }
+}
@@ -163,11 +163,14 @@ bool btr_pcur_t::restore_position(ulint latch_mode, mtr_t *mtr,
   ut_a(m_old_rec != nullptr);
   ut_a(m_old_n_fields > 0);
 
+  /* A search is preferred when more leaf pages should be read ahead. */
+  const bool read_ahead = latch_mode == BTR_SEARCH_LEAF && read_ahead_needed();
+
   /* Optimistic latching involves S/X latch not required for
   intrinsic table instead we would prefer to search fresh. */
   if ((latch_mode == BTR_SEARCH_LEAF || latch_mode == BTR_MODIFY_LEAF ||
        latch_mode == BTR_SEARCH_PREV || latch_mode == BTR_MODIFY_PREV) &&
-      !m_btr_cur.index->table->is_intrinsic()) {
+      !m_btr_cur.index->table->is_intrinsic() && !read_ahead) {
     /* Try optimistic restoration. */
 
     if (!buf_pool_is_obsolete(m_withdraw_clock) &&
@@ -236,6 +239,10 @@ bool btr_pcur_t::restore_position(ulint latch_mode, mtr_t *mtr,
       ut_error;
   }
 
+  if (read_ahead) {
+    read_ahead_grow();
+  }
+
   open_no_init(index, tuple, mode, latch_mode, 0, mtr, file, line);
 
   /* Restore the old search mode */
@@ -323,6 +330,10 @@ void btr_pcur_t::move_to_next_page(mtr_t *mtr) {
 
   page_cur_set_before_first(next_block, get_page_cur());
 
+  if (m_read_ahead_left > 0) {
+    --m_read_ahead_left;
+  }
+
   ut_d(page_check_dir(next_page));
 }
 
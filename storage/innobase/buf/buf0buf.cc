@@ -1248,6 +1248,7 @@ static void buf_pool_create(buf_pool_t *buf_pool, ulint buf_pool_size,
     UT_LIST_INIT(buf_pool->withdraw, &buf_page_t::list);
     buf_pool->withdraw_target = 0;
     UT_LIST_INIT(buf_pool->flush_list, &buf_page_t::list);
+    buf_pool->n_temp_flush_list = 0;
     UT_LIST_INIT(buf_pool->unzip_LRU, &buf_block_t::unzip_LRU);
 
 #if defined UNIV_DEBUG || defined UNIV_BUF_DEBUG
@@ -5895,7 +5896,9 @@ ulint buf_get_n_pending_read_ios(void) {
 }
 
 /** Returns the ratio in percents of modified pages in the buffer pool /
- database pages in the buffer pool.
+ database pages in the buffer pool. With innodb_temp_flush_on_evict the
+ pages of temporary tablespaces are left out, the flush list batches do not
+ write them, so they must not drive the page cleaner.
  @return modified page percentage ratio */
 double buf_get_modified_ratio_pct(void) {
   double ratio;
@@ -5905,6 +5908,17 @@ double buf_get_modified_ratio_pct(void) {
 
   buf_get_total_list_len(&lru_len, &free_len, &flush_list_len);
 
+  if (srv_temp_flush_on_evict) {
+    ulint temp_len = 0;
+
+    for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+      temp_len += buf_pool_from_array(i)->n_temp_flush_list;
+    }
+
+    /* The counters are read without the flush list mutexes */
+    flush_list_len -= std::min(temp_len, flush_list_len);
+  }
+
   ratio = static_cast<double>(100 * flush_list_len) / (1 + lru_len + free_len);
 
   /* 1 + is there to avoid division by zero */
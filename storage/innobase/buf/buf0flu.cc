@@ -220,6 +220,10 @@ static inline void incr_flush_list_size_in_bytes(
   buf_pool->stat.flush_list_bytes += block->page.size.physical();
 
   ut_ad(buf_pool->stat.flush_list_bytes <= buf_pool->curr_pool_size);
+
+  if (fsp_is_system_temporary(block->page.id.space())) {
+    buf_pool->n_temp_flush_list++;
+  }
 }
 
 #if defined UNIV_DEBUG || defined UNIV_BUF_DEBUG
@@ -707,6 +711,15 @@ bool buf_flush_ready_for_flush(buf_page_t *bpage, buf_flush_t flush_type) {
 
   switch (flush_type) {
     case BUF_FLUSH_LIST:
+      /* Temporary tablespaces generate no redo, so their pages never
+      hold back the checkpoint. Leave them to be written when they are
+      evicted from the LRU list, unless we are shutting down. */
+      if (srv_temp_flush_on_evict &&
+          fsp_is_system_temporary(bpage->id.space()) &&
+          srv_shutdown_state.load() == SRV_SHUTDOWN_NONE) {
+        return (false);
+      }
+
       return (buf_page_get_state(bpage) != BUF_BLOCK_REMOVE_HASH);
     case BUF_FLUSH_LRU:
     case BUF_FLUSH_SINGLE_PAGE:
@@ -770,6 +783,11 @@ void buf_flush_remove(buf_page_t *bpage) {
 
   buf_pool->stat.flush_list_bytes -= bpage->size.physical();
 
+  if (fsp_is_system_temporary(bpage->id.space())) {
+    ut_ad(buf_pool->n_temp_flush_list > 0);
+    buf_pool->n_temp_flush_list--;
+  }
+
   bpage->oldest_modification = 0;
 
 #if defined UNIV_DEBUG || defined UNIV_BUF_DEBUG
@@ -32,6 +32,9 @@ this program; if not, write to the Free Software Foundation, Inc.,
 
 #include "buf0lru.h"
 
+#include <thread>
+#include <vector>
+
 #include "btr0btr.h"
 #include "btr0sea.h"
 #include "buf0buddy.h"
@@ -81,6 +84,15 @@ are not blocked for extended period of time when using very large
 buffer pools. */
 static const ulint BUF_LRU_DROP_SEARCH_SIZE = 1024;
 
+/** Maximum number of threads that remove the dirty pages of a dropped
+tablespace from the flush lists of the buffer pool instances. */
+static const ulint BUF_LRU_DROP_MAX_THREADS = 8;
+
+/** Minimum size in pages of a dropped tablespace, and of the flush lists of
+the buffer pool, for the flush lists to be scanned by several threads. Below
+that starting the threads costs more than the scan they save. */
+static const ulint BUF_LRU_DROP_PARALLEL_MIN_PAGES = 64 * 1024;
+
 /** We scan these many blocks when looking for a clean page to evict
 during LRU eviction. */
 static const ulint BUF_LRU_SEARCH_SCAN_THRESHOLD = 100;
@@ -868,6 +880,48 @@ static void buf_LRU_remove_pages(
   }
 }
 
+/** Check whether the flush lists should be scanned by several threads to
+remove the dirty pages of a dropped tablespace.
+@param[in]	id		space id
+@return true if the tablespace and the flush lists are both big */
+static bool buf_LRU_drop_in_parallel(space_id_t id) {
+  if (srv_buf_pool_instances < 2) {
+    return (false);
+  }
+
+  /* The size is read without the shard mutex, it only serves as a hint. */
+  const fil_space_t *space = fil_space_get(id);
+
+  if (space == nullptr || space->size < BUF_LRU_DROP_PARALLEL_MIN_PAGES) {
+    return (false);
+  }
+
+  ulint lru_len;
+  ulint free_len;
+  ulint flush_list_len;
+
+  buf_get_total_list_len(&lru_len, &free_len, &flush_list_len);
+
+  return (flush_list_len >= BUF_LRU_DROP_PARALLEL_MIN_PAGES);
+}
+
+/** Remove pages belonging to a given tablespace inside every step-th buffer
+pool instance, starting from the first one.
+@param[in]	first		first buffer pool instance
+@param[in]	step		distance between the instances
+@param[in]	id		space id
+@param[in]	buf_remove	remove or flush strategy
+@param[in]	trx		to check if the operation must be interrupted
+@param[in]	strict		true if no page from tablespace can be in
+                                buffer pool just after flush */
+static void buf_LRU_remove_pages_step(ulint first, ulint step, space_id_t id,
+                                      buf_remove_t buf_remove,
+                                      const trx_t *trx, bool strict) {
+  for (ulint i = first; i < srv_buf_pool_instances; i += step) {
+    buf_LRU_remove_pages(buf_pool_from_array(i), id, buf_remove, trx, strict);
+  }
+}
+
 /** Flushes all dirty pages or removes all pages belonging
  to a given tablespace. A PROBLEM: if readahead is being started, what
  guarantees that it will not try to read in pages after this operation
@@ -882,6 +936,33 @@ void buf_LRU_flush_or_remove_pages(
 {
   ulint i;
 
+  if (buf_remove == BUF_REMOVE_FLUSH_NO_WRITE && buf_LRU_drop_in_parallel(id)) {
+    /* DROP TABLE only has to remove the dirty pages from the flush
+    lists, the clean pages are evicted as they age. When a big tablespace
+    is dropped from a big buffer pool, scan the instances in parallel.
+    There is neither write nor interruption check, see
+    buf_LRU_remove_pages(). */
+    const ulint n_threads =
+        std::min(static_cast<ulint>(srv_buf_pool_instances),
+                 BUF_LRU_DROP_MAX_THREADS);
+
+    std::vector<std::thread> threads;
+
+    for (ulint t = 1; t < n_threads; ++t) {
+      threads.emplace_back(std::thread(buf_LRU_remove_pages_step, t,
+                                       n_threads, id, buf_remove, trx,
+                                       strict));
+    }
+
+    buf_LRU_remove_pages_step(0, n_threads, id, buf_remove, trx, strict);
+
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    return;
+  }
+
   /* Before we attempt to drop pages one by one we first
   attempt to drop page hash index entries in batches to make
   it more efficient. The batching attempt is a best effort
@@ -47,6 +47,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "my_dbug.h"
 #include "rem0rec.h"
 #include "ut0crc32.h"
+#include "btr0est.h"
 #endif /* !UNIV_HOTBACKUP */
 
 #include <iostream>
@@ -696,6 +697,8 @@ void dict_mem_index_free(dict_index_t *index) /*!< in: index */
 #ifndef UNIV_HOTBACKUP
   dict_index_zip_pad_mutex_destroy(index);
 
+  btr_range_est_cache_free(index);
+
   if (dict_index_is_spatial(index)) {
     rtr_info_active::iterator it;
     rtr_info_t *rtr_info;
@@ -110,16 +110,28 @@ static void dict_stats_recalc_pool_deinit() {
   recalc_pool = NULL;
 }
 
-/** Add a table to the recalc pool, which is processed by the
- background stats gathering thread. Only the table id is added to the
- list, so the table can be closed after being enqueued and it will be
- opened when needed. If the table does not exist later (has been DROPped),
- then it will be removed from the pool and skipped. */
-void dict_stats_recalc_pool_add(
-    const dict_table_t *table) /*!< in: table to add */
-{
-  ut_ad(!srv_read_only_mode);
+/** Calculate the priority of a table in the recalc pool, when it is about
+to be picked: the number of rows modified since its last recalculation, which
+keeps growing while it waits. A table that left the cache has its counter
+reset when it is loaded again, and nothing to gain from going first.
+@param[in]	id	table id
+@return priority, the higher the sooner */
+static ib_uint64_t dict_stats_recalc_priority(table_id_t id) {
+  ut_ad(mutex_own(&dict_sys->mutex));
 
+  dict_table_t *table;
+
+  HASH_SEARCH(id_hash, dict_sys->table_id_hash, ut_fold_ull(id),
+              dict_table_t *, table, ut_ad(table->cached), table->id == id);
+
+  /* Dirty read, it's only used to order the tables. */
+  return (table == nullptr ? 0 : table->stat_modified_counter);
+}
+
+/** Insert a table into the recalc pool without waking up the workers.
+@param[in]	table	table to add
+@return true if the table was inserted, false if it was in the pool already */
+static bool dict_stats_recalc_pool_insert(const dict_table_t *table) {
   mutex_enter(&recalc_pool_mutex);
 
   /* quit if already in the list */
@@ -127,7 +139,7 @@ void dict_stats_recalc_pool_add(
        iter != recalc_pool->end(); ++iter) {
     if (*iter == table->id) {
       mutex_exit(&recalc_pool_mutex);
-      return;
+      return (false);
     }
   }
 
@@ -135,11 +147,26 @@ void dict_stats_recalc_pool_add(
 
   mutex_exit(&recalc_pool_mutex);
 
-  os_event_set(dict_stats_event);
+  return (true);
+}
+
+/** Add a table to the recalc pool, which is processed by the
+ background stats gathering thread. Only the table id is added to the
+ list, so the table can be closed after being enqueued and it will be
+ opened when needed. If the table does not exist later (has been DROPped),
+ then it will be removed from the pool and skipped. */
+void dict_stats_recalc_pool_add(
+    const dict_table_t *table) /*!< in: table to add */
+{
+  ut_ad(!srv_read_only_mode);
+
+  if (dict_stats_recalc_pool_insert(table)) {
+    os_event_set(dict_stats_event);
+  }
 }
 
-/** Get a table from the auto recalc pool. The returned table id is removed
- from the pool.
+/** Get the table of the highest priority from the auto recalc pool. The
+ returned table id is removed from the pool.
  @return true if the pool was non-empty and "id" was set, false otherwise */
 static bool dict_stats_recalc_pool_get(
     table_id_t *id) /*!< out: table id, or unmodified if list is
@@ -147,22 +174,54 @@ static bool dict_stats_recalc_pool_get(
 {
   ut_ad(!srv_read_only_mode);
 
+  /* The priorities are read from the cached tables, dict_sys->mutex
+  is acquired before recalc_pool_mutex, as in
+  dict_stats_recalc_pool_del(). */
+  mutex_enter(&dict_sys->mutex);
   mutex_enter(&recalc_pool_mutex);
 
   if (recalc_pool->empty()) {
     mutex_exit(&recalc_pool_mutex);
+    mutex_exit(&dict_sys->mutex);
     return (false);
   }
 
-  *id = recalc_pool->at(0);
+  /* On equal priorities the table enqueued first goes first */
+  recalc_pool_iterator_t top = recalc_pool->begin();
+  ib_uint64_t top_priority = dict_stats_recalc_priority(*top);
+
+  for (recalc_pool_iterator_t iter = top + 1; iter != recalc_pool->end();
+       ++iter) {
+    const ib_uint64_t priority = dict_stats_recalc_priority(*iter);
+
+    if (priority > top_priority) {
+      top = iter;
+      top_priority = priority;
+    }
+  }
+
+  *id = *top;
 
-  recalc_pool->erase(recalc_pool->begin());
+  recalc_pool->erase(top);
 
   mutex_exit(&recalc_pool_mutex);
+  mutex_exit(&dict_sys->mutex);
 
   return (true);
 }
 
+/** Get the number of tables in the auto recalc pool.
+ @return number of tables */
+static ulint dict_stats_recalc_pool_size() {
+  mutex_enter(&recalc_pool_mutex);
+
+  ulint size = recalc_pool->size();
+
+  mutex_exit(&recalc_pool_mutex);
+
+  return (size);
+}
+
 /** Delete a given table from the auto recalc pool.
  dict_stats_recalc_pool_del() */
 void dict_stats_recalc_pool_del(
@@ -257,20 +316,21 @@ void dict_stats_thread_deinit() {
   dict_stats_start_shutdown = false;
 }
 
-/** Get the first table that has been added for auto recalc and eventually
-update its stats.
-@param[in,out]	thd	current thread */
-static void dict_stats_process_entry_from_recalc_pool(THD *thd) {
+/** Get the table of the highest priority that has been added for auto
+recalc and eventually update its stats.
+@param[in,out]	thd	current thread
+@return false if the pool was empty */
+static bool dict_stats_process_entry_from_recalc_pool(THD *thd) {
   table_id_t table_id;
 
   ut_ad(!srv_read_only_mode);
 
-  DBUG_EXECUTE_IF("do_not_meta_lock_in_background", return;);
+  DBUG_EXECUTE_IF("do_not_meta_lock_in_background", return (false););
 
-  /* pop the first table from the auto recalc pool */
+  /* pop the table of the highest priority from the auto recalc pool */
   if (!dict_stats_recalc_pool_get(&table_id)) {
     /* no tables for auto recalc */
-    return;
+    return (false);
   }
 
   dict_table_t *table;
@@ -286,14 +346,25 @@ static void dict_stats_process_entry_from_recalc_pool(THD *thd) {
     /* table does not exist, must have been DROPped
     after its id was enqueued */
     mutex_exit(&dict_sys->mutex);
-    return;
+    return (true);
   }
 
   /* Check whether table is corrupted */
   if (table->is_corrupted()) {
     dd_table_close(table, thd, &mdl, true);
     mutex_exit(&dict_sys->mutex);
-    return;
+    return (true);
+  }
+
+  /* Another worker is still recalculating the table, it was enqueued again
+  meanwhile, do it later. */
+  if (table->stats_bg_flag & BG_STAT_IN_PROGRESS) {
+    mutex_exit(&dict_sys->mutex);
+    /* Not signaled, or the worker would keep waking itself up. The
+    periodic wake up picks it again. */
+    dict_stats_recalc_pool_insert(table);
+    dd_table_close(table, thd, &mdl, false);
+    return (true);
   }
 
   /* Set bg flag. */
@@ -311,9 +382,10 @@ static void dict_stats_process_entry_from_recalc_pool(THD *thd) {
   if (ut_time_monotonic() - table->stats_last_recalc < MIN_RECALC_INTERVAL) {
     /* Stats were (re)calculated not long ago. To avoid
     too frequent stats updates we put back the table on
-    the auto recalc list and do nothing. */
+    the auto recalc list and do nothing. It is not signaled, the
+    periodic wake up picks it again. */
 
-    dict_stats_recalc_pool_add(table);
+    dict_stats_recalc_pool_insert(table);
 
   } else {
     dict_stats_update(table, DICT_STATS_RECALC_PERSISTENT);
@@ -329,6 +401,8 @@ static void dict_stats_process_entry_from_recalc_pool(THD *thd) {
   /* This call can't be moved into dict_sys->mutex protection,
   since it'll cause deadlock while release mdl lock. */
   dd_table_close(table, thd, &mdl, false);
+
+  return (true);
 }
 
 #ifdef UNIV_DEBUG
@@ -356,20 +430,22 @@ void dict_stats_disabled_debug_update(THD *thd, SYS_VAR *var, void *var_ptr,
 }
 #endif /* UNIV_DEBUG */
 
-/** This is the thread for background stats gathering. It pops tables, from
-the auto recalc list and proceeds them, eventually recalculating their
-statistics. */
-void dict_stats_thread() {
+/** Pop tables from the auto recalc list and proceed them until shutdown,
+shared by the dict stats thread and its workers. */
+static void dict_stats_worker_loop() {
   ut_a(!srv_read_only_mode);
   THD *thd = create_thd(false, true, true, 0);
 
+  /* The event is shared by all the workers. Each one waits for a signal
+  count newer than the one of its last reset, so a reset by another worker
+  does not swallow a wake up meant for it, and a table enqueued while the
+  pool is being drained is not missed. */
+  int64_t sig_count = os_event_reset(dict_stats_event);
+
   while (!dict_stats_start_shutdown) {
-    /* Wake up periodically even if not signaled. This is
-    because we may lose an event - if the below call to
-    dict_stats_process_entry_from_recalc_pool() puts the entry back
-    in the list, the os_event_set() will be lost by the subsequent
-    os_event_reset(). */
-    os_event_wait_time(dict_stats_event, MIN_RECALC_INTERVAL * 1000000);
+    /* Wake up periodically even if not signaled. */
+    os_event_wait_time_low(dict_stats_event, MIN_RECALC_INTERVAL * 1000000,
+                           sig_count);
 
 #ifdef UNIV_DEBUG
     while (innodb_dict_stats_disabled_debug) {
@@ -385,14 +461,49 @@ void dict_stats_thread() {
       break;
     }
 
-    dict_stats_process_entry_from_recalc_pool(thd);
+    sig_count = os_event_reset(dict_stats_event);
 
-    os_event_reset(dict_stats_event);
+    /* Drain the pool after bulk changes instead of one table per wake up.
+    Tables put back for later are enqueued again, bound the loop by the
+    pool size so they are not spun on. */
+    ulint n_entries = dict_stats_recalc_pool_size();
+
+    for (ulint i = 0; i < n_entries && !dict_stats_start_shutdown; ++i) {
+      if (!dict_stats_process_entry_from_recalc_pool(thd)) {
+        break;
+      }
+    }
   }
 
   destroy_thd(thd);
 }
 
+/** This is the worker thread for background stats gathering, started by
+dict_stats_thread(). */
+static void dict_stats_worker_thread() { dict_stats_worker_loop(); }
+
+/** This is the thread for background stats gathering. It pops tables, from
+the auto recalc list and proceeds them, eventually recalculating their
+statistics. */
+void dict_stats_thread() {
+  /* We start from 1 because the dict stats thread is part of the
+  same set */
+  for (size_t i = 1; i < srv_threads.m_dict_stats_workers_n; ++i) {
+    srv_threads.m_dict_stats_workers[i] =
+        os_thread_create(dict_stats_thread_key, dict_stats_worker_thread);
+
+    srv_threads.m_dict_stats_workers[i].start();
+  }
+
+  dict_stats_worker_loop();
+
+  /* Waiting for all worker threads to exit, so the dict stats thread is
+  the last one to stop. */
+  for (size_t i = 1; i < srv_threads.m_dict_stats_workers_n; ++i) {
+    srv_threads.m_dict_stats_workers[i].wait();
+  }
+}
+
 /** Shutdown the dict stats thread. */
 void dict_stats_shutdown() {
   dict_stats_start_shutdown = true;
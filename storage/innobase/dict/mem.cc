@@ -273,6 +273,8 @@ dict_index_t *dict_mem_index_create(
 #ifndef UNIV_LIBRARY
   dict_index_zip_pad_mutex_create_lazy(index);
 
+  dict_index_range_est_cache_create_lazy(index);
+
   if (type & DICT_SPATIAL) {
     mutex_create(LATCH_ID_RTR_SSN_MUTEX, &index->rtr_ssn.mutex);
     index->rtr_track = static_cast<rtr_info_track_t *>(
@@ -62,6 +62,10 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "srv0start.h"
 #include "trx0purge.h"
 
+/** Maximum megabytes to extend big single-table and general tablespaces by
+at a time, 0 to extend them by FSP_FREE_ADD extents */
+ulong fsp_ibd_auto_extend_increment = 0;
+
 #ifndef UNIV_HOTBACKUP
 
 #include "dd/types/tablespace.h"
@@ -1310,7 +1314,8 @@ static UNIV_COLD ulint fsp_try_extend_data_file(fil_space_t *space,
 
 /** Calculate the number of pages to extend a datafile.
 We extend single-table and general tablespaces first one extent at a time,
-but 4 at a time for bigger tablespaces. It is not enough to extend always
+but 4 at a time for bigger tablespaces, or 1/FSP_IBD_EXTEND_RATIO of the
+current size if that is more, up to fsp_ibd_auto_extend_increment megabytes. It is not enough to extend always
 by one extent, because we need to add at least one extent to FSP_FREE.
 A single extent descriptor page will track many extents. And the extent
 that uses its extent descriptor page is put onto the FSP_FREE_FRAG list.
@@ -1342,6 +1347,21 @@ page_no_t fsp_get_pages_to_extend_ibd(const page_size_t &page_size,
     that we add at most FSP_FREE_ADD extents at
     a time */
     size_increase = FSP_FREE_ADD * extent_size;
+
+    /* A bigger increment makes concurrent inserts wait less often for
+    the file extension under the tablespace latch. It grows with the
+    tablespace, so that a small table does not get a large tail of unused
+    space, up to fsp_ibd_auto_extend_increment megabytes.
+    fsp_fill_free_list() still adds FSP_FREE_ADD extents at a time to
+    FSP_FREE, the rest stays above FSP_FREE_LIMIT until needed. */
+    const page_no_t max_increase = static_cast<page_no_t>(ut_calc_align_down(
+        fsp_ibd_auto_extend_increment * ((1024 * 1024) / page_size.physical()),
+        extent_size));
+
+    const page_no_t increase = static_cast<page_no_t>(
+        ut_calc_align_down(size / FSP_IBD_EXTEND_RATIO, extent_size));
+
+    size_increase = std::max(size_increase, std::min(increase, max_increase));
   }
 
   return (size_increase);
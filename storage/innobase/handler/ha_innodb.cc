@@ -83,6 +83,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "btr0btr.h"
 #include "btr0bulk.h"
 #include "btr0cur.h"
+#include "btr0est.h"
 #include "btr0sea.h"
 #include "buf0dblwr.h"
 #include "buf0dump.h"
@@ -186,6 +187,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "log0log.h"
 #include "os0file.h"
 
+#include <algorithm>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -701,7 +703,9 @@ static PSI_mutex_info all_innodb_mutexes[] = {
     PSI_MUTEX_KEY(gp_sys_mutex, 0, 0, PSI_DOCUMENT_ME),
     PSI_MUTEX_KEY(gp_sys_wait_mutex, 0, 0, PSI_DOCUMENT_ME),
     PSI_MUTEX_KEY(file_purge_list_mutex, 0, 0, PSI_DOCUMENT_ME),
-    PSI_MUTEX_KEY(lizard_undo_retention_mutex, 0, 0, PSI_DOCUMENT_ME)};
+    PSI_MUTEX_KEY(lizard_undo_retention_mutex, 0, 0, PSI_DOCUMENT_ME),
+    PSI_MUTEX_KEY(lizard_rw_trx_hash_mutex, 0, 0, PSI_DOCUMENT_ME),
+    PSI_MUTEX_KEY(btr_range_est_cache_mutex, 0, 0, PSI_DOCUMENT_ME)};
 #endif /* UNIV_PFS_MUTEX */
 
 #ifdef UNIV_PFS_RWLOCK
@@ -1070,6 +1074,8 @@ static SHOW_VAR innodb_status_variables[] = {
      SHOW_SCOPE_GLOBAL},
     {"rows_updated", (char *)&export_vars.innodb_rows_updated, SHOW_LONG,
      SHOW_SCOPE_GLOBAL},
+    {"fk_check_cache_hits", (char *)&export_vars.innodb_fk_check_cache_hits,
+     SHOW_LONG, SHOW_SCOPE_GLOBAL},
     {"num_open_files", (char *)&export_vars.innodb_num_open_files, SHOW_LONG,
      SHOW_SCOPE_GLOBAL},
     {"truncated_status_writes",
@@ -2759,7 +2765,7 @@ ha_innobase::ha_innobase(handlerton *hton, TABLE_SHARE *table_arg)
           HA_ATTACHABLE_TRX_COMPATIBLE | HA_CAN_INDEX_VIRTUAL_GENERATED_COLUMN |
           HA_DESCENDING_INDEX | HA_MULTI_VALUED_KEY_SUPPORT |
           HA_BLOB_PARTIAL_UPDATE | HA_SUPPORTS_GEOGRAPHIC_GEOMETRY_COLUMN |
-          HA_SUPPORTS_DEFAULT_EXPRESSION),
+          HA_SUPPORTS_DEFAULT_EXPRESSION | HA_CAN_WRITE_ROWS_BATCH),
       m_start_of_scan(),
       m_stored_select_lock_type(LOCK_NONE_UNSET),
       m_mysql_has_locked() {}
@@ -4563,7 +4569,7 @@ static int innodb_init_params() {
                       + 1   /* srv_master_thread */
                       + 1   /* srv_purge_coordinator_thread */
                       + 1   /* buf_dump_thread */
-                      + 1   /* dict_stats_thread */
+                      + srv_n_stats_recalc_threads /* dict_stats_thread */
                       + 1   /* fts_optimize_thread */
                       + 1   /* recv_writer_thread */
                       + 1   /* trx_rollback_or_clean_all_recovered */
@@ -8856,6 +8862,51 @@ func_exit:
   return error_result;
 }
 
+/** Stores a batch of rows in ascending order of the primary key, so that
+consecutive rows mostly go to the same clustered index leaf page, which is
+then latched again without descending the tree.
+@param[in]	records	rows in MySQL format
+@param[in]	count	number of rows
+@return error code of the failed row, which is left in record[0] */
+int ha_innobase::write_rows(uchar **records, uint count) {
+  DBUG_TRACE;
+
+  std::vector<uchar *> sorted(records, records + count);
+
+  /* Without a primary key the rows get ascending DB_ROW_IDs anyway */
+  if (table->s->primary_key != MAX_KEY) {
+    const KEY *key = &table->key_info[table->s->primary_key];
+    const uchar *rec0 = table->record[0];
+
+    std::stable_sort(
+        sorted.begin(), sorted.end(), [key, rec0](uchar *a, uchar *b) {
+          const KEY_PART_INFO *key_part = key->key_part;
+          const KEY_PART_INFO *end = key_part + key->user_defined_key_parts;
+
+          for (; key_part != end; key_part++) {
+            Field *field = key_part->field;
+            int cmp = field->cmp_max(field->ptr + (a - rec0),
+                                     field->ptr + (b - rec0), key_part->length);
+
+            if (cmp != 0) {
+              return ((key_part->key_part_flag & HA_REVERSE_SORT) ? cmp > 0
+                                                                  : cmp < 0);
+            }
+          }
+
+          return (false);
+        });
+  }
+
+  m_prebuilt->ins_sorted_run = true;
+
+  int error = handler::write_rows(sorted.data(), count);
+
+  m_prebuilt->ins_sorted_run = false;
+
+  return error;
+}
+
 /** Fill the update vector's "old_vrow" field for those non-updated,
 but indexed columns. Such columns could stil present in the virtual
 index rec fields even if they are not updated (some other fields updated),
@@ -15329,21 +15380,27 @@ static int innodb_alter_undo_tablespace_inactive(handlerton *hton, THD *thd,
     are trying to make inactive explicitly. One of those two could be in
     the process of being implicitly truncated.  So if one other space is
     inactive_implicit, then it is being truncated and will be put back
-    to active before this undo_space is truncated. */
+    to active before this undo_space is truncated. Several spaces can be
+    marked at once, so one of the others must also be truly active, not
+    marked and not a txn undo tablespace, to take the new transactions. */
     ulint other_active_spaces = 0;
+    ulint other_usable_spaces = 0;
     for (auto undo_ts : undo::spaces->m_spaces) {
       if (undo_ts != undo_space) {
+        const bool marked = purge_sys->undo_trunc.is_marked(undo_ts->num());
         if (undo_ts->is_active()) {
           other_active_spaces++;
-        } else if (undo_ts->is_inactive_implicit() &&
-                   purge_sys->undo_trunc.get_marked_space_num() ==
-                       undo_ts->num()) {
+          if (!marked && !undo_ts->is_txn()) {
+            other_usable_spaces++;
+          }
+        } else if (undo_ts->is_inactive_implicit() && marked) {
           other_active_spaces++;
         }
       }
     }
 
-    if (other_active_spaces < (2 + FSP_IMPLICIT_TXN_TABLESPACES)) {
+    if (other_active_spaces < (2 + FSP_IMPLICIT_TXN_TABLESPACES) ||
+        other_usable_spaces == 0) {
       my_printf_error(ER_DISALLOWED_OPERATION,
                       "Cannot set %s inactive since there would be"
                       " less than 2 undo tablespaces left active.",
@@ -15839,6 +15896,28 @@ int ha_innobase::records(ha_rows *num_rows) /*!< out: number of rows */
 /** Estimates the number of index records in a range.
  @return estimated number of rows */
 
+/** Build the normalized range used as the key of the range estimation cache,
+both ends are described by the search flag and the key image.
+@param[in]	min_key	start key value of the range, may also be 0
+@param[in]	max_key	end key value of the range, may also be 0
+@param[out]	key	normalized range */
+static void innobase_range_est_cache_key(const key_range *min_key,
+                                         const key_range *max_key,
+                                         std::string *key) {
+  for (const key_range *end : {min_key, max_key}) {
+    if (end == nullptr) {
+      key->push_back('\0');
+      continue;
+    }
+
+    uint32_t len = end->length;
+    key->push_back('\1');
+    key->push_back(static_cast<char>(end->flag));
+    key->append(reinterpret_cast<const char *>(&len), sizeof(len));
+    key->append(reinterpret_cast<const char *>(end->key), len);
+  }
+}
+
 ha_rows ha_innobase::records_in_range(
     uint keynr,         /*!< in: index number */
     key_range *min_key, /*!< in: start key value of the
@@ -15854,6 +15933,7 @@ ha_rows ha_innobase::records_in_range(
   page_cur_mode_t mode1;
   page_cur_mode_t mode2;
   mem_heap_t *heap;
+  std::string cache_key;
 
   DBUG_TRACE;
 
@@ -15889,6 +15969,16 @@ ha_rows ha_innobase::records_in_range(
     goto func_exit;
   }
 
+  /* Repeated ranges (e.g. large IN-lists from the same statement pattern)
+  are served from the per-index cache instead of diving again. */
+  if (srv_btr_range_est_cache_size > 0 && !dict_index_is_spatial(index)) {
+    innobase_range_est_cache_key(min_key, max_key, &cache_key);
+
+    if (btr_range_est_cache_lookup(index, cache_key, &n_rows)) {
+      goto func_exit;
+    }
+  }
+
   heap = mem_heap_create(
       2 * (key->actual_key_parts * sizeof(dfield_t) + sizeof(dtuple_t)));
 
@@ -15925,6 +16015,10 @@ ha_rows ha_innobase::records_in_range(
     } else {
       n_rows = btr_estimate_n_rows_in_range(index, range_start, mode1,
                                             range_end, mode2);
+
+      if (!cache_key.empty()) {
+        btr_range_est_cache_insert(index, cache_key, n_rows);
+      }
     }
   } else {
     n_rows = HA_POS_ERROR;
@@ -21537,6 +21631,13 @@ static MYSQL_SYSVAR_ULONG(
     "Page cleaner threads can be from 1 to 64. Default is 4.", NULL, NULL, 4, 1,
     64, 0);
 
+static MYSQL_SYSVAR_ULONG(
+    stats_recalc_threads, srv_n_stats_recalc_threads,
+    PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY,
+    "Number of background threads recalculating persistent statistics,"
+    " can be from 1 to 32. Default is 1.",
+    NULL, NULL, 1, 1, 32, 0);
+
 static MYSQL_SYSVAR_DOUBLE(max_dirty_pages_pct, srv_max_buf_pool_modified_pct,
                            PLUGIN_VAR_RQCMDARG,
                            "Percentage of dirty pages allowed in bufferpool.",
@@ -21627,6 +21728,19 @@ static MYSQL_SYSVAR_ULONGLONG(
     " statistics (by ANALYZE, default 20)",
     NULL, NULL, 20, 1, ~0ULL, 0);
 
+static MYSQL_SYSVAR_ULONG(
+    range_estimate_cache_size, srv_btr_range_est_cache_size,
+    PLUGIN_VAR_OPCMDARG,
+    "The max number of records_in_range() estimations cached per index,"
+    " 0 disables the cache (0 by default)",
+    NULL, NULL, 0, 0, 1024 * 1024, 0);
+
+static MYSQL_SYSVAR_ULONG(
+    range_estimate_cache_ttl, srv_btr_range_est_cache_ttl, PLUGIN_VAR_OPCMDARG,
+    "Seconds that a cached records_in_range() estimation keeps valid"
+    " (60 by default)",
+    NULL, NULL, 60, 1, 24 * 3600, 0);
+
 static MYSQL_SYSVAR_BOOL(
     adaptive_hash_index, btr_search_enabled, PLUGIN_VAR_OPCMDARG,
     "Enable InnoDB adaptive hash index (enabled by default). "
@@ -21648,6 +21762,13 @@ static MYSQL_SYSVAR_ULONG(
     " innodb_thread_concurrency is reached (0 by default)",
     NULL, NULL, 0, 0, ~0UL, 0);
 
+static MYSQL_SYSVAR_ULONG(
+    fk_check_cache_size, srv_fk_check_cache_size, PLUGIN_VAR_RQCMDARG,
+    "Maximum number of foreign key checks of a statement whose parent row"
+    " is remembered, so that repeated checks of the same parent key skip the"
+    " parent index search (0 disables it)",
+    NULL, NULL, 1024, 0, 1024 * 1024, 0);
+
 static MYSQL_SYSVAR_UINT(
     compression_level, page_zip_level, PLUGIN_VAR_RQCMDARG,
     "Compression level used for compressed row format.  0 is no compression"
@@ -21663,12 +21784,30 @@ static MYSQL_SYSVAR_BOOL(
     " compression algorithm doesn't change.",
     NULL, NULL, TRUE);
 
+static MYSQL_SYSVAR_BOOL(
+    compression_reuse_stream, page_zip_reuse_deflate_stream,
+    PLUGIN_VAR_OPCMDARG,
+    "Enables/disables keeping the zlib compression stream in each thread"
+    " that compresses pages. When turned ON, the stream is reset instead of"
+    " allocated and initialized for every page compression, at the cost of"
+    " a few hundred KB of memory kept by every such thread.",
+    NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(autoextend_increment,
                           sys_tablespace_auto_extend_increment,
                           PLUGIN_VAR_RQCMDARG,
                           "Data file autoextend increment in megabytes", NULL,
                           NULL, 64L, 1L, 1000L, 0);
 
+static MYSQL_SYSVAR_ULONG(
+    ibd_autoextend_increment, fsp_ibd_auto_extend_increment,
+    PLUGIN_VAR_RQCMDARG,
+    "Maximum autoextend increment in megabytes of single-table and general"
+    " tablespaces bigger than 32 extents. They grow by 1/8 of their size"
+    " up to this, rounded down to whole extents, but at least 4 extents."
+    " 0 (the default) extends them by 4 extents at a time.",
+    NULL, NULL, 0L, 0L, 1000L, 0);
+
 static MYSQL_SYSVAR_BOOL(
     dedicated_server, srv_dedicated_server,
     PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_NOPERSIST | PLUGIN_VAR_READONLY,
@@ -21800,6 +21939,12 @@ static MYSQL_SYSVAR_ULONG(flush_neighbors, srv_flush_neighbors,
                           " when flushing a block",
                           NULL, NULL, 0, 0, 2, 0);
 
+static MYSQL_SYSVAR_BOOL(
+    temp_flush_on_evict, srv_temp_flush_on_evict, PLUGIN_VAR_OPCMDARG,
+    "Skip pages of the temporary tablespaces in flush list flushing, they"
+    " are written only when evicted from the LRU list.",
+    NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ULONG(
     commit_concurrency, innobase_commit_concurrency, PLUGIN_VAR_RQCMDARG,
     "Helps in performance tuning in heavily concurrent environments.",
@@ -22227,6 +22372,14 @@ static MYSQL_SYSVAR_BOOL(undo_log_truncate, srv_undo_log_truncate,
                          "Enable or Disable Truncate of UNDO tablespace.", NULL,
                          NULL, TRUE);
 
+static MYSQL_SYSVAR_ULONG(
+    undo_log_truncate_spaces, srv_undo_log_truncate_spaces,
+    PLUGIN_VAR_OPCMDARG,
+    "Maximum number of UNDO tablespaces marked for truncate at the same"
+    " time. They are emptied by purge concurrently and truncated one after"
+    " another.",
+    NULL, NULL, 1, 1, FSP_MAX_UNDO_TABLESPACES, 0);
+
 /*  This is the number of rollback segments per undo tablespace.
 This applies to the temporary tablespace, the system tablespace,
 and all undo tablespaces. */
@@ -22318,6 +22471,13 @@ static MYSQL_SYSVAR_UINT(
     NULL, innodb_change_buffer_max_size_update, CHANGE_BUFFER_DEFAULT_SIZE, 0,
     50, 0);
 
+static MYSQL_SYSVAR_BOOL(
+    change_buffer_merge_sequential, ibuf_merge_sequential, PLUGIN_VAR_OPCMDARG,
+    "Merge the change buffer in the order of the buffered pages, continuing"
+    " where the previous merge stopped, instead of from random positions."
+    " The pages of an index are then read in ascending order.",
+    NULL, NULL, FALSE);
+
 static MYSQL_SYSVAR_ENUM(
     stats_method, srv_innodb_stats_method, PLUGIN_VAR_RQCMDARG,
     "Specifies how InnoDB index statistics collection code should"
@@ -22354,6 +22514,14 @@ static MYSQL_SYSVAR_ULONG(
     " trigger a readahead.",
     NULL, NULL, 56, 0, 64, 0);
 
+static MYSQL_SYSVAR_ULONG(
+    logical_read_ahead_pages, srv_logical_read_ahead_pages,
+    PLUGIN_VAR_RQCMDARG,
+    "Maximum number of leaf pages that a range scan reads ahead, found by"
+    " the node pointers on their parent page. The window starts small and"
+    " doubles while the scan goes on. 0 (the default) disables it.",
+    NULL, NULL, 0, 0, 1024, 0);
+
 static MYSQL_SYSVAR_STR(monitor_enable, innobase_enable_monitor_counter,
                         PLUGIN_VAR_RQCMDARG, "Turn on a monitor counter",
                         innodb_monitor_validate, innodb_enable_monitor_update,
@@ -22652,6 +22820,7 @@ static SYS_VAR *innobase_system_variables[] = {
     MYSQL_SYSVAR(api_trx_level),
     MYSQL_SYSVAR(api_bk_commit_interval),
     MYSQL_SYSVAR(autoextend_increment),
+    MYSQL_SYSVAR(ibd_autoextend_increment),
     MYSQL_SYSVAR(dedicated_server),
     MYSQL_SYSVAR(buffer_pool_size),
     MYSQL_SYSVAR(buffer_pool_chunk_size),
@@ -22669,11 +22838,13 @@ static SYS_VAR *innobase_system_variables[] = {
     MYSQL_SYSVAR(buffer_pool_load_at_startup),
     MYSQL_SYSVAR(lru_scan_depth),
     MYSQL_SYSVAR(flush_neighbors),
+    MYSQL_SYSVAR(temp_flush_on_evict),
     MYSQL_SYSVAR(checksum_algorithm),
     MYSQL_SYSVAR(log_checksums),
     MYSQL_SYSVAR(commit_concurrency),
     MYSQL_SYSVAR(concurrency_tickets),
     MYSQL_SYSVAR(compression_level),
+    MYSQL_SYSVAR(compression_reuse_stream),
     MYSQL_SYSVAR(data_file_path),
     MYSQL_SYSVAR(temp_data_file_path),
     MYSQL_SYSVAR(data_home_dir),
@@ -22762,11 +22933,14 @@ static SYS_VAR *innobase_system_variables[] = {
     MYSQL_SYSVAR(stats_transient_sample_pages),
     MYSQL_SYSVAR(stats_persistent),
     MYSQL_SYSVAR(stats_persistent_sample_pages),
+    MYSQL_SYSVAR(range_estimate_cache_size),
+    MYSQL_SYSVAR(range_estimate_cache_ttl),
     MYSQL_SYSVAR(stats_auto_recalc),
     MYSQL_SYSVAR(adaptive_hash_index),
     MYSQL_SYSVAR(adaptive_hash_index_parts),
     MYSQL_SYSVAR(stats_method),
     MYSQL_SYSVAR(replication_delay),
+    MYSQL_SYSVAR(fk_check_cache_size),
     MYSQL_SYSVAR(status_file),
     MYSQL_SYSVAR(strict_mode),
     MYSQL_SYSVAR(sort_buffer_size),
@@ -22789,18 +22963,21 @@ static SYS_VAR *innobase_system_variables[] = {
 #endif /* HAVE_LIBNUMA */
     MYSQL_SYSVAR(change_buffering),
     MYSQL_SYSVAR(change_buffer_max_size),
+    MYSQL_SYSVAR(change_buffer_merge_sequential),
 #if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
     MYSQL_SYSVAR(change_buffering_debug),
     MYSQL_SYSVAR(disable_background_merge),
 #endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
     MYSQL_SYSVAR(random_read_ahead),
     MYSQL_SYSVAR(read_ahead_threshold),
+    MYSQL_SYSVAR(logical_read_ahead_pages),
     MYSQL_SYSVAR(read_only),
 
     MYSQL_SYSVAR(io_capacity),
     MYSQL_SYSVAR(io_capacity_max),
     MYSQL_SYSVAR(idle_flush_pct),
     MYSQL_SYSVAR(page_cleaners),
+    MYSQL_SYSVAR(stats_recalc_threads),
     MYSQL_SYSVAR(monitor_enable),
     MYSQL_SYSVAR(monitor_disable),
     MYSQL_SYSVAR(monitor_reset),
@@ -22829,6 +23006,7 @@ static SYS_VAR *innobase_system_variables[] = {
     MYSQL_SYSVAR(max_undo_log_size),
     MYSQL_SYSVAR(purge_rseg_truncate_frequency),
     MYSQL_SYSVAR(undo_log_truncate),
+    MYSQL_SYSVAR(undo_log_truncate_spaces),
     MYSQL_SYSVAR(undo_log_encrypt),
     MYSQL_SYSVAR(rollback_segments),
     MYSQL_SYSVAR(undo_directory),
@@ -135,6 +135,8 @@ class ha_innobase : public handler {
 
   int write_row(uchar *buf) override;
 
+  int write_rows(uchar **records, uint count) override;
+
   int update_row(const uchar *old_data, uchar *new_data) override;
 
   int delete_row(const uchar *buf) override;
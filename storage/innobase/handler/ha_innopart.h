@@ -51,7 +51,8 @@ set from ha_innobase, but cannot yet be supported in ha_innopart.
 Full text and geometry is not yet supported. */
 const handler::Table_flags HA_INNOPART_DISABLED_TABLE_FLAGS =
     (HA_CAN_FULLTEXT | HA_CAN_FULLTEXT_EXT | HA_CAN_GEOMETRY |
-     HA_DUPLICATE_POS | HA_READ_BEFORE_WRITE_REMOVAL);
+     HA_DUPLICATE_POS | HA_READ_BEFORE_WRITE_REMOVAL |
+     HA_CAN_WRITE_ROWS_BATCH);
 
 typedef Bitset Sql_stat_start_parts;
 
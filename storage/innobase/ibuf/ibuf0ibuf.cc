@@ -31,6 +31,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
  *******************************************************/
 
 #include <sys/types.h>
+#include <atomic>
 
 #include "btr0sea.h"
 #include "ha_prototypes.h"
@@ -200,6 +201,14 @@ access order rules. */
 /** Operations that can currently be buffered. */
 ulong innodb_change_buffering = IBUF_USE_ALL;
 
+/** Whether the contraction merges the change buffer in the order of the
+buffered pages, instead of at random positions. */
+bool ibuf_merge_sequential = false;
+
+/** Position of the sequential merge: (space id << 32) | page number of the
+first page that the next contraction merges the changes of */
+static std::atomic<uint64_t> ibuf_merge_next_pos{0};
+
 #if defined UNIV_DEBUG || defined UNIV_IBUF_DEBUG
 /** Flag to control insert buffer debugging. */
 uint ibuf_debug;
@@ -2286,6 +2295,60 @@ static MY_ATTRIBUTE((warn_unused_result)) ulint
   return (volume);
 }
 
+/** Open a cursor on the first change buffer record of the pages at or after
+the position of the sequential merge. Starts over from the first record of
+the tree if there is none.
+@param[out]	pcur	cursor, on a user record unless the tree is empty
+@param[in,out]	mtr	mini-transaction, restarted if started over
+@return the user record, or nullptr if the tree is empty */
+static const rec_t *ibuf_merge_sequential_open(btr_pcur_t *pcur, mtr_t *mtr) {
+  const uint64_t pos = ibuf_merge_next_pos.load(std::memory_order_relaxed);
+
+  mem_heap_t *heap = mem_heap_create(512);
+
+  dtuple_t *tuple = ibuf_search_tuple_build(
+      static_cast<space_id_t>(pos >> 32), static_cast<page_no_t>(pos), heap);
+
+  btr_pcur_open(ibuf->index, tuple, PAGE_CUR_GE, BTR_SEARCH_LEAF, pcur, mtr);
+
+  mem_heap_free(heap);
+
+  const rec_t *rec = ibuf_get_user_rec(pcur, mtr);
+
+  if (rec != nullptr || pos == 0) {
+    return (rec);
+  }
+
+  /* All buffered pages after the position have been merged. Release the
+  leaf latch before descending the tree again. */
+  ibuf_mtr_commit(mtr);
+  btr_pcur_close(pcur);
+
+  ibuf_merge_next_pos.store(0, std::memory_order_relaxed);
+
+  ibuf_mtr_start(mtr);
+
+  btr_pcur_open_at_index_side(true, ibuf->index, BTR_SEARCH_LEAF, pcur, true,
+                              0, mtr);
+
+  return (ibuf_get_user_rec(pcur, mtr));
+}
+
+/** Move the position of the sequential merge to the merge area following
+the one of a page. Past the last area of a tablespace it carries over to the
+next tablespace id.
+@param[in]	space_id	tablespace id of the page
+@param[in]	page_no		page number */
+static void ibuf_merge_sequential_advance(space_id_t space_id,
+                                          page_no_t page_no) {
+  const uint64_t area_start =
+      (static_cast<uint64_t>(space_id) << 32) |
+      (page_no / IBUF_MERGE_AREA * IBUF_MERGE_AREA);
+
+  ibuf_merge_next_pos.store(area_start + IBUF_MERGE_AREA,
+                            std::memory_order_relaxed);
+}
+
 /** Contracts insert buffer trees by reading pages to the buffer pool.
  @return a lower limit for the combined size in bytes of entries which
  will be merged from ibuf trees to the pages read, 0 if ibuf is
@@ -2309,14 +2372,20 @@ static ulint ibuf_merge_pages(
 
   ibuf_mtr_start(&mtr);
 
-  /* Open a cursor to a randomly chosen leaf of the tree, at a random
-  position within the leaf */
-  bool available;
-
-  available =
-      btr_pcur_open_at_rnd_pos(ibuf->index, BTR_SEARCH_LEAF, &pcur, &mtr);
-  /* No one should make this index unavailable when server is running */
-  ut_a(available);
+  if (ibuf_merge_sequential) {
+    /* Open a cursor where the previous contraction stopped, so that
+    the buffered pages are read in ascending order */
+    ibuf_merge_sequential_open(&pcur, &mtr);
+  } else {
+    /* Open a cursor to a randomly chosen leaf of the tree, at a random
+    position within the leaf */
+    bool available;
+
+    available =
+        btr_pcur_open_at_rnd_pos(ibuf->index, BTR_SEARCH_LEAF, &pcur, &mtr);
+    /* No one should make this index unavailable when server is running */
+    ut_a(available);
+  }
 
   ut_ad(page_validate(btr_pcur_get_page(&pcur), ibuf->index));
 
@@ -2341,6 +2410,22 @@ static ulint ibuf_merge_pages(
 	fprintf(stderr, "Ibuf contract sync %lu pages %lu volume %lu\n",
 		sync, *n_pages, sum_sizes);
 #endif
+
+  if (ibuf_merge_sequential) {
+    if (*n_pages > 0) {
+      /* A batch does not span merge areas, continue with the next one */
+      ibuf_merge_sequential_advance(space_ids[*n_pages - 1],
+                                    page_nos[*n_pages - 1]);
+    } else if (page_rec_is_user_rec(btr_pcur_get_rec(&pcur))) {
+      /* No page was picked around the record, step over its area
+      rather than opening the cursor on the same record forever */
+      const rec_t *rec = btr_pcur_get_rec(&pcur);
+
+      ibuf_merge_sequential_advance(ibuf_rec_get_space(&mtr, rec),
+                                    ibuf_rec_get_page_no(&mtr, rec));
+    }
+  }
+
   ibuf_mtr_commit(&mtr);
   btr_pcur_close(&pcur);
 
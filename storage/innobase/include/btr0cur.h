@@ -174,6 +174,23 @@ void btr_cur_search_to_nth_level(
     ulint line,       /*!< in: line where called */
     mtr_t *mtr);      /*!< in: mtr */
 
+/** Positions a tree cursor on a leaf page remembered from a previous search,
+without descending the tree. The page is latched optimistically, and the
+guess is only taken if the tuple falls into the key range of the page.
+@param[in]	index		index
+@param[in]	tuple		data tuple
+@param[in]	block		guessed leaf block
+@param[in]	modify_clock	modify clock of the block when it was guessed
+@param[out]	cursor		tree cursor, x-latched on the leaf on success
+@param[in]	file		file name
+@param[in]	line		line where called
+@param[in,out]	mtr		mini-transaction
+@return true if success */
+bool btr_cur_search_leaf_hint(dict_index_t *index, const dtuple_t *tuple,
+                              buf_block_t *block, uint64_t modify_clock,
+                              btr_cur_t *cursor, const char *file, ulint line,
+                              mtr_t *mtr);
+
 /** Searches an index tree and positions a tree cursor on a given level.
 This function will avoid placing latches the travesal path and so
 should be used only for cases where-in latching is not needed.
@@ -764,6 +781,14 @@ struct btr_cur_t {
 
   /** If cursor is used in a scan or simple page fetch. */
   Page_fetch m_fetch_mode{Page_fetch::NORMAL};
+
+  /** in: number of leaf pages following the searched one to read ahead
+  when btr_cur_search_to_nth_level() passes their parent page, 0 for none;
+  out: number of such leaf pages found on the parent page */
+  ulint read_ahead_n_pages{0};
+
+  /** out: number of read requests issued for the above leaf pages */
+  ulint read_ahead_n_reads{0};
 };
 
 /** The following function is used to set the deleted bit of a record.
@@ -0,0 +1,152 @@
+/* Copyright (c) 2018, 2021, Alibaba and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/** @file include/btr0est.h
+ Cache of the index range estimation (index dive) results.
+
+ Created 2021-03-02 by Galaxy SQL
+ *******************************************************/
+#ifndef btr0est_h
+#define btr0est_h
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "dict0mem.h"
+#include "ut0mutex.h"
+
+#ifdef UNIV_PFS_MUTEX
+/* Range estimation cache mutex PFS key */
+extern mysql_pfs_key_t btr_range_est_cache_mutex_key;
+#endif
+
+/** Max count of cached range estimations per index, 0 means disabled */
+extern ulong srv_btr_range_est_cache_size;
+
+/** Time (seconds) that a cached range estimation keeps valid */
+extern ulong srv_btr_range_est_cache_ttl;
+
+/** Cached estimation is discarded once more than 1/N of the table rows have
+been modified since it was taken, same counter as dict_stats uses. */
+constexpr ib_uint64_t BTR_RANGE_EST_CACHE_MODIFIED_RATIO = 100;
+
+/**
+  Bounded LRU cache of btr_estimate_n_rows_in_range() results of one index.
+
+  The key is the normalized range endpoints, i.e. the search mode and the
+  key image of both ends. An entry is valid only if the statistics of the
+  table haven't been recalculated, and the table hasn't been modified too
+  much since it was cached, and it's not older than the ttl.
+*/
+class Range_est_cache {
+  typedef std::list<std::string, ut_allocator<std::string>> Lru_list;
+
+  struct Entry {
+    /** Cached estimation */
+    int64_t n_rows;
+
+    /** dict_table_t::stat_modified_counter when cached */
+    ib_uint64_t modified_counter;
+
+    /** dict_table_t::stats_last_recalc when cached */
+    ib_time_monotonic_t stats_last_recalc;
+
+    /** Time when cached */
+    ib_time_monotonic_t cached_time;
+
+    /** Position in LRU list */
+    Lru_list::iterator lru_pos;
+  };
+
+  typedef std::unordered_map<
+      std::string, Entry, std::hash<std::string>, std::equal_to<std::string>,
+      ut_allocator<std::pair<const std::string, Entry>>>
+      Entry_map;
+
+ public:
+  Range_est_cache();
+
+  ~Range_est_cache();
+
+  /**
+    Look up a cached estimation.
+
+    @param[in]      table       table of the index
+    @param[in]      key         normalized range
+    @param[out]     n_rows      cached estimation
+
+    @retval         true        found a valid entry
+  */
+  bool lookup(const dict_table_t *table, const std::string &key,
+              int64_t *n_rows);
+
+  /**
+    Cache an estimation, evict the least recently used entry if full.
+
+    @param[in]      table       table of the index
+    @param[in]      key         normalized range
+    @param[in]      n_rows      estimation
+  */
+  void insert(const dict_table_t *table, const std::string &key,
+              int64_t n_rows);
+
+ private:
+  /** Whether the entry can still be used */
+  bool is_valid(const dict_table_t *table, const Entry &entry,
+                ib_time_monotonic_t now) const;
+
+  /** Disable copy */
+  Range_est_cache(Range_est_cache const &) = delete;
+  void operator=(Range_est_cache const &) = delete;
+
+ private:
+  /** mutex to protect the cache */
+  SysMutex m_mutex;
+
+  /** Most recently used in the front */
+  Lru_list m_lru;
+
+  /** Normalized range to estimation */
+  Entry_map m_map;
+};
+
+/** Look up the cached estimation of the range of index.
+@param[in]	index	index to estimate
+@param[in]	key	normalized range
+@param[out]	n_rows	cached estimation
+@return true if found a valid one */
+bool btr_range_est_cache_lookup(dict_index_t *index, const std::string &key,
+                                int64_t *n_rows);
+
+/** Cache the estimation of the range of index.
+@param[in]	index	index to estimate
+@param[in]	key	normalized range
+@param[in]	n_rows	estimation */
+void btr_range_est_cache_insert(dict_index_t *index, const std::string &key,
+                                int64_t n_rows);
+
+/** Free the estimation cache of an index.
+@param[in]	index	index being freed */
+void btr_range_est_cache_free(dict_index_t *index);
+
+#endif
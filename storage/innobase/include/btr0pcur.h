@@ -40,6 +40,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "dict0dict.h"
 #include "mtr0mtr.h"
 #include "page0cur.h"
+#include "srv0srv.h"
 #include "univ.i"
 #ifndef UNIV_HOTBACKUP
 #include "gis0rtree.h"
@@ -61,6 +62,10 @@ enum btr_pcur_pos_t {
   BTR_PCUR_AFTER_LAST_IN_TREE = 5    /* in an empty tree */
 };
 
+/** Initial number of leaf pages to read ahead, see
+btr_pcur_t::init_read_ahead() */
+constexpr ulint BTR_PCUR_READ_AHEAD_MIN_PAGES = 8;
+
 #define btr_pcur_create_for_mysql() btr_pcur_t::create_for_mysql()
 #define btr_pcur_free_for_mysql(p) btr_pcur_t::free_for_mysql(p)
 
@@ -277,6 +282,21 @@ struct btr_pcur_t {
             page_cur_mode_t mode, ulint latch_mode, mtr_t *mtr,
             const char *file, ulint line);
 
+  /** Initializes a persistent cursor and positions it for an insert on a
+  leaf page remembered from a previous search, as open() with PAGE_CUR_LE
+  and BTR_MODIFY_LEAF would, without descending the tree.
+  @param[in]	    index		      Index.
+  @param[in]	    tuple		      Tuple to insert.
+  @param[in]	    block		      Guessed leaf block.
+  @param[in]	    modify_clock	Modify clock of the block when guessed.
+  @param[in]	    mtr		        Mini-transaction.
+  @param[in]	    file		      File name
+  @param[in]	    line		      Line in file, from where called.
+  @return true if positioned, else the cursor must be opened with open() */
+  bool open_on_leaf_hint(dict_index_t *index, const dtuple_t *tuple,
+                         buf_block_t *block, uint64_t modify_clock, mtr_t *mtr,
+                         const char *file, ulint line);
+
   /** Restores the stored position of a persistent cursor bufferfixing
   the page and obtaining the specified latches. If the cursor position
   was saved when the
@@ -499,6 +519,19 @@ struct btr_pcur_t {
     pcur = nullptr;
   }
 
+  /** Enable or disable logical read-ahead of the leaf pages for a new
+  forward scan, see srv_logical_read_ahead_pages. If enabled, the leaf pages
+  following the cursor are read ahead when it is opened, and again, twice as
+  many, when it is restored after half of them have been passed.
+  @param[in]	enable		true to enable read-ahead */
+  void init_read_ahead(bool enable) {
+    m_read_ahead_window =
+        enable ? std::min(static_cast<ulint>(srv_logical_read_ahead_pages),
+                          BTR_PCUR_READ_AHEAD_MIN_PAGES)
+               : 0;
+    m_read_ahead_left = 0;
+  }
+
   /** Set the cursor access type: Normal or Scan.
   @param[in]  fetch_mode      One of Page_fetch::NORMAL or Page_fetch::SCAN.
   @return the old fetch mode. */
@@ -513,6 +546,43 @@ struct btr_pcur_t {
   }
 
  private:
+  /** @return true if the leaf pages read ahead are running out, and
+  the cursor should be positioned by a search to read ahead more. */
+  bool read_ahead_needed() const {
+    return (m_read_ahead_window > 0 &&
+            m_read_ahead_left <= m_read_ahead_window / 2);
+  }
+
+  /** Request a read-ahead from the next search of the tree cursor. */
+  void read_ahead_prepare() {
+    m_btr_cur.read_ahead_n_pages = m_read_ahead_window;
+  }
+
+  /** Double the window for the next read-ahead, up to the configured
+  maximum, once the cursor has passed half of the pages read ahead. */
+  void read_ahead_grow() {
+    m_read_ahead_window =
+        std::min(static_cast<ulint>(srv_logical_read_ahead_pages),
+                 m_read_ahead_window * 2);
+  }
+
+  /** Account the leaf pages read ahead by the search of the tree cursor.
+  They are counted against the window they were requested with, so the
+  next read-ahead is not needed before half of them have been passed. */
+  void read_ahead_complete() {
+    if (m_btr_cur.read_ahead_n_pages == 0) {
+      /* The search did not pass a parent of leaf pages, e.g. it used
+      the adaptive hash index or the root is a leaf. Don't search again
+      before the cursor has passed as many pages as for a read-ahead. */
+      m_read_ahead_left = m_read_ahead_window;
+      return;
+    }
+
+    m_read_ahead_left = m_btr_cur.read_ahead_n_pages;
+
+    m_btr_cur.read_ahead_n_pages = 0;
+  }
+
   /** Moves the persistent cursor backward if it is on the first record
   of the page. Commits mtr. Note that to prevent a possible deadlock, the
   operation first stores the position of the cursor, commits mtr, acquires
@@ -588,6 +658,13 @@ struct btr_pcur_t {
   /** Collected cursor that need to cleanout */
   lizard::Cleanout_cursors *m_cleanout_cursors{nullptr};
 
+  /** Number of leaf pages to read ahead by the next search, 0 if
+  logical read-ahead is disabled for the cursor */
+  ulint m_read_ahead_window{0};
+
+  /** Number of leaf pages read ahead that the cursor has not passed yet */
+  ulint m_read_ahead_left{0};
+
   /** Add constructor to init m_cleanout_pages, otherwise we have to init it
   at many place.*/
   btr_pcur_t() {
@@ -599,6 +676,9 @@ struct btr_pcur_t {
 inline void btr_pcur_t::init() {
   set_fetch_type(Page_fetch::NORMAL);
 
+  m_read_ahead_window = 0;
+  m_read_ahead_left = 0;
+
   m_old_stored = false;
   m_old_rec_buf = nullptr;
   m_old_rec = nullptr;
@@ -658,6 +738,26 @@ inline void btr_pcur_t::open(dict_index_t *index, ulint level,
   ut_ad(!m_cleanout_cursors || m_cleanout_cursors->is_empty());
 }
 
+inline bool btr_pcur_t::open_on_leaf_hint(dict_index_t *index,
+                                          const dtuple_t *tuple,
+                                          buf_block_t *block,
+                                          uint64_t modify_clock, mtr_t *mtr,
+                                          const char *file, ulint line) {
+  init();
+
+  if (!btr_cur_search_leaf_hint(index, tuple, block, modify_clock,
+                                get_btr_cur(), file, line, mtr)) {
+    return (false);
+  }
+
+  m_search_mode = PAGE_CUR_LE;
+  m_latch_mode = BTR_MODIFY_LEAF;
+  m_pos_state = BTR_PCUR_IS_POSITIONED;
+  m_trx_if_known = nullptr;
+
+  return (true);
+}
+
 inline void btr_pcur_t::open_at_side(bool from_left, dict_index_t *index,
                                      ulint latch_mode, bool init_pcur,
                                      ulint level, mtr_t *mtr) {
@@ -723,8 +823,16 @@ inline void btr_pcur_t::open_no_init(dict_index_t *index, const dtuple_t *tuple,
         index, 0, tuple, mode, cur, file, line, mtr,
         ((latch_mode & BTR_MODIFY_LEAF) ? true : false));
   } else {
+    if (m_read_ahead_window > 0) {
+      read_ahead_prepare();
+    }
+
     btr_cur_search_to_nth_level(index, 0, tuple, mode, latch_mode, cur,
                                 has_search_latch, file, line, mtr);
+
+    if (m_read_ahead_window > 0) {
+      read_ahead_complete();
+    }
   }
 
   m_pos_state = BTR_PCUR_IS_POSITIONED;
@@ -1014,6 +1122,9 @@ inline void btr_pcur_t::reset() {
   m_old_n_fields = 0;
   m_old_stored = false;
 
+  m_read_ahead_window = 0;
+  m_read_ahead_left = 0;
+
   if (m_cleanout_pages) m_cleanout_pages->init();
   if (m_cleanout_cursors) m_cleanout_cursors->init();
 
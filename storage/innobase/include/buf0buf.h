@@ -1799,6 +1799,10 @@ struct buf_pool_t {
   UT_LIST_BASE_NODE_T(buf_page_t) flush_list;
   /*!< base node of the modified block
   list */
+  ulint n_temp_flush_list;
+  /*!< number of pages of temporary
+  tablespaces in flush_list. Protected by
+  flush_list_mutex */
   ibool init_flush[BUF_FLUSH_N_TYPES];
   /*!< this is TRUE when a flush of the
   given type is being initialized.
@@ -869,6 +869,8 @@ namespace dd {
 class Spatial_reference_system;
 }
 
+class Range_est_cache;
+
 /** Data structure for an index.  Most fields will be
 initialized to 0, NULL or FALSE in dict_mem_index_create(). */
 struct dict_index_t {
@@ -1026,6 +1028,13 @@ struct dict_index_t {
                                when InnoDB was started up */
   zip_pad_info_t zip_pad;      /*!< Information about state of
                                compression failures and successes */
+#ifndef UNIV_HOTBACKUP
+  Range_est_cache *range_est_cache;
+  /*!< cache of records_in_range() estimations,
+  created on first use, see btr0est.h */
+  volatile os_once::state_t range_est_cache_created;
+  /*!< Creation state of range_est_cache */
+#endif /* !UNIV_HOTBACKUP */
   rw_lock_t lock;              /*!< read-write lock protecting the
                                upper levels of the index tree */
   bool fill_dd;                /*!< Flag whether need to fill dd tables
@@ -2554,6 +2563,15 @@ inline void dict_index_zip_pad_mutex_create_lazy(dict_index_t *index) {
   index->zip_pad.mutex_created = os_once::NEVER_DONE;
 }
 
+/** Request a lazy creation of dict_index_t::range_est_cache.
+This function is only called from either single threaded environment
+or from a thread that has not shared the table object with other threads.
+@param[in,out]	index	index whose range estimation cache is to be created */
+inline void dict_index_range_est_cache_create_lazy(dict_index_t *index) {
+  index->range_est_cache = NULL;
+  index->range_est_cache_created = os_once::NEVER_DONE;
+}
+
 /** Destroy the zip_pad_mutex of the given index.
 This function is only called from either single threaded environment
 or from a thread that has not shared the table object with other threads.
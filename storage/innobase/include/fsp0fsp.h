@@ -57,6 +57,10 @@ extern std::vector<DDL_Record *> ts_encrypt_ddl_records;
 extern mysql_cond_t resume_encryption_cond;
 extern mysql_mutex_t resume_encryption_cond_m;
 
+/** Maximum megabytes to extend big single-table and general tablespaces by
+at a time, 0 to extend them by FSP_FREE_ADD extents */
+extern ulong fsp_ibd_auto_extend_increment;
+
 /* @defgroup Tablespace Header Constants (moved from fsp0fsp.c) @{ */
 
 /** Offset of the space header within a file page */
@@ -179,6 +183,10 @@ header slots are reserved */
   4 /* this many free extents are added \
     to the free list from above         \
     FSP_FREE_LIMIT at a time */
+
+/** Big single-table and general tablespaces are extended by this fraction
+of their size at a time, see fsp_ibd_auto_extend_increment */
+#define FSP_IBD_EXTEND_RATIO 8
 /* @} */
 
 /* @defgroup File Segment Inode Constants (moved from fsp0fsp.c) @{ */
@@ -71,6 +71,10 @@ enum ibuf_use_t {
 /** Operations that can currently be buffered. */
 extern ulong innodb_change_buffering;
 
+/** Whether the contraction merges the change buffer in the order of the
+buffered pages, instead of at random positions. */
+extern bool ibuf_merge_sequential;
+
 /** The insert buffer control structure */
 extern ibuf_t *ibuf;
 
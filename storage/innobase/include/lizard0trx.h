@@ -28,22 +28,135 @@
 #define lizard0trx_h
 
 #include <map>
+#include <unordered_map>
 
 #include "trx0types.h"
+#include "ut0mutex.h"
 
 struct trx_t;
 
-typedef std::unordered_map<trx_id_t, trx_t *, std::hash<trx_id_t>,
-                           std::equal_to<trx_id_t>,
-                           ut_allocator<std::pair<const trx_id_t, trx_t *>>>
-    TrxIdHash;
+#ifdef UNIV_PFS_MUTEX
+/* lizard rw trx hash partition mutex PFS key */
+extern mysql_pfs_key_t lizard_rw_trx_hash_mutex_key;
+#endif
 
 typedef std::pair<trx_id_t, trx_t *> TrxPair;
 
 namespace lizard {
 
+/** How many partitions of the active read-write transaction hash */
+constexpr ulint TRX_ID_HASH_PARTITIONS = 64;
+
+/**
+  Mapping from transaction id to the active read-write transaction instance.
+
+  The map is split into TRX_ID_HASH_PARTITIONS partitions by trx id, every
+  partition is protected by its own mutex, so that lookup (implicit lock
+  check) doesn't need trx_sys->mutex any more, and concurrent insert/erase
+  only conflict when the ids fall into the same partition.
+
+  Insert and erase are still called within trx_sys->mutex since rw_trx_list
+  and max_trx_id are maintained in the same critical section, so transaction
+  start and commit remain serialized on trx_sys->mutex. Only the implicit
+  lock check (trx_rw_is_active) is taken off it. This is not a lock-free
+  map, lookups take the partition mutex.
+*/
+class TrxIdHash {
+  typedef std::unordered_map<trx_id_t, trx_t *, std::hash<trx_id_t>,
+                             std::equal_to<trx_id_t>,
+                             ut_allocator<std::pair<const trx_id_t, trx_t *>>>
+      TrxIdMap;
+
+  class Partition {
+   public:
+    Partition();
+
+    ~Partition();
+
+    /** mutex to protect the map */
+    ib_mutex_t m_mutex;
+
+    /** trx id to trx instance */
+    TrxIdMap m_map;
+
+    /** To avoid false sharing */
+    char m_pad[INNOBASE_CACHE_LINE_SIZE];
+  };
+
+ public:
+  TrxIdHash();
+
+  ~TrxIdHash();
+
+  /**
+    Add an active read-write transaction.
+
+    @param[in]		trx id and the transaction
+  */
+  void insert(const TrxPair &pair);
+
+  /**
+    Remove the transaction from the hash.
+
+    @param[in]		trx id
+  */
+  void erase(trx_id_t id);
+
+  /**
+    Look up the transaction by id.
+
+    @param[in]		trx id
+
+    @retval		the trx handle or nullptr, the pointer must not be
+                        dereferenced unless the caller prevents it from
+                        being committed.
+  */
+  trx_t *find(trx_id_t id);
+
+  /**
+    Look up the transaction by id and reference it within the partition
+    latch, so the trx can't be committed and freed during the lookup.
+
+    @param[in]		trx id
+    @param[in]		whether increase the reference count
+
+    @retval		the active trx handle or nullptr
+  */
+  trx_t *find_and_reference(trx_id_t id, bool do_ref_count);
+
+  /**
+    Total count of all partitions, it's an estimated value.
+
+    @retval		total count
+  */
+  ulint size() const;
+
+  /**
+    Copy all the transaction into the ordered set.
+
+    @param[out]		the ordered trx set
+  */
+  void copy_to(TrxIdSet &s);
+
+ private:
+  /** Disable copy */
+  TrxIdHash(TrxIdHash const &) = delete;
+  TrxIdHash(TrxIdHash const &&) = delete;
+  void operator=(TrxIdHash const &) = delete;
+
+  Partition &get_partition(trx_id_t id) {
+    return m_parts[id % TRX_ID_HASH_PARTITIONS];
+  }
+
+ private:
+  /** All partitions */
+  Partition m_parts[TRX_ID_HASH_PARTITIONS];
+};
+
 extern void copy_to(TrxIdHash &h, TrxIdSet &s);
 
 }  // namespace lizard
 
+typedef lizard::TrxIdHash TrxIdHash;
+
 #endif
@@ -484,6 +484,17 @@ struct Encryption {
   /** Check if keyring plugin loaded. */
   static bool check_keyring();
 
+  /** Encrypt or decrypt data with AES-256-CBC, the key and the iv of this
+  object. The expanded key is kept by the calling thread, so that the pages
+  and log blocks of a tablespace do not expand it again for each call.
+  @param[in]	encrypt		true to encrypt, false to decrypt
+  @param[in]	src		data, a multiple of MY_AES_BLOCK_SIZE
+  @param[in]	src_len		size of the data in bytes
+  @param[out]	dst		destination area
+  @return size of the result, or MY_AES_BAD_DATA */
+  int aes_crypt(bool encrypt, const byte *src, ulint src_len, byte *dst) const
+      MY_ATTRIBUTE((warn_unused_result));
+
   /** Encrypt type */
   Type m_type;
 
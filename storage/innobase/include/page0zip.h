@@ -83,6 +83,50 @@ extern uint page_zip_level;
 compression algorithm changes in zlib. */
 extern bool page_zip_log_pages;
 
+/* Whether or not to keep the zlib deflate stream of page_zip_compress()
+in the thread and reset it for the next page. Settable by user. */
+extern bool page_zip_reuse_deflate_stream;
+
+/** zlib deflate stream kept by a thread between page_zip_compress() calls.
+
+Initializing a stream allocates and clears about UNIV_PAGE_SIZE * 4 +
+(512 << MAX_MEM_LEVEL) bytes, which is far more than what the page itself
+costs to compress at low levels. A kept stream is only reset, which keeps
+its window and hash buffers. The buffers are allocated by zlib itself, not
+from a mem_heap_t, because they are released at thread exit, possibly after
+InnoDB has shut down. A reset stream produces the same output as a newly
+initialized one, so the compressed page format does not change. */
+class Page_zip_deflate_stream {
+ public:
+  Page_zip_deflate_stream() : m_inited(false), m_level(0) {}
+
+  ~Page_zip_deflate_stream() { close(); }
+
+  /** Get the stream ready for compressing a new page.
+  @param[in]	level	compression level
+  @return the stream */
+  z_stream *open(ulint level);
+
+  /** @return whether the stream is initialized */
+  bool is_open() const { return (m_inited); }
+
+  /** @return compression level of the stream, valid if is_open() */
+  ulint level() const { return (m_level); }
+
+ private:
+  /** Release the buffers of the stream. */
+  void close();
+
+  /** The stream, valid if m_inited */
+  z_stream m_stream;
+
+  /** Whether deflateInit2() has been done on m_stream */
+  bool m_inited;
+
+  /** Compression level of m_stream */
+  ulint m_level;
+};
+
 /** Set the size of a compressed page in bytes.
 @param[in,out]	page_zip	compressed page
 @param[in]	size		size in bytes */
@@ -33,6 +33,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #ifndef row0ins_h
 #define row0ins_h
 
+#include "buf0types.h"
 #include "data0data.h"
 #include "dict0types.h"
 #include "que0types.h"
@@ -40,6 +41,20 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "trx0types.h"
 #include "univ.i"
 
+/** The clustered index leaf page the previous insert of a sorted run went
+to, revalidated by its modify clock before it is reused */
+struct ins_leaf_hint_t {
+  /** leaf block, or nullptr */
+  buf_block_t *block;
+  /** modify clock of the block when it was remembered */
+  uint64_t modify_clock;
+  /** buf_withdraw_clock when it was remembered */
+  ulint withdraw_clock;
+
+  /** Forget the page */
+  void reset() { block = nullptr; }
+};
+
 /** Checks if foreign key constraint fails for an index entry. Sets shared locks
  which lock either the success or the failure of the constraint. NOTE that
  the caller must have a shared latch on dict_foreign_key_check_lock.
@@ -92,9 +107,12 @@ dberr_t row_ins_clust_index_entry_low(
                          flags & (BTR_NO_LOCKING_FLAG
                          | BTR_NO_UNDO_LOG_FLAG) and a duplicate
                          can't occur */
-    bool dup_chk_only)
+    bool dup_chk_only,
     /*!< in: if true, just do duplicate check
     and return. don't execute actual insert. */
+    ins_leaf_hint_t *leaf_hint = nullptr)
+    /*!< in/out: leaf page of the previous insert
+    to try first, with BTR_MODIFY_LEAF, or nullptr */
     MY_ATTRIBUTE((warn_unused_result));
 
 /** Tries to insert an entry into a secondary index. If a record with exactly
@@ -143,9 +161,12 @@ dberr_t row_ins_clust_index_entry(
     dtuple_t *entry,     /*!< in/out: index entry to insert */
     que_thr_t *thr,      /*!< in: query thread */
     ulint n_ext,         /*!< in: number of externally stored columns */
-    bool dup_chk_only)
+    bool dup_chk_only,
     /*!< in: if true, just do duplicate check
     and return. don't execute actual insert. */
+    ins_leaf_hint_t *leaf_hint = nullptr)
+    /*!< in/out: leaf page of the previous insert
+    to try first, or nullptr */
     MY_ATTRIBUTE((warn_unused_result));
 /** Inserts an entry into a secondary index. Tries first optimistic,
  then pessimistic descent down the tree. If the entry matches enough
@@ -197,6 +218,13 @@ struct ins_node_t {
   the multi-value field, before which the values have been inserted */
   uint32_t ins_multi_val_pos;
 
+  /** true if the rows come in ascending order of the clustered index, so
+  that the leaf page of the previous row is tried before descending */
+  bool use_leaf_hint;
+
+  /** clustered index leaf page of the previous row, if use_leaf_hint */
+  ins_leaf_hint_t leaf_hint;
+
   ulint magic_n;
 };
 
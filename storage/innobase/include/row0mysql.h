@@ -889,6 +889,11 @@ struct row_prebuilt_t {
   table index tree. In this case, it could be split, but no shrink. */
   bool m_temp_tree_modified;
 
+  /** Whether the rows inserted come in ascending order of the clustered
+  index, as within a write_rows() batch, so that each insert tries the
+  leaf page of the previous one first */
+  bool ins_sorted_run;
+
   /** The MySQL table object */
   TABLE *m_mysql_table;
 
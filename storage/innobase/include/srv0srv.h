@@ -139,6 +139,10 @@ struct srv_stats_t {
 
   /** Number of rows inserted */
   ulint_ctr_64_t n_rows_inserted;
+
+  /** Number of foreign key checks which found their parent row in
+  trx_t::fk_checked instead of searching the parent index */
+  ulint_ctr_64_t n_fk_check_cache_hits;
 };
 
 /** Structure which keeps shared future objects for InnoDB background
@@ -177,9 +181,16 @@ struct Srv_threads {
   /** Buffer pool resize thread. */
   IB_thread m_buf_resize;
 
-  /** Dict stats background thread. */
+  /** Dict stats background thread (also being a worker). */
   IB_thread m_dict_stats;
 
+  /** Number of dict stats workers and size of array below. */
+  size_t m_dict_stats_workers_n;
+
+  /** Dict stats workers. Note that m_dict_stats_workers[0] is the
+  same shared state as m_dict_stats. */
+  IB_thread *m_dict_stats_workers;
+
   /** Thread detecting lock wait timeouts. */
   IB_thread m_lock_wait_timeout;
 
@@ -381,6 +392,9 @@ extern ulong srv_purge_rseg_truncate_frequency;
 /** Enable or Disable Truncate of UNDO tablespace. */
 extern bool srv_undo_log_truncate;
 
+/** Maximum number of UNDO tablespaces marked for truncate at the same time. */
+extern ulong srv_undo_log_truncate_spaces;
+
 /** Enable or disable Encrypt of UNDO tablespace. */
 extern bool srv_undo_log_encrypt;
 
@@ -564,6 +578,8 @@ extern ulong srv_n_page_hash_locks;
 extern ulong srv_LRU_scan_depth;
 /** Whether or not to flush neighbors of a block */
 extern ulong srv_flush_neighbors;
+/** Whether pages of temporary tablespaces are only written on eviction */
+extern bool srv_temp_flush_on_evict;
 /** Previously requested size. Accesses protected by memory barriers. */
 extern ulint srv_buf_pool_old_size;
 /** Current size as scaling factor for the other components */
@@ -578,6 +594,9 @@ extern ulint srv_lock_table_size;
 extern ulint srv_n_file_io_threads;
 extern bool srv_random_read_ahead;
 extern ulong srv_read_ahead_threshold;
+/** Maximum number of leaf pages a range scan reads ahead by following
+the node pointers of their parent page, 0 disables it */
+extern ulong srv_logical_read_ahead_pages;
 extern ulong srv_n_read_io_threads;
 extern ulong srv_n_write_io_threads;
 
@@ -613,6 +632,9 @@ extern ulint srv_max_n_open_files;
 
 extern ulong srv_n_page_cleaners;
 
+/** Number of background threads recalculating persistent statistics */
+extern ulong srv_n_stats_recalc_threads;
+
 extern double srv_max_dirty_pages_pct;
 extern double srv_max_dirty_pages_pct_lwm;
 
@@ -654,6 +676,10 @@ extern ulong srv_max_purge_lag;
 extern ulong srv_max_purge_lag_delay;
 
 extern ulong srv_replication_delay;
+
+/** Maximum number of foreign key checks remembered per statement, see
+trx_t::fk_checked; 0 disables it */
+extern ulong srv_fk_check_cache_size;
 /*-------------------------------------------*/
 
 extern bool srv_print_innodb_monitor;
@@ -1123,6 +1149,7 @@ struct export_var_t {
   ulint innodb_rows_inserted;             /*!< srv_n_rows_inserted */
   ulint innodb_rows_updated;              /*!< srv_n_rows_updated */
   ulint innodb_rows_deleted;              /*!< srv_n_rows_deleted */
+  ulint innodb_fk_check_cache_hits;       /*!< srv_n_fk_check_cache_hits */
   ulint innodb_num_open_files;            /*!< fil_n_file_opened */
   ulint innodb_truncated_status_writes;   /*!< srv_truncated_status_writes */
   ulint innodb_undo_tablespaces_total;    /*!< total number of undo tablespaces
@@ -458,6 +458,7 @@ enum latch_id_t {
   LATCH_ID_PARALLEL_READ,
   LATCH_ID_REDO_LOG_ARCHIVE_ADMIN_MUTEX,
   LATCH_ID_REDO_LOG_ARCHIVE_QUEUE_MUTEX,
+  LATCH_ID_BTR_RANGE_EST_CACHE,
   LATCH_ID_LIZARD_SCN,
   LATCH_ID_LIZARD_UNDO_HDR_HASH,
   LATCH_ID_LIZARD_VISION_LIST,
@@ -465,6 +466,7 @@ enum latch_id_t {
   LATCH_ID_GP_SYS,
   LATCH_ID_GP_SYS_WAIT,
   LATCH_ID_LIZARD_UNDO_RETENTION,
+  LATCH_ID_LIZARD_RW_TRX_HASH,
   /** Lizard mutex end */
   LATCH_ID_FILE_PURGE_LIST,
   LATCH_ID_TEST_MUTEX,
@@ -33,6 +33,8 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #ifndef trx0purge_h
 #define trx0purge_h
 
+#include <atomic>
+
 #include "fil0fil.h"
 #include "mtr0mtr.h"
 #include "page0page.h"
@@ -862,7 +864,9 @@ class Truncate {
       : m_space_id_marked(SPACE_UNKNOWN),
         m_purge_rseg_truncate_frequency(
             static_cast<ulint>(srv_purge_rseg_truncate_frequency)) {
-    /* Do Nothing. */
+    for (auto &pending : m_pending) {
+      pending.store(false, std::memory_order_relaxed);
+    }
   }
 
   /** Is tablespace selected for truncate.
@@ -905,6 +909,89 @@ class Truncate {
     return (id2num(m_space_id_marked));
   }
 
+  /** Mark one more tablespace for truncate while another one is being
+  emptied, so that both of them stop being used by new transactions and
+  are emptied by purge at the same time.  It is truncated after the one
+  currently marked, see promote().
+  @param[in]  undo_space  undo tablespace to truncate. */
+  void mark_pending(Tablespace *undo_space) {
+    space_id_t space_id;
+
+    undo_space->set_inactive_implicit(&space_id);
+
+    m_pending[undo_space->num()].store(true);
+
+    set_rseg_truncate_frequency(3);
+  }
+
+  /** Make a pending tablespace the one marked for truncate.
+  @param[in]  undo_space  undo tablespace marked by mark_pending(). */
+  void promote(Tablespace *undo_space) {
+    ut_ad(!is_marked());
+    ut_ad(is_pending(undo_space->num()));
+
+    m_space_id_marked = undo_space->id();
+    m_marked_space_is_empty = false;
+
+    m_pending[undo_space->num()].store(false);
+  }
+
+  /** Exchange the marked tablespace with a pending one which has been
+  emptied first.
+  @param[in]  undo_space  undo tablespace marked by mark_pending(). */
+  void swap_marked(Tablespace *undo_space) {
+    ut_ad(is_marked());
+    ut_ad(!is_marked_space_empty());
+
+    space_id_t space_num = get_marked_space_num();
+
+    m_pending[space_num].store(true);
+
+    m_space_id_marked = SPACE_UNKNOWN;
+
+    promote(undo_space);
+  }
+
+  /** Is the tablespace waiting for truncate after the marked one?
+  @param[in]  space_num  undo tablespace number
+  @return true if marked by mark_pending() */
+  bool is_pending(space_id_t space_num) const {
+    return (m_pending[space_num].load());
+  }
+
+  /** Is the tablespace marked for truncate, either as the one to
+  truncate next or as a pending one.
+  @param[in]  space_num  undo tablespace number
+  @return true if marked */
+  bool is_marked(space_id_t space_num) const {
+    return ((is_marked() && get_marked_space_num() == space_num) ||
+            is_pending(space_num));
+  }
+
+  /** Count the tablespaces marked for truncate.
+  @return number of marked and pending undo tablespaces */
+  ulint n_marked() const {
+    ulint n = (is_marked() ? 1 : 0);
+
+    for (auto &pending : m_pending) {
+      n += (pending.load() ? 1 : 0);
+    }
+
+    return (n);
+  }
+
+  /** Done with the marked tablespace, the pending ones if any
+  are left for the next rseg truncate. */
+  void reset_marked() {
+    m_marked_space_is_empty = false;
+    m_space_id_marked = SPACE_UNKNOWN;
+
+    if (n_marked() == 0) {
+      set_rseg_truncate_frequency(
+          static_cast<ulint>(srv_purge_rseg_truncate_frequency));
+    }
+  }
+
   /** Reset for next rseg truncate. */
   void reset() {
     /* Sync with global value as we are done with
@@ -914,6 +1001,10 @@ class Truncate {
 
     m_marked_space_is_empty = false;
     m_space_id_marked = SPACE_UNKNOWN;
+
+    for (auto &pending : m_pending) {
+      pending.store(false);
+    }
   }
 
   /** Get the undo tablespace number to start a scan.
@@ -961,6 +1052,10 @@ class Truncate {
   code to do the check for undo logs only once. */
   bool m_marked_space_is_empty;
 
+  /** UNDO space numbers marked for truncate after m_space_id_marked.
+  Set by the purge coordinator, read by ALTER UNDO TABLESPACE. */
+  std::atomic<bool> m_pending[FSP_MAX_UNDO_TABLESPACES + 1];
+
   /** Rollback segment(s) purge frequency. This is a local
   value maintained along with the global value. It is set
   to the global value in the before each truncate.  But when
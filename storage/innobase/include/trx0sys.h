@@ -193,10 +193,9 @@ Please note, that positive result means only that the trx was active
 at some moment during the call, but it might have already become
 TRX_STATE_COMMITTED_IN_MEMORY before the call returns to the caller, as this
 transition is protected by trx->mutex and trx_sys->mutex, but it is impossible
-for the caller to hold any of these mutexes when calling this function as the
-function itself internally acquires trx_sys->mutex which would cause recurrent
-mutex acquisition if caller already had trx_sys->mutex, or latching order
-violation in case of holding trx->mutex.
+for the caller to hold trx->mutex when calling this function as the function
+itself internally acquires it. The lookup only latches the rw_trx_hash
+partition of trx_id, trx_sys->mutex is not acquired.
 @param[in]	trx_id		trx id of the transaction
 @param[in]	corrupt		NULL or pointer to a flag that will be set if
                                 corrupt
@@ -34,6 +34,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #define trx0trx_h
 
 #include <set>
+#include <string>
 
 #include "ha_prototypes.h"
 
@@ -730,6 +731,20 @@ typedef std::set<dict_table_t *, std::less<dict_table_t *>,
                  ut_allocator<dict_table_t *>>
     trx_mod_tables_t;
 
+/** Key of a foreign key check that succeeded: the address of the
+dict_foreign_t followed by the length and the bytes of each foreign key
+column of the child index entry. */
+typedef std::basic_string<char, std::char_traits<char>, ut_allocator<char>>
+    trx_fk_key_t;
+
+/** Type used to store the foreign key checks which already found their
+parent row in the current statement. The parent row stays S-locked at least
+until the statement ends, so the same check need not search the parent
+index again. */
+typedef std::set<trx_fk_key_t, std::less<trx_fk_key_t>,
+                 ut_allocator<trx_fk_key_t>>
+    trx_fk_checked_t;
+
 /** The transaction handle
 
 Normally, there is a 1:1 relationship between a transaction handle
@@ -1212,6 +1227,10 @@ struct trx_t {
                                transaction branch */
   trx_mod_tables_t mod_tables; /*!< List of tables that were modified
                                by this transaction */
+  trx_fk_checked_t fk_checked; /*!< Foreign key checks that found
+                               their parent row in the current
+                               statement, see
+                               row_ins_check_foreign_constraint() */
 #endif                         /* !UNIV_HOTBACKUP */
                                /*------------------------------*/
   bool api_trx;                /*!< trx started by InnoDB API */
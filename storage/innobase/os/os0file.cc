@@ -8525,6 +8525,114 @@ bool Encryption::decode_encryption_info(byte *key, byte *iv,
   return (true);
 }
 
+/** AES contexts of this thread for encrypting and decrypting pages and redo
+log blocks. my_aes_encrypt() and my_aes_decrypt() expand the key on each call,
+which costs about as much as encrypting a redo log block, so the contexts of
+the tablespaces this thread used last are kept with their expanded keys. */
+class Encryption_ctx_cache {
+ public:
+  Encryption_ctx_cache() : m_clock(0) {
+    memset(m_entries, 0x0, sizeof(m_entries));
+  }
+
+  ~Encryption_ctx_cache() {
+    for (auto &entry : m_entries) {
+      evict(&entry);
+    }
+  }
+
+  /** Get the context of a key, create it if it isn't cached yet.
+  @param[in]	key		encryption key, ENCRYPTION_KEY_LEN bytes
+  @param[in]	encrypt		true to encrypt, false to decrypt
+  @return the context, or nullptr if it can't be created */
+  my_aes_ctx *get(const byte *key, bool encrypt) {
+    Entry *victim = &m_entries[0];
+
+    for (auto &entry : m_entries) {
+      if (entry.m_ctx != nullptr && entry.m_encrypt == encrypt &&
+          memcmp(entry.m_key, key, ENCRYPTION_KEY_LEN) == 0) {
+        entry.m_last_used = ++m_clock;
+        return (entry.m_ctx);
+      }
+
+      if (entry.m_last_used < victim->m_last_used) {
+        victim = &entry;
+      }
+    }
+
+    evict(victim);
+
+    victim->m_ctx = my_aes_ctx_create(key, ENCRYPTION_KEY_LEN, my_aes_256_cbc,
+                                      encrypt, false);
+
+    if (victim->m_ctx != nullptr) {
+      victim->m_encrypt = encrypt;
+      victim->m_last_used = ++m_clock;
+      memcpy(victim->m_key, key, ENCRYPTION_KEY_LEN);
+    }
+
+    return (victim->m_ctx);
+  }
+
+ private:
+  /** Number of contexts kept by a thread */
+  static const ulint N_ENTRIES = 8;
+
+  struct Entry {
+    /** The context, nullptr if the entry is free */
+    my_aes_ctx *m_ctx;
+
+    /** Whether the context encrypts or decrypts */
+    bool m_encrypt;
+
+    /** Value of m_clock when the context was used last */
+    ulint m_last_used;
+
+    /** Key of the context */
+    byte m_key[ENCRYPTION_KEY_LEN];
+  };
+
+  /** Free the context of an entry and wipe its key.
+  @param[in,out]	entry	entry to free */
+  static void evict(Entry *entry) {
+    my_aes_ctx_free(entry->m_ctx);
+
+    memset(entry, 0x0, sizeof(*entry));
+  }
+
+  Entry m_entries[N_ENTRIES];
+
+  /** Incremented on each use of a context */
+  ulint m_clock;
+};
+
+/** AES contexts of this thread, see Encryption::aes_crypt() */
+static thread_local Encryption_ctx_cache encryption_ctx_cache;
+
+int Encryption::aes_crypt(bool encrypt, const byte *src, ulint src_len,
+                          byte *dst) const {
+  ut_ad(m_klen == ENCRYPTION_KEY_LEN);
+  ut_ad(src_len % MY_AES_BLOCK_SIZE == 0);
+
+  my_aes_ctx *ctx = encryption_ctx_cache.get(m_key, encrypt);
+
+  if (ctx != nullptr) {
+    return (my_aes_ctx_crypt(ctx, src, static_cast<uint32>(src_len), dst,
+                             m_iv));
+  }
+
+  /* Fall back to expanding the key for this call only */
+  if (encrypt) {
+    return (my_aes_encrypt(src, static_cast<uint32>(src_len), dst, m_key,
+                           static_cast<uint32>(m_klen), my_aes_256_cbc, m_iv,
+                           false));
+  }
+
+  return (my_aes_decrypt(src, static_cast<uint32>(src_len), dst, m_key,
+                         static_cast<uint32>(m_klen), my_aes_256_cbc, m_iv,
+                         false));
+}
+
 /** Check if page is encrypted page or not
 @param[in]	page	page which need to check
 @return true if it is a encrypted page */
@@ -8585,11 +8693,8 @@ bool Encryption::encrypt_log_block(const IORequest &type, byte *src_ptr,
     case Encryption::AES: {
       ut_ad(m_klen == ENCRYPTION_KEY_LEN);
 
-      auto elen = my_aes_encrypt(
-          src_ptr + LOG_BLOCK_HDR_SIZE, static_cast<uint32>(main_len),
-          dst_ptr + LOG_BLOCK_HDR_SIZE,
-          reinterpret_cast<unsigned char *>(m_key), static_cast<uint32>(m_klen),
-          my_aes_256_cbc, reinterpret_cast<unsigned char *>(m_iv), false);
+      auto elen = aes_crypt(true, src_ptr + LOG_BLOCK_HDR_SIZE, main_len,
+                            dst_ptr + LOG_BLOCK_HDR_SIZE);
 
       if (elen == MY_AES_BAD_DATA) {
         return (false);
@@ -8611,12 +8716,9 @@ bool Encryption::encrypt_log_block(const IORequest &type, byte *src_ptr,
       if (remain_len != 0) {
         remain_len = MY_AES_BLOCK_SIZE * 2;
 
-        elen =
-            my_aes_encrypt(dst_ptr + LOG_BLOCK_HDR_SIZE + data_len - remain_len,
-                           static_cast<uint32>(remain_len), remain_buf,
-                           reinterpret_cast<unsigned char *>(m_key),
-                           static_cast<uint32>(m_klen), my_aes_256_cbc,
-                           reinterpret_cast<unsigned char *>(m_iv), false);
+        elen = aes_crypt(true,
+                         dst_ptr + LOG_BLOCK_HDR_SIZE + data_len - remain_len,
+                         remain_len, remain_buf);
 
         if (elen == MY_AES_BAD_DATA) {
           return (false);
@@ -8764,11 +8866,8 @@ byte *Encryption::encrypt(const IORequest &type, byte *src, ulint src_len,
 
       ut_ad(m_klen == ENCRYPTION_KEY_LEN);
 
-      elen = my_aes_encrypt(src + FIL_PAGE_DATA, static_cast<uint32>(main_len),
-                            dst + FIL_PAGE_DATA,
-                            reinterpret_cast<unsigned char *>(m_key),
-                            static_cast<uint32>(m_klen), my_aes_256_cbc,
-                            reinterpret_cast<unsigned char *>(m_iv), false);
+      elen =
+          aes_crypt(true, src + FIL_PAGE_DATA, main_len, dst + FIL_PAGE_DATA);
 
       if (elen == MY_AES_BAD_DATA) {
         ulint page_no = mach_read_from_4(src + FIL_PAGE_OFFSET);
@@ -8792,11 +8891,8 @@ byte *Encryption::encrypt(const IORequest &type, byte *src, ulint src_len,
       if (remain_len != 0) {
         remain_len = MY_AES_BLOCK_SIZE * 2;
 
-        elen = my_aes_encrypt(dst + FIL_PAGE_DATA + data_len - remain_len,
-                              static_cast<uint32>(remain_len), remain_buf,
-                              reinterpret_cast<unsigned char *>(m_key),
-                              static_cast<uint32>(m_klen), my_aes_256_cbc,
-                              reinterpret_cast<unsigned char *>(m_iv), false);
+        elen = aes_crypt(true, dst + FIL_PAGE_DATA + data_len - remain_len,
+                         remain_len, remain_buf);
 
         if (elen == MY_AES_BAD_DATA) {
           ulint page_no = mach_read_from_4(src + FIL_PAGE_OFFSET);
@@ -8900,11 +8996,8 @@ dberr_t Encryption::decrypt_log_block(const IORequest &type, byte *src,
         /* Copy the last 2 blocks. */
         memcpy(remain_buf, ptr + data_len - remain_len, remain_len);
 
-        elen = my_aes_decrypt(remain_buf, static_cast<uint32>(remain_len),
-                              dst + data_len - remain_len,
-                              reinterpret_cast<unsigned char *>(m_key),
-                              static_cast<uint32>(m_klen), my_aes_256_cbc,
-                              reinterpret_cast<unsigned char *>(m_iv), false);
+        elen = aes_crypt(false, remain_buf, remain_len,
+                         dst + data_len - remain_len);
         if (elen == MY_AES_BAD_DATA) {
           return (DB_IO_DECRYPT_FAIL);
         }
@@ -8919,10 +9012,7 @@ dberr_t Encryption::decrypt_log_block(const IORequest &type, byte *src,
       }
 
       /* Then decrypt the main data */
-      elen = my_aes_decrypt(dst, static_cast<uint32>(main_len), ptr,
-                            reinterpret_cast<unsigned char *>(m_key),
-                            static_cast<uint32>(m_klen), my_aes_256_cbc,
-                            reinterpret_cast<unsigned char *>(m_iv), false);
+      elen = aes_crypt(false, dst, main_len, ptr);
       if (elen == MY_AES_BAD_DATA) {
         return (DB_IO_DECRYPT_FAIL);
       }
@@ -9107,11 +9197,8 @@ dberr_t Encryption::decrypt(const IORequest &type, byte *src, ulint src_len,
         /* Copy the last 2 blocks. */
         memcpy(remain_buf, ptr + data_len - remain_len, remain_len);
 
-        elen = my_aes_decrypt(remain_buf, static_cast<uint32>(remain_len),
-                              dst + data_len - remain_len,
-                              reinterpret_cast<unsigned char *>(m_key),
-                              static_cast<uint32>(m_klen), my_aes_256_cbc,
-                              reinterpret_cast<unsigned char *>(m_iv), false);
+        elen = aes_crypt(false, remain_buf, remain_len,
+                         dst + data_len - remain_len);
         if (elen == MY_AES_BAD_DATA) {
           if (block != NULL) {
             os_free_block(block);
@@ -9130,10 +9217,7 @@ dberr_t Encryption::decrypt(const IORequest &type, byte *src, ulint src_len,
       }
 
       /* Then decrypt the main data */
-      elen = my_aes_decrypt(dst, static_cast<uint32>(main_len), ptr,
-                            reinterpret_cast<unsigned char *>(m_key),
-                            static_cast<uint32>(m_klen), my_aes_256_cbc,
-                            reinterpret_cast<unsigned char *>(m_iv), false);
+      elen = aes_crypt(false, dst, main_len, ptr);
       if (elen == MY_AES_BAD_DATA) {
         if (block != NULL) {
           os_free_block(block);
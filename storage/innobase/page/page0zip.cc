@@ -90,6 +90,10 @@ uint page_zip_level = DEFAULT_COMPRESSION_LEVEL;
 compression algorithm changes in zlib. */
 bool page_zip_log_pages = true;
 
+/* Whether or not to keep the zlib deflate stream of page_zip_compress()
+in the thread and reset it for the next page. Settable by user. */
+bool page_zip_reuse_deflate_stream = false;
+
 /* Please refer to ../include/page0zip.ic for a description of the
 compressed page format. */
 
@@ -933,6 +937,45 @@ func_exit:
   return (err);
 }
 
+/** Get the stream ready for compressing a new page.
+@param[in]	level	compression level
+@return the stream */
+z_stream *Page_zip_deflate_stream::open(ulint level) {
+  int err;
+
+  if (m_inited && m_level == level) {
+    err = deflateReset(&m_stream);
+    ut_a(err == Z_OK);
+    return (&m_stream);
+  }
+
+  close();
+
+  m_stream.zalloc = Z_NULL;
+  m_stream.zfree = Z_NULL;
+  m_stream.opaque = Z_NULL;
+
+  err = deflateInit2(&m_stream, static_cast<int>(level), Z_DEFLATED,
+                     UNIV_PAGE_SIZE_SHIFT, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+  ut_a(err == Z_OK);
+
+  m_inited = true;
+  m_level = level;
+
+  return (&m_stream);
+}
+
+/** Release the buffers of the stream. */
+void Page_zip_deflate_stream::close() {
+  if (m_inited) {
+    deflateEnd(&m_stream);
+    m_inited = false;
+  }
+}
+
+/** Deflate stream of this thread, see page_zip_reuse_deflate_stream */
+static thread_local Page_zip_deflate_stream page_zip_deflate_stream;
+
 /** Compress a page.
  @return true on success, false on failure; page_zip will be left
  intact on failure. */
@@ -945,7 +988,8 @@ ibool page_zip_compress(page_zip_des_t *page_zip, /*!< in: size; out: data,
                         mtr_t *mtr)               /*!< in/out: mini-transaction,
                                                   or NULL */
 {
-  z_stream c_stream;
+  z_stream local_stream;
+  z_stream *c_stream = &local_stream;
   int err;
   ulint n_fields; /* number of index fields
                   needed */
@@ -1055,10 +1099,20 @@ ibool page_zip_compress(page_zip_des_t *page_zip, /*!< in: size; out: data,
 
   MONITOR_INC(MONITOR_PAGE_COMPRESS);
 
-  heap = mem_heap_create(page_zip_get_size(page_zip) +
-                         n_fields * (2 + sizeof(ulint)) + REC_OFFS_HEADER_SIZE +
-                         n_dense * ((sizeof *recs) - PAGE_ZIP_DIR_SLOT_SIZE) +
-                         UNIV_PAGE_SIZE * 4 + (512 << MAX_MEM_LEVEL));
+  {
+    /* A local copy, the variable can be changed at anytime. */
+    const bool reuse_stream = page_zip_reuse_deflate_stream;
+
+    heap = mem_heap_create(
+        page_zip_get_size(page_zip) + n_fields * (2 + sizeof(ulint)) +
+        REC_OFFS_HEADER_SIZE +
+        n_dense * ((sizeof *recs) - PAGE_ZIP_DIR_SLOT_SIZE) +
+        (reuse_stream ? 0 : UNIV_PAGE_SIZE * 4 + (512 << MAX_MEM_LEVEL)));
+
+    if (reuse_stream) {
+      c_stream = page_zip_deflate_stream.open(level);
+    }
+  }
 
   recs = static_cast<const rec_t **>(
       mem_heap_zalloc(heap, n_dense * sizeof *recs));
@@ -1071,17 +1125,19 @@ ibool page_zip_compress(page_zip_des_t *page_zip, /*!< in: size; out: data,
   buf_end = buf + page_zip_get_size(page_zip) - PAGE_DATA;
 
   /* Compress the data payload. */
-  page_zip_set_alloc(&c_stream, heap);
+  if (c_stream == &local_stream) {
+    page_zip_set_alloc(c_stream, heap);
 
-  err = deflateInit2(&c_stream, static_cast<int>(level), Z_DEFLATED,
-                     UNIV_PAGE_SIZE_SHIFT, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY);
-  ut_a(err == Z_OK);
+    err = deflateInit2(c_stream, static_cast<int>(level), Z_DEFLATED,
+                       UNIV_PAGE_SIZE_SHIFT, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY);
+    ut_a(err == Z_OK);
+  }
 
-  c_stream.next_out = buf;
+  c_stream->next_out = buf;
 
   /* Subtract the space reserved for uncompressed data. */
   /* Page header and the end marker of the modification log */
-  c_stream.avail_out = static_cast<uInt>(buf_end - buf - 1);
+  c_stream->avail_out = static_cast<uInt>(buf_end - buf - 1);
 
   /* Dense page directory and uncompressed columns, if any */
   if (page_is_leaf(page)) {
@@ -1104,32 +1160,32 @@ ibool page_zip_compress(page_zip_des_t *page_zip, /*!< in: size; out: data,
     trx_id_col = ULINT_UNDEFINED;
   }
 
-  if (UNIV_UNLIKELY(c_stream.avail_out <=
+  if (UNIV_UNLIKELY(c_stream->avail_out <=
                     n_dense * slot_size +
                         6 /* sizeof(zlib header and footer) */)) {
     goto zlib_error;
   }
 
-  c_stream.avail_out -= static_cast<uInt>(n_dense * slot_size);
-  c_stream.avail_in = static_cast<uInt>(
+  c_stream->avail_out -= static_cast<uInt>(n_dense * slot_size);
+  c_stream->avail_in = static_cast<uInt>(
       page_zip_fields_encode(n_fields, index, trx_id_col, fields));
-  c_stream.next_in = fields;
+  c_stream->next_in = fields;
 
   if (UNIV_LIKELY(!trx_id_col)) {
     trx_id_col = ULINT_UNDEFINED;
   }
 
-  UNIV_MEM_ASSERT_RW(c_stream.next_in, c_stream.avail_in);
-  err = deflate(&c_stream, Z_FULL_FLUSH);
+  UNIV_MEM_ASSERT_RW(c_stream->next_in, c_stream->avail_in);
+  err = deflate(c_stream, Z_FULL_FLUSH);
   if (err != Z_OK) {
     goto zlib_error;
   }
 
-  ut_ad(!c_stream.avail_in);
+  ut_ad(!c_stream->avail_in);
 
   page_zip_dir_encode(page, buf_end, recs);
 
-  c_stream.next_in = (byte *)page + PAGE_ZIP_START;
+  c_stream->next_in = (byte *)page + PAGE_ZIP_START;
 
   storage = buf_end - n_dense * PAGE_ZIP_DIR_SLOT_SIZE;
 
@@ -1137,21 +1193,21 @@ ibool page_zip_compress(page_zip_des_t *page_zip, /*!< in: size; out: data,
   if (UNIV_UNLIKELY(!n_dense)) {
   } else if (!page_is_leaf(page)) {
     /* This is a node pointer page. */
-    err = page_zip_compress_node_ptrs(LOGFILE & c_stream, recs, n_dense, index,
+    err = page_zip_compress_node_ptrs(LOGFILE c_stream, recs, n_dense, index,
                                       storage, heap);
     if (UNIV_UNLIKELY(err != Z_OK)) {
       goto zlib_error;
     }
   } else if (UNIV_LIKELY(trx_id_col == ULINT_UNDEFINED)) {
     /* This is a leaf page in a secondary index. */
-    err = page_zip_compress_sec(LOGFILE & c_stream, recs, n_dense);
+    err = page_zip_compress_sec(LOGFILE c_stream, recs, n_dense);
     if (UNIV_UNLIKELY(err != Z_OK)) {
       goto zlib_error;
     }
   } else {
     /* This is a leaf page in a clustered index. */
     err = page_zip_compress_clust(
-        LOGFILE & c_stream, recs, n_dense, index, &n_blobs, trx_id_col,
+        LOGFILE c_stream, recs, n_dense, index, &n_blobs, trx_id_col,
         buf_end - PAGE_ZIP_DIR_SLOT_SIZE * page_get_n_recs(page), storage,
         heap);
     if (UNIV_UNLIKELY(err != Z_OK)) {
@@ -1160,20 +1216,23 @@ ibool page_zip_compress(page_zip_des_t *page_zip, /*!< in: size; out: data,
   }
 
   /* Finish the compression. */
-  ut_ad(!c_stream.avail_in);
+  ut_ad(!c_stream->avail_in);
   /* Compress any trailing garbage, in case the last record was
   allocated from an originally longer space on the free list,
   or the data of the last record from page_zip_compress_sec(). */
-  c_stream.avail_in = static_cast<uInt>(
-      page_header_get_field(page, PAGE_HEAP_TOP) - (c_stream.next_in - page));
-  ut_a(c_stream.avail_in <= UNIV_PAGE_SIZE - PAGE_ZIP_START - PAGE_DIR);
+  c_stream->avail_in = static_cast<uInt>(
+      page_header_get_field(page, PAGE_HEAP_TOP) - (c_stream->next_in - page));
+  ut_a(c_stream->avail_in <= UNIV_PAGE_SIZE - PAGE_ZIP_START - PAGE_DIR);
 
-  UNIV_MEM_ASSERT_RW(c_stream.next_in, c_stream.avail_in);
-  err = deflate(&c_stream, Z_FINISH);
+  UNIV_MEM_ASSERT_RW(c_stream->next_in, c_stream->avail_in);
+  err = deflate(c_stream, Z_FINISH);
 
   if (UNIV_UNLIKELY(err != Z_STREAM_END)) {
   zlib_error:
-    deflateEnd(&c_stream);
+    /* A kept stream is reset by the next page_zip_compress(). */
+    if (c_stream == &local_stream) {
+      deflateEnd(c_stream);
+    }
     mem_heap_free(heap);
   err_exit:
 #ifdef PAGE_ZIP_COMPRESS_DBG
@@ -1197,25 +1256,27 @@ ibool page_zip_compress(page_zip_des_t *page_zip, /*!< in: size; out: data,
     return (FALSE);
   }
 
-  err = deflateEnd(&c_stream);
-  ut_a(err == Z_OK);
+  if (c_stream == &local_stream) {
+    err = deflateEnd(c_stream);
+    ut_a(err == Z_OK);
+  }
 
-  ut_ad(buf + c_stream.total_out == c_stream.next_out);
-  ut_ad((ulint)(storage - c_stream.next_out) >= c_stream.avail_out);
+  ut_ad(buf + c_stream->total_out == c_stream->next_out);
+  ut_ad((ulint)(storage - c_stream->next_out) >= c_stream->avail_out);
 
   /* Valgrind believes that zlib does not initialize some bits
   in the last 7 or 8 bytes of the stream.  Make Valgrind happy. */
-  UNIV_MEM_VALID(buf, c_stream.total_out);
+  UNIV_MEM_VALID(buf, c_stream->total_out);
 
   /* Zero out the area reserved for the modification log.
   Space for the end marker of the modification log is not
   included in avail_out. */
-  memset(c_stream.next_out, 0, c_stream.avail_out + 1 /* end marker */);
+  memset(c_stream->next_out, 0, c_stream->avail_out + 1 /* end marker */);
 
 #ifdef UNIV_DEBUG
   page_zip->m_start =
 #endif /* UNIV_DEBUG */
-      page_zip->m_end = PAGE_DATA + c_stream.total_out;
+      page_zip->m_end = PAGE_DATA + c_stream->total_out;
   page_zip->m_nonempty = FALSE;
   page_zip->n_blobs = n_blobs;
   /* Copy those header fields that will not be written
@@ -1245,7 +1306,7 @@ ibool page_zip_compress(page_zip_des_t *page_zip, /*!< in: size; out: data,
   if (logfile) {
     /* Record the compressed size of the block. */
     byte sz[4];
-    mach_write_to_4(sz, c_stream.total_out);
+    mach_write_to_4(sz, c_stream->total_out);
     fseek(logfile, UNIV_PAGE_SIZE, SEEK_SET);
     if (fwrite(sz, 1, sizeof sz, logfile) != sizeof sz) {
       perror("fwrite");
@@ -107,6 +107,9 @@ ins_node_t *ins_node_create(
 
   node->ins_multi_val_pos = 0;
 
+  node->use_leaf_hint = false;
+  node->leaf_hint.reset();
+
   return (node);
 }
 
@@ -1333,6 +1336,55 @@ static dberr_t row_ins_set_rec_lock(lock_mode mode, ulint type,
   return (err);
 }
 
+/** Builds the key under which a foreign key check of a child index entry is
+remembered in trx_t::fk_checked.
+@param[in]	foreign	foreign key constraint
+@param[in]	entry	child index entry
+@param[out]	key	the key */
+static void row_ins_foreign_checked_key(const dict_foreign_t *foreign,
+                                        const dtuple_t *entry,
+                                        trx_fk_key_t &key) {
+  key.assign(reinterpret_cast<const char *>(&foreign), sizeof(foreign));
+
+  for (ulint i = 0; i < foreign->n_fields; i++) {
+    const dfield_t *field = dtuple_get_nth_field(entry, i);
+    byte len[4];
+
+    mach_write_to_4(len, dfield_get_len(field));
+    key.append(reinterpret_cast<const char *>(len), sizeof(len));
+    key.append(static_cast<const char *>(dfield_get_data(field)),
+               dfield_get_len(field));
+  }
+}
+
+/** Checks if the parent row of a child index entry was already found by the
+current statement. Bulk inserts and updates of child rows often refer to the
+same few parent rows, the check then need not search and lock the parent
+index again: the S lock set by the first check is held at least until the
+end of the statement.
+@param[in]	trx	transaction
+@param[in]	foreign	foreign key constraint
+@param[in]	entry	child index entry
+@param[out]	key	key of the check, to remember it if it is not found
+@return true if the parent row was already found */
+static bool row_ins_foreign_is_checked(trx_t *trx,
+                                       const dict_foreign_t *foreign,
+                                       const dtuple_t *entry,
+                                       trx_fk_key_t &key) {
+  if (srv_fk_check_cache_size == 0) {
+    return (false);
+  }
+
+  row_ins_foreign_checked_key(foreign, entry, key);
+
+  if (trx->fk_checked.find(key) != trx->fk_checked.end()) {
+    srv_stats.n_fk_check_cache_hits.inc();
+    return (true);
+  }
+
+  return (false);
+}
+
 /* Decrement a counter in the destructor. */
 class ib_dec_in_dtor {
  public:
@@ -1377,6 +1429,7 @@ dberr_t row_ins_check_foreign_constraint(
   THD *thd = current_thd;
   bool tmp_open = false;
   dict_foreign_t *tmp_foreign = nullptr;
+  trx_fk_key_t checked_key;
 
   /* GAP locks are not needed on DD tables because serializability between
   different DDL statements is achieved using metadata locks. So no concurrent
@@ -1409,6 +1462,11 @@ dberr_t row_ins_check_foreign_constraint(
     }
   }
 
+  if (check_ref &&
+      row_ins_foreign_is_checked(trx, foreign, entry, checked_key)) {
+    goto exit_func;
+  }
+
   if (que_node_get_type(thr->run_node) == QUE_NODE_UPDATE) {
     upd_node = static_cast<upd_node_t *>(thr->run_node);
 
@@ -1676,6 +1734,11 @@ end_scan:
   /* Restore old value */
   dtuple_set_n_fields_cmp(entry, n_fields_cmp);
 
+  if (check_ref && err == DB_SUCCESS && !checked_key.empty() &&
+      trx->fk_checked.size() < srv_fk_check_cache_size) {
+    trx->fk_checked.insert(checked_key);
+  }
+
 do_possible_lock_wait:
   if (err == DB_LOCK_WAIT) {
     /* An object that will correctly decrement the FK check counter
@@ -2346,9 +2409,12 @@ dberr_t row_ins_clust_index_entry_low(
                          flags & (BTR_NO_LOCKING_FLAG
                          | BTR_NO_UNDO_LOG_FLAG) and a duplicate
                          can't occur */
-    bool dup_chk_only)
-/*!< in: if true, just do duplicate check
-and return. don't execute actual insert. */
+    bool dup_chk_only,
+    /*!< in: if true, just do duplicate check
+    and return. don't execute actual insert. */
+    ins_leaf_hint_t *leaf_hint)
+/*!< in/out: leaf page of the previous insert
+to try first, with BTR_MODIFY_LEAF, or nullptr */
 {
   btr_pcur_t pcur;
   btr_cur_t *cursor;
@@ -2411,11 +2477,31 @@ and return. don't execute actual insert. */
 
   /* Note that we use PAGE_CUR_LE as the search mode, because then
   the function will return in both low_match and up_match of the
-  cursor sensible values */
-  btr_pcur_open(index, entry, PAGE_CUR_LE, mode, &pcur, &mtr);
+  cursor sensible values. Rows of a sorted run mostly go to the leaf
+  page of the previous row, so try it before descending the tree. */
+  if (leaf_hint == nullptr || mode != BTR_MODIFY_LEAF ||
+      leaf_hint->block == nullptr ||
+      buf_pool_is_obsolete(leaf_hint->withdraw_clock) ||
+      !pcur.open_on_leaf_hint(index, entry, leaf_hint->block,
+                              leaf_hint->modify_clock, &mtr, __FILE__,
+                              __LINE__)) {
+    btr_pcur_open(index, entry, PAGE_CUR_LE, mode, &pcur, &mtr);
+  }
   cursor = btr_pcur_get_btr_cur(&pcur);
   cursor->thr = thr;
 
+  if (leaf_hint != nullptr) {
+    if (mode == BTR_MODIFY_LEAF) {
+      buf_block_t *block = btr_cur_get_block(cursor);
+
+      leaf_hint->block = block;
+      leaf_hint->modify_clock = buf_block_get_modify_clock(block);
+      leaf_hint->withdraw_clock = buf_withdraw_clock;
+    } else {
+      leaf_hint->reset();
+    }
+  }
+
   ut_ad(!index->table->is_intrinsic() ||
         cursor->page_cur.block->made_dirty_with_no_latch);
 
@@ -3071,9 +3157,12 @@ dberr_t row_ins_clust_index_entry(
     dtuple_t *entry,     /*!< in/out: index entry to insert */
     que_thr_t *thr,      /*!< in: query thread */
     ulint n_ext,         /*!< in: number of externally stored columns */
-    bool dup_chk_only)
-/*!< in: if true, just do duplicate check
-and return. don't execute actual insert. */
+    bool dup_chk_only,
+    /*!< in: if true, just do duplicate check
+    and return. don't execute actual insert. */
+    ins_leaf_hint_t *leaf_hint)
+/*!< in/out: leaf page of the previous insert
+to try first, or nullptr */
 {
   dberr_t err;
   ulint n_uniq;
@@ -3118,8 +3207,9 @@ and return. don't execute actual insert. */
     err = row_ins_sorted_clust_index_entry(BTR_MODIFY_LEAF, index, entry, n_ext,
                                            thr);
   } else {
-    err = row_ins_clust_index_entry_low(flags, BTR_MODIFY_LEAF, index, n_uniq,
-                                        entry, n_ext, thr, dup_chk_only);
+    err = row_ins_clust_index_entry_low(
+        flags, BTR_MODIFY_LEAF, index, n_uniq, entry, n_ext, thr, dup_chk_only,
+        index->table->is_intrinsic() ? nullptr : leaf_hint);
   }
 
   DEBUG_SYNC_C_IF_THD(thr_get_trx(thr)->mysql_thd,
@@ -3145,7 +3235,8 @@ and return. don't execute actual insert. */
                                            thr);
   } else {
     err = row_ins_clust_index_entry_low(flags, BTR_MODIFY_TREE, index, n_uniq,
-                                        entry, n_ext, thr, dup_chk_only);
+                                        entry, n_ext, thr, dup_chk_only,
+                                        leaf_hint);
   }
 
   return err;
@@ -3302,9 +3393,12 @@ record.
                                 a bit ambiguous, however the return error
                                 can help to see which case it is
 @param[in]	thr		query thread
+@param[in,out]	leaf_hint	clustered index leaf page of the previous row
+                                to try first, or nullptr
 @return DB_SUCCESS, DB_LOCK_WAIT, DB_DUPLICATE_KEY, or some other error code */
 static dberr_t row_ins_index_entry(dict_index_t *index, dtuple_t *entry,
-                                   uint32_t &multi_val_pos, que_thr_t *thr) {
+                                   uint32_t &multi_val_pos, que_thr_t *thr,
+                                   ins_leaf_hint_t *leaf_hint) {
   ut_ad(thr_get_trx(thr)->id != 0);
 
   DBUG_EXECUTE_IF("row_ins_index_entry_timeout", {
@@ -3313,7 +3407,7 @@ static dberr_t row_ins_index_entry(dict_index_t *index, dtuple_t *entry,
   });
 
   if (index->is_clustered()) {
-    return (row_ins_clust_index_entry(index, entry, thr, 0, false));
+    return (row_ins_clust_index_entry(index, entry, thr, 0, false, leaf_hint));
   } else if (index->is_multi_value()) {
     return (
         row_ins_sec_index_multi_value_entry(index, entry, multi_val_pos, thr));
@@ -3455,7 +3549,8 @@ static MY_ATTRIBUTE((warn_unused_result)) dberr_t
   ut_ad(dtuple_check_typed(node->entry));
 
   err = row_ins_index_entry(node->index, node->entry, node->ins_multi_val_pos,
-                            thr);
+                            thr,
+                            node->use_leaf_hint ? &node->leaf_hint : nullptr);
 
   DEBUG_SYNC_C_IF_THD(thr_get_trx(thr)->mysql_thd,
                       "after_row_ins_index_entry_step");
@@ -963,6 +963,7 @@ Max size Secondary index: 16 * 8 bytes + PK = 256 bytes. */
 
   prebuilt->m_no_prefetch = false;
   prebuilt->m_read_virtual_key = false;
+  prebuilt->ins_sorted_run = false;
 
   prebuilt->m_asof_query.reset();
 
@@ -1617,6 +1618,11 @@ static dberr_t row_insert_for_mysql_using_ins_graph(const byte *mysql_rec,
   row_get_prebuilt_insert_row(prebuilt);
   node = prebuilt->ins_node;
 
+  node->use_leaf_hint = prebuilt->ins_sorted_run;
+  if (!node->use_leaf_hint) {
+    node->leaf_hint.reset();
+  }
+
   row_mysql_convert_row_to_innobase(node->row, prebuilt, mysql_rec, &blob_heap);
 
   savept = trx_savept_take(trx);
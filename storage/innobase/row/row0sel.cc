@@ -4964,6 +4964,10 @@ dberr_t row_search_mvcc(byte *buf, page_cur_mode_t mode,
       }
     }
 
+    /* Read ahead the leaf pages of a range scan from their parent */
+    pcur->init_read_ahead(moves_up && !unique_search &&
+                          !dict_index_is_spatial(index));
+
     btr_pcur_open_with_no_init(index, search_tuple, mode, BTR_SEARCH_LEAF, pcur,
                                0, &mtr);
 
@@ -4998,6 +5002,10 @@ dberr_t row_search_mvcc(byte *buf, page_cur_mode_t mode,
       }
     }
   } else if (mode == PAGE_CUR_G || mode == PAGE_CUR_L) {
+    /* Opening at the index side does not pass the node pointers, the
+    read-ahead starts when the cursor is restored. */
+    pcur->init_read_ahead(mode == PAGE_CUR_G);
+
     btr_pcur_open_at_index_side(mode == PAGE_CUR_G, index, BTR_SEARCH_LEAF,
                                 pcur, false, 0, &mtr);
   }
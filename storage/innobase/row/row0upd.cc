@@ -211,6 +211,11 @@ static MY_ATTRIBUTE((warn_unused_result)) dberr_t
 
   trx = thr_get_trx(thr);
 
+  /* A parent row is deleted or updated by this transaction: the
+  foreign key checks of the statement that found it are no longer
+  valid */
+  trx->fk_checked.clear();
+
   rec = btr_pcur_get_rec(pcur);
   ut_ad(rec_offs_validate(rec, index, offsets));
 
@@ -160,6 +160,9 @@ it, truncate action is completed but no new tablespace is marked
 for truncate (action is never aborted). */
 bool srv_undo_log_truncate = FALSE;
 
+/** Maximum number of UNDO tablespaces marked for truncate at the same time. */
+ulong srv_undo_log_truncate_spaces = 1;
+
 /** Enable or disable Encrypt of UNDO tablespace. */
 bool srv_undo_log_encrypt = FALSE;
 
@@ -408,6 +411,8 @@ ulong srv_n_page_hash_locks = 16;
 ulong srv_LRU_scan_depth = 1024;
 /** Whether or not to flush neighbors of a block */
 ulong srv_flush_neighbors = 1;
+/** Whether pages of temporary tablespaces are only written on eviction */
+bool srv_temp_flush_on_evict = false;
 /** Previously requested size. Accesses protected by memory barriers. */
 ulint srv_buf_pool_old_size = 0;
 /** Current size as scaling factor for the other components */
@@ -433,6 +438,9 @@ bool srv_random_read_ahead = FALSE;
 in the buffer cache and accessed sequentially for InnoDB to trigger a
 readahead request. */
 ulong srv_read_ahead_threshold = 56;
+/* Maximum number of leaf pages a range scan reads ahead by following
+the node pointers of their parent page, 0 disables it. */
+ulong srv_logical_read_ahead_pages = 0;
 
 /** Maximum on-disk size of change buffer in terms of percentage
 of the buffer pool. */
@@ -453,6 +461,9 @@ ulong srv_max_io_capacity = 400;
 /* The number of page cleaner threads to use.*/
 ulong srv_n_page_cleaners = 4;
 
+/* The number of threads recalculating persistent statistics. */
+ulong srv_n_stats_recalc_threads = 1;
+
 /* The InnoDB main thread tries to keep the ratio of modified pages
 in the buffer pool to all database pages in the buffer pool smaller than
 the following number. But it is not guaranteed that the value stays below
@@ -545,6 +556,10 @@ ulong srv_doublewrite_batch_size = 120;
 
 ulong srv_replication_delay = 0;
 
+/** Maximum number of foreign key checks remembered per statement, see
+trx_t::fk_checked; 0 disables it */
+ulong srv_fk_check_cache_size = 1024;
+
 /*-------------------------------------------*/
 ulong srv_n_spin_wait_rounds = 30;
 ulong srv_spin_wait_delay = 6;
@@ -1096,6 +1111,11 @@ static void srv_init(void) {
   srv_threads.m_page_cleaner_workers =
       UT_NEW_ARRAY_NOKEY(IB_thread, srv_threads.m_page_cleaner_workers_n);
 
+  srv_threads.m_dict_stats_workers_n = srv_n_stats_recalc_threads;
+
+  srv_threads.m_dict_stats_workers =
+      UT_NEW_ARRAY_NOKEY(IB_thread, srv_threads.m_dict_stats_workers_n);
+
   srv_sys = static_cast<srv_sys_t *>(ut_zalloc_nokey(srv_sys_sz));
 
   srv_sys->n_sys_threads = n_sys_threads;
@@ -1198,6 +1218,14 @@ void srv_free(void) {
     srv_threads.m_page_cleaner_workers = nullptr;
   }
 
+  if (srv_threads.m_dict_stats_workers != nullptr) {
+    for (size_t i = 0; i < srv_threads.m_dict_stats_workers_n; ++i) {
+      srv_threads.m_dict_stats_workers[i] = {};
+    }
+    ut_free(srv_threads.m_dict_stats_workers);
+    srv_threads.m_dict_stats_workers = nullptr;
+  }
+
   if (srv_threads.m_purge_workers != nullptr) {
     for (size_t i = 0; i < srv_threads.m_purge_workers_n; ++i) {
       srv_threads.m_purge_workers[i] = {};
@@ -1590,6 +1618,8 @@ void srv_export_innodb_status(void) {
 
   export_vars.innodb_rows_deleted = srv_stats.n_rows_deleted;
 
+  export_vars.innodb_fk_check_cache_hits = srv_stats.n_fk_check_cache_hits;
+
   export_vars.innodb_num_open_files = fil_n_file_opened;
 
   export_vars.innodb_truncated_status_writes = srv_truncated_status_writes;
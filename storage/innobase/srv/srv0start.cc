@@ -3060,6 +3060,8 @@ void srv_start_threads(bool bootstrap) {
   srv_threads.m_dict_stats =
       os_thread_create(dict_stats_thread_key, dict_stats_thread);
 
+  srv_threads.m_dict_stats_workers[0] = srv_threads.m_dict_stats;
+
   dict_stats_thread_init();
 
   srv_threads.m_dict_stats.start();
@@ -62,8 +62,10 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "lizard0sys.h"
 #include "lizard0gp.h"
 #include "lizard0undo.h"
+#include "lizard0trx.h"
 
 #include "srv0file.h"
+#include "btr0est.h"
 
 #ifdef UNIV_DEBUG
 
@@ -1504,6 +1506,9 @@ static void sync_latch_meta_init() UNIV_NOTHROW {
   LATCH_ADD_MUTEX(REDO_LOG_ARCHIVE_QUEUE_MUTEX, SYNC_NO_ORDER_CHECK,
                   PFS_NOT_INSTRUMENTED);
 
+  LATCH_ADD_MUTEX(BTR_RANGE_EST_CACHE, SYNC_NO_ORDER_CHECK,
+                  btr_range_est_cache_mutex_key);
+
   LATCH_ADD_MUTEX(TEST_MUTEX, SYNC_NO_ORDER_CHECK, PFS_NOT_INSTRUMENTED);
 
   LATCH_ADD_MUTEX(LIZARD_SCN, SYNC_NO_ORDER_CHECK, lizard_scn_mutex_key);
@@ -1526,6 +1531,9 @@ static void sync_latch_meta_init() UNIV_NOTHROW {
   LATCH_ADD_MUTEX(LIZARD_UNDO_RETENTION, SYNC_NO_ORDER_CHECK,
                   lizard_undo_retention_mutex_key);
 
+  LATCH_ADD_MUTEX(LIZARD_RW_TRX_HASH, SYNC_NO_ORDER_CHECK,
+                  lizard_rw_trx_hash_mutex_key);
+
   latch_id_t id = LATCH_ID_NONE;
 
   /* The array should be ordered on latch ID.We need to
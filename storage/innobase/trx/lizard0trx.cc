@@ -25,13 +25,131 @@
  *******************************************************/
 
 #include "lizard0trx.h"
+#include "trx0trx.h"
+
+#ifdef UNIV_PFS_MUTEX
+/* lizard rw trx hash partition mutex PFS key */
+mysql_pfs_key_t lizard_rw_trx_hash_mutex_key;
+#endif
 
 namespace lizard {
 
-void copy_to(TrxIdHash &h, TrxIdSet &s) {
-  for (TrxIdHash::const_iterator it = h.cbegin(); it != h.cend(); it++) {
-    s.insert(TrxTrack(it->first, it->second));
+TrxIdHash::Partition::Partition() : m_map() {
+  mutex_create(LATCH_ID_LIZARD_RW_TRX_HASH, &m_mutex);
+}
+
+TrxIdHash::Partition::~Partition() {
+  ut_ad(m_map.empty());
+  mutex_free(&m_mutex);
+}
+
+TrxIdHash::TrxIdHash() {}
+
+TrxIdHash::~TrxIdHash() {}
+
+/**
+  Add an active read-write transaction.
+
+  @param[in]		trx id and the transaction
+*/
+void TrxIdHash::insert(const TrxPair &pair) {
+  ut_ad(pair.first > 0);
+  Partition &part = get_partition(pair.first);
+
+  mutex_enter(&part.m_mutex);
+  part.m_map.insert(pair);
+  mutex_exit(&part.m_mutex);
+}
+
+/**
+  Remove the transaction from the hash.
+
+  @param[in]		trx id
+*/
+void TrxIdHash::erase(trx_id_t id) {
+  Partition &part = get_partition(id);
+
+  mutex_enter(&part.m_mutex);
+  part.m_map.erase(id);
+  mutex_exit(&part.m_mutex);
+}
+
+/**
+  Look up the transaction by id.
+
+  @param[in]		trx id
+
+  @retval		the trx handle or nullptr
+*/
+trx_t *TrxIdHash::find(trx_id_t id) {
+  trx_t *trx = nullptr;
+  Partition &part = get_partition(id);
+
+  mutex_enter(&part.m_mutex);
+  TrxIdMap::const_iterator it = part.m_map.find(id);
+  if (it != part.m_map.end()) trx = it->second;
+  mutex_exit(&part.m_mutex);
+
+  return trx;
+}
+
+/**
+  Look up the transaction by id and reference it within the partition
+  latch, so the trx can't be committed and freed during the lookup.
+
+  @param[in]		trx id
+  @param[in]		whether increase the reference count
+
+  @retval		the active trx handle or nullptr
+*/
+trx_t *TrxIdHash::find_and_reference(trx_id_t id, bool do_ref_count) {
+  trx_t *trx = nullptr;
+  Partition &part = get_partition(id);
+
+  mutex_enter(&part.m_mutex);
+  TrxIdMap::const_iterator it = part.m_map.find(id);
+  if (it != part.m_map.end()) {
+    /** trx_erase_lists() removes the trx from the partition before
+    changing state to TRX_STATE_COMMITTED_IN_MEMORY, holding the partition
+    latch here is enough to prevent it from being released. */
+    trx = trx_reference(it->second, do_ref_count);
   }
+  mutex_exit(&part.m_mutex);
+
+  return trx;
 }
 
+/**
+  Total count of all partitions, it's an estimated value.
+
+  @retval		total count
+*/
+ulint TrxIdHash::size() const {
+  ulint n = 0;
+  for (ulint i = 0; i < TRX_ID_HASH_PARTITIONS; i++) {
+    n += m_parts[i].m_map.size();
+  }
+  return n;
+}
+
+/**
+  Copy all the transaction into the ordered set.
+
+  @param[out]		the ordered trx set
+*/
+void TrxIdHash::copy_to(TrxIdSet &s) {
+  for (ulint i = 0; i < TRX_ID_HASH_PARTITIONS; i++) {
+    Partition &part = m_parts[i];
+
+    mutex_enter(&part.m_mutex);
+    for (TrxIdMap::const_iterator it = part.m_map.cbegin();
+         it != part.m_map.cend(); it++) {
+      s.insert(TrxTrack(it->first, it->second));
+    }
+    mutex_exit(&part.m_mutex);
+  }
+}
+
+void copy_to(TrxIdHash &h, TrxIdSet &s) { h.copy_to(s); }
+
 }  // namespace lizard
@@ -799,7 +799,7 @@ void Tablespace::alter_active() {
   if (m_rsegs->is_empty()) {
     m_rsegs->set_active();
   } else if (m_rsegs->is_inactive_explicit()) {
-    if (purge_sys->undo_trunc.get_marked_space_num() == m_num) {
+    if (purge_sys->undo_trunc.is_marked(m_num)) {
       m_rsegs->set_inactive_implicit();
     } else {
       m_rsegs->set_active();
@@ -1069,6 +1069,56 @@ bool is_active(space_id_t space_id, bool get_latch) {
 /* Declare this global object. */
 Space_Ids undo::s_under_construction;
 
+/** Mark more UNDO tablespaces that qualify for TRUNCATE while the marked
+one is being emptied, up to innodb_undo_log_truncate_spaces in total, so that
+purge empties all of them at the same time instead of one after another. */
+static void trx_purge_mark_pending_undo_for_truncate() {
+  undo::Truncate *undo_trunc = &purge_sys->undo_trunc;
+
+  ut_ad(undo_trunc->is_marked());
+
+  if (undo_trunc->n_marked() >= srv_undo_log_truncate_spaces) {
+    return;
+  }
+
+  undo::spaces->s_lock();
+
+  ulint num_active = 0;
+  for (auto undo_ts : undo::spaces->m_spaces) {
+    num_active += (undo_ts->is_active() ? 1 : 0);
+  }
+
+  for (auto undo_space : undo::spaces->m_spaces) {
+    if (undo_trunc->n_marked() >= srv_undo_log_truncate_spaces) {
+      break;
+    }
+
+    /* Lizard txn undo tablespaces are never truncated. */
+    if (undo_space->is_txn() || undo_trunc->is_marked(undo_space->num()) ||
+        !undo_space->needs_truncation()) {
+      continue;
+    }
+
+    if (undo_space->is_active()) {
+      /* Keep at least one undo tablespace for new transactions. */
+      if (num_active <= (1 + FSP_IMPLICIT_TXN_TABLESPACES)) {
+        continue;
+      }
+
+      num_active--;
+    }
+
+    undo_trunc->mark_pending(undo_space);
+
+#ifdef UNIV_DEBUG
+    ib::info(ER_IB_MSG_1167) << "Undo tablespace number " << undo_space->num()
+                             << " is marked for truncate";
+#endif /* UNIV_DEBUG */
+  }
+
+  undo::spaces->s_unlock();
+}
+
 /** Iterate over all the UNDO tablespaces and check if any of the UNDO
 tablespace qualifies for TRUNCATE (size > threshold).
 @return true if an undo tablespace was marked for truncate. */
@@ -1079,8 +1129,22 @@ static bool trx_purge_mark_undo_for_truncate() {
   but they might not both be active. */
   ut_a(undo::spaces->size() >= FSP_IMPLICIT_UNDO_TABLESPACES);
 
+  /* Truncate the pending ones first, they are already being emptied and
+  must be truncated even if truncate was disabled in the meantime. */
+  if (!undo_trunc->is_marked() && undo_trunc->n_marked() > 0) {
+    undo::spaces->s_lock();
+    for (auto undo_space : undo::spaces->m_spaces) {
+      if (undo_trunc->is_pending(undo_space->num())) {
+        undo_trunc->promote(undo_space);
+        break;
+      }
+    }
+    undo::spaces->s_unlock();
+  }
+
   /* Return true if an undo tablespace is already marked for truncate. */
   if (undo_trunc->is_marked()) {
+    trx_purge_mark_pending_undo_for_truncate();
     return (true);
   }
 
@@ -1142,28 +1206,18 @@ static bool trx_purge_mark_undo_for_truncate() {
                            << " is marked for truncate";
 #endif /* UNIV_DEBUG */
 
+  trx_purge_mark_pending_undo_for_truncate();
+
   return (true);
 }
 
 size_t undo::Truncate::s_scan_pos;
 
-/** Iterate over selected UNDO tablespace and check if all the rsegs
-that resides in the tablespace have been freed.
-@param[in]	limit		truncate_limit */
-static bool trx_purge_check_if_marked_undo_is_empty(purge_iter_t *limit) {
-  undo::Truncate *undo_trunc = &purge_sys->undo_trunc;
-
-  ut_ad(undo_trunc->is_marked());
-
-  /* Return immediately if the marked UNDO tablespace has already been
-  found to be empty. */
-  if (undo_trunc->is_marked_space_empty()) {
-    return (true);
-  }
-
-  undo::spaces->s_lock();
-  space_id_t space_num = undo_trunc->get_marked_space_num();
-  undo::Tablespace *marked_space = undo::spaces->find(space_num);
+/** Check if all the rsegs that reside in an UNDO tablespace marked for
+truncate have been freed. The caller must hold undo::spaces->s_lock().
+@param[in]	marked_space	undo tablespace marked for truncate
+@return true if the tablespace has no more undo logs */
+static bool trx_purge_undo_space_is_empty(undo::Tablespace *marked_space) {
   Rsegs *marked_rsegs = marked_space->rsegs();
 
   /* If an undo tablespace is marked, its rsegs are inactive. */
@@ -1193,12 +1247,48 @@ static bool trx_purge_check_if_marked_undo_is_empty(purge_iter_t *limit) {
     }
   }
 
+  marked_rsegs->x_unlock();
+
+  return (all_free);
+}
+
+/** Iterate over selected UNDO tablespace and check if all the rsegs
+that resides in the tablespace have been freed.
+@param[in]	limit		truncate_limit */
+static bool trx_purge_check_if_marked_undo_is_empty(purge_iter_t *limit) {
+  undo::Truncate *undo_trunc = &purge_sys->undo_trunc;
+
+  ut_ad(undo_trunc->is_marked());
+
+  /* Return immediately if the marked UNDO tablespace has already been
+  found to be empty. */
+  if (undo_trunc->is_marked_space_empty()) {
+    return (true);
+  }
+
+  undo::spaces->s_lock();
+  space_id_t space_num = undo_trunc->get_marked_space_num();
+  undo::Tablespace *marked_space = undo::spaces->find(space_num);
+
+  bool all_free = trx_purge_undo_space_is_empty(marked_space);
+
+  /* The pending tablespaces are emptied at the same time, truncate
+  whichever of them gets empty first. */
+  if (!all_free && undo_trunc->n_marked() > 1) {
+    for (auto undo_space : undo::spaces->m_spaces) {
+      if (undo_trunc->is_pending(undo_space->num()) &&
+          trx_purge_undo_space_is_empty(undo_space)) {
+        undo_trunc->swap_marked(undo_space);
+        all_free = true;
+        break;
+      }
+    }
+  }
+
   if (all_free) {
     undo_trunc->set_marked_space_empty();
   }
 
-  marked_rsegs->x_unlock();
-
   undo::spaces->s_unlock();
 
   return (all_free);
@@ -1317,7 +1407,7 @@ static bool trx_purge_truncate_marked_undo_low(space_id_t space_num,
     marked_rsegs->set_active();
   }
 
-  undo_trunc->reset();
+  undo_trunc->reset_marked();
 
   marked_rsegs->x_unlock();
   undo::spaces->s_unlock();
@@ -102,6 +102,9 @@ static void trx_rollback_to_savepoint_low(
 
   trx->error_state = DB_SUCCESS;
 
+  /* The rollback may remove parent rows inserted by this transaction */
+  trx->fk_checked.clear();
+
   if (trx_is_rseg_updated(trx)) {
     ut_ad(trx->rsegs.m_redo.rseg != 0 || trx->rsegs.m_noredo.rseg != 0);
 
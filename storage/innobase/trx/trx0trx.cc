@@ -271,6 +271,8 @@ struct TrxFactory {
     the constructors of the trx_t members. */
     new (&trx->mod_tables) trx_mod_tables_t();
 
+    new (&trx->fk_checked) trx_fk_checked_t();
+
     new (&trx->lock.rec_pool) lock_pool_t();
 
     new (&trx->lock.table_pool) lock_pool_t();
@@ -338,6 +340,8 @@ struct TrxFactory {
 
     trx->mod_tables.~trx_mod_tables_t();
 
+    trx->fk_checked.~trx_fk_checked_t();
+
     // ut_ad(trx->read_view == NULL);
     ut_ad(!trx->vision.is_active());
 
@@ -546,6 +550,8 @@ static void trx_free(trx_t *&trx) {
 
   trx->mod_tables.clear();
 
+  trx->fk_checked.clear();
+
   // ut_ad(trx->read_view == NULL);
 
   ut_ad(!trx->vision.is_active());
@@ -1923,10 +1929,10 @@ static void trx_release_impl_and_expl_locks(trx_t *trx, bool serialized) {
   This change is protected by both trx_sys->mutex and trx->mutex.
   Therefore, there are two secure ways to check if the trx still can hold
   implicit locks:
-  (1) if you only know id of the trx, then you can obtain trx_sys->mutex and
-      check if trx is still in rw_trx_set. This works, because the call to
-      trx_erase_list() which removes trx from this list several lines above is
-      also protected by trx_sys->mutex. We use this approach in
+  (1) if you only know id of the trx, then you can obtain the rw_trx_hash
+      partition latch and check if trx is still in it. This works, because the
+      call to trx_erase_list() which removes trx from the hash several lines
+      above is also protected by the partition latch. We use this approach in
       lock_rec_convert_impl_to_expl() by using trx_rw_is_active()
   (2) if you have pointer to trx, and you know it is safe to access (say, you
       hold reference to this trx which prevents it from being freed) then you
@@ -1980,6 +1986,10 @@ written */
   trx->must_flush_log_later = false;
   trx->ddl_must_flush = false;
 
+  /* The S locks which made the cached foreign key checks valid are
+  released below */
+  trx->fk_checked.clear();
+
   if (trx_is_autocommit_non_locking(trx)) {
     ut_ad(trx->id == 0);
     ut_ad(trx->read_only);
@@ -2546,6 +2556,8 @@ void trx_mark_sql_stat_end(trx_t *trx) /*!< in: trx handle */
 
   lock_on_statement_end(trx);
 
+  trx->fk_checked.clear();
+
   switch (trx->state) {
     case TRX_STATE_PREPARED:
     case TRX_STATE_COMMITTED_IN_MEMORY:
@@ -19,6 +19,7 @@ int main() {
 #include <inttypes.h>
 #include <stdio.h>
 #include <sys/types.h>
+#include <atomic>
 
 #include "port/port.h"
 #include "util/mutexlock.h"
@@ -26,6 +27,7 @@ int main() {
 #include "xengine/cache.h"
 #include "xengine/db.h"
 #include "xengine/env.h"
+#include "xengine/persistent_cache.h"
 
 using GFLAGS::ParseCommandLineFlags;
 
@@ -51,6 +53,18 @@ DEFINE_bool(use_clock_cache, false, "");
 
 DEFINE_bool(use_xcache, false, "");
 
+DEFINE_string(persistent_cache_path, "",
+              "Path of the persistent cache tier behind the cache, a lookup"
+              " missing the cache reads the tier and fills both. Empty to"
+              " disable");
+DEFINE_uint64(persistent_cache_size, 1 * KB * KB * KB,
+              "Number of bytes of the persistent cache tier.");
+DEFINE_int32(persistent_cache_admission, 1,
+             "Misses after which a block is written to the persistent cache"
+             " tier.");
+DEFINE_int32(block_size, 4 * KB,
+             "Bytes of a block written to the persistent cache tier.");
+
 using namespace xengine;
 using namespace common;
 using namespace util;
@@ -136,6 +150,18 @@ class CacheBench {
     }else {
       cache_ = NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits);
     }
+
+    if (!FLAGS_persistent_cache_path.empty()) {
+      Status s = NewPersistentCache(
+          util::Env::Default(), FLAGS_persistent_cache_path,
+          FLAGS_persistent_cache_size, false /* optimized_for_nvm */,
+          &persistent_cache_, FLAGS_persistent_cache_admission);
+      if (!s.ok()) {
+        fprintf(stderr, "Error opening persistent cache: %s\n",
+                s.ToString().c_str());
+        exit(1);
+      }
+    }
   }
 
   ~CacheBench() {}
@@ -185,13 +211,42 @@ class CacheBench {
           static_cast<double>(FLAGS_threads * FLAGS_ops_per_thread) / elapsed);
       fprintf(stdout, "Complete in %.3f s; QPS = %u\n", elapsed, qps);
     }
+
+    if (persistent_cache_) {
+      const uint64_t misses = cache_misses_.load();
+      const uint64_t hits = persistent_cache_hits_.load();
+      fprintf(stdout,
+              "Cache misses = %" PRIu64 "; persistent cache hits = %" PRIu64
+              " (%.2f%%)\n",
+              misses, hits, misses ? 100.0 * hits / misses : 0.0);
+    }
     return true;
   }
 
  private:
   std::shared_ptr<Cache> cache_;
+  std::shared_ptr<PersistentCache> persistent_cache_;
+  std::atomic<uint64_t> cache_misses_{0};
+  std::atomic<uint64_t> persistent_cache_hits_{0};
   uint32_t num_threads_;
 
+  // Read the block missing the cache from the persistent cache tier, or from
+  // the "data file" which costs nothing here, and fill the tiers
+  void ReadThrough(const Slice& key) {
+    cache_misses_++;
+
+    std::unique_ptr<char[], memory::ptr_delete<char>> data;
+    size_t size = 0;
+    if (persistent_cache_->Lookup(key, &data, &size).ok()) {
+      persistent_cache_hits_++;
+    } else {
+      std::string block(FLAGS_block_size, 'x');
+      persistent_cache_->Insert(key, block.data(), block.size());
+    }
+
+    cache_->Insert(key, new char[10], 1, &deleter);
+  }
+
   static void ThreadBody(void* v) {
     ThreadState* thread = reinterpret_cast<ThreadState*>(v);
     SharedState* shared = thread->shared;
@@ -232,6 +287,8 @@ class CacheBench {
         auto handle = cache_->Lookup(key);
         if (handle) {
           cache_->Release(handle);
+        } else if (persistent_cache_) {
+          ReadThrough(key);
         }
       } else if (prob_op -=
                  FLAGS_lookup_percent && prob_op < FLAGS_erase_percent) {
@@ -252,6 +309,12 @@ class CacheBench {
     printf("Insert percentage   : %d%%\n", FLAGS_insert_percent);
     printf("Lookup percentage   : %d%%\n", FLAGS_lookup_percent);
     printf("Erase percentage    : %d%%\n", FLAGS_erase_percent);
+    if (!FLAGS_persistent_cache_path.empty()) {
+      printf("Persistent cache    : %s\n", FLAGS_persistent_cache_path.c_str());
+      printf("Persistent size     : %" PRIu64 "\n",
+             FLAGS_persistent_cache_size);
+      printf("Admission           : %d\n", FLAGS_persistent_cache_admission);
+    }
     printf("----------------------------\n");
   }
 };
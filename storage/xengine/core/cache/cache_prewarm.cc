@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2020, Alibaba Group Holding Limited
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "cache/cache_prewarm.h"
+#include <algorithm>
+#include "logger/logger.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/hash.h"
+#include "util/mutexlock.h"
+#include "util/random.h"
+#include "xengine/xengine_constants.h"
+
+namespace xengine
+{
+using namespace common;
+using namespace util;
+namespace cache
+{
+
+HotCacheTracker::HotCacheTracker(const int64_t max_entries,
+                                 const int64_t sample_interval)
+    : max_entries_(max_entries),
+      sample_interval_(std::max(sample_interval, (int64_t)1)),
+      block_count_(0),
+      row_count_(0)
+{
+}
+
+HotCacheTracker::~HotCacheTracker()
+{
+}
+
+bool HotCacheTracker::sample() const
+{
+  return 1 == sample_interval_
+         || Random::GetTLSInstance()->OneIn(static_cast<int>(sample_interval_));
+}
+
+HotCacheTracker::Shard &HotCacheTracker::row_shard(const Slice &key)
+{
+  return shards_[Hash(key.data(), key.size(), 0) % SHARD_NUM];
+}
+
+void HotCacheTracker::add_block(const BlockKey &key,
+                                const uint64_t size,
+                                const uint64_t hits)
+{
+  Shard &shard = block_shard(key);
+  MutexLock lock_guard(&shard.mutex_);
+  auto iter = shard.blocks_.find(key);
+  if (shard.blocks_.end() != iter) {
+    iter->second.hits_ += hits;
+  } else if (block_count_.fetch_add(1) < max_entries_) {
+    shard.blocks_.emplace(key, BlockStat{size, hits});
+  } else {
+    block_count_.fetch_sub(1);
+  }
+}
+
+void HotCacheTracker::add_row(const Slice &key, const uint64_t hits)
+{
+  Shard &shard = row_shard(key);
+  MutexLock lock_guard(&shard.mutex_);
+  std::string row_key(key.data(), key.size());
+  auto iter = shard.rows_.find(row_key);
+  if (shard.rows_.end() != iter) {
+    iter->second += hits;
+  } else if (row_count_.fetch_add(1) < max_entries_) {
+    shard.rows_.emplace(std::move(row_key), hits);
+  } else {
+    row_count_.fetch_sub(1);
+  }
+}
+
+void HotCacheTracker::record_block(const int64_t extent_id,
+                                   const uint64_t offset,
+                                   const uint64_t size)
+{
+  if (sample()) {
+    add_block(BlockKey{extent_id, offset}, size, 1);
+  }
+}
+
+void HotCacheTracker::record_row(const Slice &row_cache_key)
+{
+  if (sample()) {
+    add_row(row_cache_key, 1);
+  }
+}
+
+void HotCacheTracker::restore(const std::vector<HotBlock> &blocks,
+                              const std::vector<HotRow> &rows)
+{
+  for (const HotBlock &block : blocks) {
+    add_block(BlockKey{block.extent_id_, block.offset_}, block.size_, block.hits_);
+  }
+  for (const HotRow &row : rows) {
+    add_row(row.key_, row.hits_);
+  }
+}
+
+int HotCacheTracker::dump(Env *env, const std::string &fname)
+{
+  int ret = Status::kOk;
+  std::vector<HotBlock> blocks;
+  std::vector<HotRow> rows;
+  for (int64_t i = 0; i < SHARD_NUM; ++i) {
+    Shard &shard = shards_[i];
+    MutexLock lock_guard(&shard.mutex_);
+    for (auto iter = shard.blocks_.begin(); shard.blocks_.end() != iter;) {
+      blocks.emplace_back(iter->first.extent_id_, iter->first.offset_,
+                          iter->second.size_, iter->second.hits_);
+      if (0 == (iter->second.hits_ >>= 1)) {
+        iter = shard.blocks_.erase(iter);
+        block_count_.fetch_sub(1);
+      } else {
+        ++iter;
+      }
+    }
+    for (auto iter = shard.rows_.begin(); shard.rows_.end() != iter;) {
+      rows.emplace_back(iter->first, iter->second);
+      if (0 == (iter->second >>= 1)) {
+        iter = shard.rows_.erase(iter);
+        row_count_.fetch_sub(1);
+      } else {
+        ++iter;
+      }
+    }
+  }
+
+  // hottest first, that is the order the loader warms them in
+  size_t block_count = blocks.size();
+  std::sort(blocks.begin(), blocks.end(),
+            [](const HotBlock &a, const HotBlock &b) {
+              return a.hits_ > b.hits_;
+            });
+  size_t row_count = rows.size();
+  std::sort(rows.begin(), rows.end(),
+            [](const HotRow &a, const HotRow &b) {
+              return a.hits_ > b.hits_;
+            });
+
+  std::string buf;
+  PutFixed32(&buf, DUMP_MAGIC);
+  PutFixed32(&buf, DUMP_VERSION);
+  PutVarint64(&buf, block_count);
+  for (size_t i = 0; i < block_count; ++i) {
+    PutVarint64(&buf, blocks[i].extent_id_);
+    PutVarint64(&buf, blocks[i].offset_);
+    PutVarint64(&buf, blocks[i].size_);
+    PutVarint64(&buf, blocks[i].hits_);
+  }
+  PutVarint64(&buf, row_count);
+  for (size_t i = 0; i < row_count; ++i) {
+    PutLengthPrefixedSlice(&buf, rows[i].key_);
+    PutVarint64(&buf, rows[i].hits_);
+  }
+  PutFixed32(&buf, crc32c::Mask(crc32c::Value(buf.data(), buf.size())));
+
+  // write aside and rename, a crash in between leaves the last dump intact
+  std::string tmp_fname = fname + ".tmp";
+  if (FAILED(WriteStringToFile(env, buf, tmp_fname, true).code())) {
+    XENGINE_LOG(WARN, "failed to write cache prewarm file", K(ret), K(tmp_fname));
+  } else if (FAILED(env->RenameFile(tmp_fname, fname).code())) {
+    XENGINE_LOG(WARN, "failed to rename cache prewarm file", K(ret), K(fname));
+  } else {
+    XENGINE_LOG(INFO, "dumped hot cache entries", K(fname), K(block_count), K(row_count));
+  }
+  return ret;
+}
+
+int HotCacheTracker::load(Env *env,
+                          const std::string &fname,
+                          std::vector<HotBlock> &blocks,
+                          std::vector<HotRow> &rows)
+{
+  int ret = Status::kOk;
+  std::string buf;
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  uint32_t checksum = 0;
+  uint64_t count = 0;
+  blocks.clear();
+  rows.clear();
+  if (FAILED(ReadFileToString(env, fname, &buf).code())) {
+    XENGINE_LOG(WARN, "failed to read cache prewarm file", K(ret), K(fname));
+  } else if (buf.size() < 3 * sizeof(uint32_t)) {
+    ret = Status::kCorruption;
+    XENGINE_LOG(WARN, "cache prewarm file is truncated", K(ret), K(fname));
+  } else {
+    Slice input(buf.data(), buf.size() - sizeof(uint32_t));
+    checksum = crc32c::Unmask(DecodeFixed32(buf.data() + input.size()));
+    if (checksum != crc32c::Value(input.data(), input.size())) {
+      ret = Status::kCorruption;
+      XENGINE_LOG(WARN, "checksum mismatch in cache prewarm file", K(ret), K(fname));
+    } else if (!GetFixed32(&input, &magic) || DUMP_MAGIC != magic
+               || !GetFixed32(&input, &version) || DUMP_VERSION != version) {
+      ret = Status::kNotSupported;
+      XENGINE_LOG(WARN, "unknown cache prewarm file", K(ret), K(fname), K(magic), K(version));
+    } else if (!GetVarint64(&input, &count)) {
+      ret = Status::kCorruption;
+    } else {
+      uint64_t extent_id = 0;
+      HotBlock block;
+      for (uint64_t i = 0; SUCCED(ret) && i < count; ++i) {
+        if (!GetVarint64(&input, &extent_id)
+            || !GetVarint64(&input, &block.offset_)
+            || !GetVarint64(&input, &block.size_)
+            || !GetVarint64(&input, &block.hits_)) {
+          ret = Status::kCorruption;
+        } else {
+          block.extent_id_ = static_cast<int64_t>(extent_id);
+          blocks.push_back(block);
+        }
+      }
+      Slice key;
+      uint64_t hits = 0;
+      if (SUCCED(ret) && !GetVarint64(&input, &count)) {
+        ret = Status::kCorruption;
+      }
+      for (uint64_t i = 0; SUCCED(ret) && i < count; ++i) {
+        if (!GetLengthPrefixedSlice(&input, &key) || !GetVarint64(&input, &hits)) {
+          ret = Status::kCorruption;
+        } else {
+          rows.emplace_back(key, hits);
+        }
+      }
+    }
+    if (Status::kCorruption == ret) {
+      XENGINE_LOG(WARN, "corrupted cache prewarm file", K(ret), K(fname));
+    }
+  }
+  return ret;
+}
+
+int64_t HotCacheTracker::get_block_count() const
+{
+  return block_count_.load();
+}
+
+int64_t HotCacheTracker::get_row_count() const
+{
+  return row_count_.load();
+}
+
+std::string CachePrewarmFileName(const std::string &dbname)
+{
+  return dbname + "/CACHE_PREWARM";
+}
+
+} // namespace cache
+} // namespace xengine
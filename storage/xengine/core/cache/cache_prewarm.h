@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2020, Alibaba Group Holding Limited
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "port/port.h"
+#include "util/hash.h"
+#include "xengine/env.h"
+#include "xengine/slice.h"
+
+namespace xengine
+{
+namespace cache
+{
+
+// A data block that was read often, identified the same way across restarts:
+// the extent it lives in and its handle inside the extent.
+struct HotBlock
+{
+  HotBlock() : extent_id_(0), offset_(0), size_(0), hits_(0) {}
+  HotBlock(int64_t extent_id, uint64_t offset, uint64_t size, uint64_t hits)
+      : extent_id_(extent_id), offset_(offset), size_(size), hits_(hits) {}
+
+  int64_t extent_id_;
+  uint64_t offset_;
+  uint64_t size_;
+  uint64_t hits_;
+};
+
+// A row that was read often, key_ is the row cache key: varint32 subtable id
+// followed by the user key.
+struct HotRow
+{
+  HotRow() : key_(), hits_(0) {}
+  HotRow(const common::Slice &key, uint64_t hits)
+      : key_(key.data(), key.size()), hits_(hits) {}
+
+  std::string key_;
+  uint64_t hits_;
+};
+
+// Samples the data block and row reads of the foreground, and persists the
+// most frequently read ones so that the block cache and the row cache can be
+// warmed up from them after a restart.
+//
+// Counters are halved on every dump, so the dumped order follows what has
+// been hot recently rather than since startup. Once max_entries blocks (or
+// rows) are tracked, new ones are ignored until the next dump ages out the
+// cold ones.
+class HotCacheTracker
+{
+public:
+  static const int64_t SHARD_NUM = 16;
+  static const int64_t DEFAULT_SAMPLE_INTERVAL = 16;
+
+  explicit HotCacheTracker(const int64_t max_entries,
+                           const int64_t sample_interval = DEFAULT_SAMPLE_INTERVAL);
+  ~HotCacheTracker();
+
+  void record_block(const int64_t extent_id,
+                    const uint64_t offset,
+                    const uint64_t size);
+  void record_row(const common::Slice &row_cache_key);
+
+  // Seed the counters with what was loaded from a previous dump, so that the
+  // dumps right after a restart do not forget the hot set before the
+  // foreground has read it again.
+  void restore(const std::vector<HotBlock> &blocks,
+               const std::vector<HotRow> &rows);
+
+  // Write the tracked blocks and rows, at most max_entries of each, to fname,
+  // hottest first, then age the counters.
+  int dump(util::Env *env, const std::string &fname);
+
+  static int load(util::Env *env,
+                  const std::string &fname,
+                  std::vector<HotBlock> &blocks,
+                  std::vector<HotRow> &rows);
+
+  int64_t get_block_count() const;
+  int64_t get_row_count() const;
+
+private:
+  struct BlockKey
+  {
+    bool operator==(const BlockKey &other) const {
+      return extent_id_ == other.extent_id_ && offset_ == other.offset_;
+    }
+    int64_t extent_id_;
+    uint64_t offset_;
+  };
+  struct BlockKeyHash
+  {
+    // offsets are mostly multiples of the page size, so mix all the bits of
+    // the key rather than add them up, or the blocks of an extent would all
+    // fall into the same shard
+    size_t operator()(const BlockKey &key) const {
+      return util::Hash(reinterpret_cast<const char *>(&key), sizeof(key), 0);
+    }
+  };
+  struct BlockStat
+  {
+    uint64_t size_;
+    uint64_t hits_;
+  };
+  struct Shard
+  {
+    mutable port::Mutex mutex_;
+    std::unordered_map<BlockKey, BlockStat, BlockKeyHash> blocks_;
+    std::unordered_map<std::string, uint64_t> rows_;
+  };
+
+  static const uint32_t DUMP_MAGIC = 0x48435450; // "HCTP"
+  static const uint32_t DUMP_VERSION = 1;
+
+  bool sample() const;
+  Shard &block_shard(const BlockKey &key) {
+    return shards_[BlockKeyHash()(key) % SHARD_NUM];
+  }
+  Shard &row_shard(const common::Slice &key);
+  void add_block(const BlockKey &key, const uint64_t size, const uint64_t hits);
+  void add_row(const common::Slice &key, const uint64_t hits);
+
+  const int64_t max_entries_;
+  const int64_t sample_interval_;
+  // tracked keys of all the shards, bounded by max_entries_
+  std::atomic<int64_t> block_count_;
+  std::atomic<int64_t> row_count_;
+  Shard shards_[SHARD_NUM];
+};
+
+extern std::string CachePrewarmFileName(const std::string &dbname);
+
+} // namespace cache
+} // namespace xengine
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020, Alibaba Group Holding Limited
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "cache/cache_prewarm.h"
+#include "cache/row_cache.h"
+#include "db/db_test_util.h"
+#include "port/stack_trace.h"
+
+using namespace xengine;
+using namespace common;
+using namespace util;
+using namespace monitor;
+using namespace db;
+namespace xengine {
+namespace cache {
+
+class CachePrewarmTest : public DBTestBase {
+ public:
+  CachePrewarmTest() : DBTestBase("/cache_prewarm_test") {}
+
+  Options get_options() {
+    option_config_ = kRowCache;
+    Options options = CurrentOptions();
+    options.cache_prewarm_max_entries = 1024;
+    // sample every read
+    options.hot_cache_tracker = std::make_shared<HotCacheTracker>(1024, 1);
+    return options;
+  }
+};
+
+TEST_F(CachePrewarmTest, dump_and_load) {
+  std::string fname = CachePrewarmFileName(dbname_);
+  HotCacheTracker tracker(2, 1);
+  for (int i = 0; i < 3; ++i) {
+    tracker.record_block(1, 4096, 100);
+  }
+  tracker.record_block(1, 0, 100);
+  tracker.record_row("row1");
+  tracker.record_row("row2");
+  tracker.record_row("row2");
+  // max_entries are tracked, whatever shards they fall into, and the rest
+  // is ignored
+  tracker.record_block(2, 0, 100);
+  tracker.record_row("row3");
+  ASSERT_EQ(2, tracker.get_block_count());
+  ASSERT_EQ(2, tracker.get_row_count());
+  ASSERT_EQ(Status::kOk, tracker.dump(env_, fname));
+  // counters are halved, what was read once is forgotten and leaves room
+  ASSERT_EQ(1, tracker.get_block_count());
+  ASSERT_EQ(1, tracker.get_row_count());
+  tracker.record_block(2, 0, 100);
+  ASSERT_EQ(2, tracker.get_block_count());
+
+  std::vector<HotBlock> blocks;
+  std::vector<HotRow> rows;
+  ASSERT_EQ(Status::kOk, HotCacheTracker::load(env_, fname, blocks, rows));
+  // hottest first
+  ASSERT_EQ(2, blocks.size());
+  ASSERT_EQ(1, blocks[0].extent_id_);
+  ASSERT_EQ(4096, blocks[0].offset_);
+  ASSERT_EQ(100, blocks[0].size_);
+  ASSERT_EQ(3, blocks[0].hits_);
+  ASSERT_EQ(1, blocks[1].extent_id_);
+  ASSERT_EQ(0, blocks[1].offset_);
+  ASSERT_EQ(2, rows.size());
+  ASSERT_EQ("row2", rows[0].key_);
+  ASSERT_EQ("row1", rows[1].key_);
+
+  // a restored tracker dumps the same hot set
+  HotCacheTracker restored(2, 1);
+  restored.restore(blocks, rows);
+  ASSERT_EQ(2, restored.get_block_count());
+  ASSERT_EQ(2, restored.get_row_count());
+}
+
+TEST_F(CachePrewarmTest, corrupted_file) {
+  std::string fname = CachePrewarmFileName(dbname_);
+  HotCacheTracker tracker(16, 1);
+  tracker.record_block(1, 0, 100);
+  tracker.record_row("row1");
+  ASSERT_EQ(Status::kOk, tracker.dump(env_, fname));
+
+  std::string data;
+  ASSERT_OK(ReadFileToString(env_, fname, &data));
+  data[data.size() / 2] ^= 0x1;
+  ASSERT_OK(WriteStringToFile(env_, data, fname));
+  std::vector<HotBlock> blocks;
+  std::vector<HotRow> rows;
+  ASSERT_EQ(Status::kCorruption, HotCacheTracker::load(env_, fname, blocks, rows));
+  ASSERT_TRUE(blocks.empty());
+  ASSERT_TRUE(rows.empty());
+}
+
+TEST_F(CachePrewarmTest, prewarm_after_reopen) {
+  Options options = get_options();
+  CreateAndReopenWithCF({"cache_prewarm"}, options);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(Put(1, "key" + std::to_string(i), "val" + std::to_string(i)));
+  }
+  ASSERT_OK(Flush(1));
+  dbfull()->TEST_WaitForCompact(); // wait flush
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ("val1", Get(1, "key1"));
+  }
+  ASSERT_TRUE(options.hot_cache_tracker->get_block_count() > 0);
+  ASSERT_TRUE(options.hot_cache_tracker->get_row_count() > 0);
+
+  // the hot set is dumped at shutdown, and loaded by the reopened db
+  options.hot_cache_tracker = std::make_shared<HotCacheTracker>(1024, 1);
+  ReopenWithColumnFamilies({"default", "cache_prewarm"}, options);
+  dbfull()->TEST_wait_for_cache_prewarm();
+  ASSERT_TRUE(options.hot_cache_tracker->get_row_count() > 0);
+
+  int64_t row_cache_hit = TestGetGlobalCount(CountPoint::ROW_CACHE_HIT);
+  ASSERT_EQ("val1", Get(1, "key1"));
+  ASSERT_EQ(row_cache_hit + 1, TestGetGlobalCount(CountPoint::ROW_CACHE_HIT));
+}
+
+}  // namespace cache
+}  // namespace xengine
+
+int main(int argc, char** argv) {
+  xengine::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  xengine::util::test::init_logger(__FILE__);
+  return RUN_ALL_TESTS();
+}
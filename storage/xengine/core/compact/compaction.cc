@@ -162,6 +162,7 @@ int GeneralCompaction::open_extent() {
   mini_tables_.space_manager = context_.space_manager_;
   mini_tables_.change_info_ = &change_info_;
   mini_tables_.table_space_id_ = context_.table_space_id_;
+  mini_tables_.separate_values = context_.separate_values_;
   bool is_flush= TaskType::FLUSH_LEVEL1_TASK == context_.task_type_;
   storage::LayerPosition output_layer_position(context_.output_level_);
   if (0 == context_.output_level_) {
@@ -777,7 +778,10 @@ int GeneralCompaction::prefetch_extent(int64_t extent_id) {
     // todo if cache key changed
 //    reader->set_subtable_id(cf_desc_.column_family_id_);
     if (nullptr != context_.cf_options_->rate_limiter) {
-      reader->set_rate_limiter(context_.cf_options_->rate_limiter);
+      // minor compactions drain level0 and are ahead of the major ones
+      reader->set_rate_limiter(context_.cf_options_->rate_limiter,
+                               db::is_minor_task(context_.task_type_) ?
+                               Env::IO_HIGH : Env::IO_LOW);
     }
     if (FAILED(reader->prefetch())) {
       COMPACTION_LOG(WARN, "failed to prefetch", K(ret));
@@ -917,6 +921,8 @@ void GeneralCompaction::record_compaction_iterator_stats(
   stats.merge_input_raw_value_bytes += c_iter_stats.total_input_raw_value_bytes;
   stats.merge_replace_records += c_iter_stats.num_record_drop_hidden;
   stats.merge_expired_records += c_iter_stats.num_record_drop_obsolete;
+  stats.merge_drop_large_values += c_iter_stats.num_record_drop_large_value;
+  stats.merge_drop_large_value_bytes += c_iter_stats.total_drop_large_value_bytes;
 }
 
 }  // namespace storage
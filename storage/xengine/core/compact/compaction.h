@@ -394,6 +394,8 @@ struct CompactionContext {
   storage::StorageLogger *storage_logger_;
   bool enable_thread_tracking_;
   bool need_check_snapshot_;
+  // see ColumnFamilyData::can_separate_values
+  bool separate_values_;
 
   CompactionContext()
       : shutting_down_(nullptr),
@@ -414,7 +416,8 @@ struct CompactionContext {
         force_layer_sequence_(-1),
         storage_logger_(nullptr),
         enable_thread_tracking_(false),
-        need_check_snapshot_(true)
+        need_check_snapshot_(true),
+        separate_values_(true)
   {
     existing_snapshots_.clear();
   }
@@ -19,6 +19,11 @@ struct CompactionIterationStats {
   int64_t num_range_del_drop_obsolete = 0;
   uint64_t total_filter_time = 0;
 
+  // Dropped records whose value lives in a large object or value extent, the
+  // extents are recycled once none of their values is alive
+  int64_t num_record_drop_large_value = 0;
+  uint64_t total_drop_large_value_bytes = 0;
+
   // Input statistics
   // TODO(noetzli): The stats are incomplete. They are lacking everything
   // consumed by MergeHelper.
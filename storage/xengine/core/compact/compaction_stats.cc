@@ -53,6 +53,8 @@ CompactRecordStats &CompactRecordStats::add(const CompactRecordStats &stats) {
   merge_corrupt_keys += stats.merge_corrupt_keys;
   single_del_fallthru += stats.single_del_fallthru;
   single_del_mismatch += stats.single_del_mismatch;
+  merge_drop_large_values += stats.merge_drop_large_values;
+  merge_drop_large_value_bytes += stats.merge_drop_large_value_bytes;
 
   write_amp += stats.write_amp;
   return *this;
@@ -67,7 +69,8 @@ DEFINE_SERIALIZATION(CompactRecordStats, total_input_extents,
                      merge_input_raw_key_bytes, merge_replace_records,
                      merge_input_raw_value_bytes, merge_delete_records,
                      merge_expired_records, merge_corrupt_keys,
-                     single_del_fallthru, single_del_mismatch);
+                     single_del_fallthru, single_del_mismatch,
+                     merge_drop_large_values, merge_drop_large_value_bytes);
 
 DEFINE_TO_STRING(CompactRecordStats,
                  KV(total_input_extents),
@@ -94,6 +97,8 @@ DEFINE_TO_STRING(CompactRecordStats,
                  KV(merge_corrupt_keys),
                  KV(single_del_fallthru),
                  KV(single_del_mismatch),
+                 KV(merge_drop_large_values),
+                 KV(merge_drop_large_value_bytes),
                  KV(micros),
                  KV(write_amp));
 
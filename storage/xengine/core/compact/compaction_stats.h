@@ -97,6 +97,11 @@ struct CompactRecordStats {
   // number of single-deletes which meet something other than a put
   int64_t single_del_mismatch;
 
+  // number of dropped records whose value was stored out of the sst, and the
+  // stored size of those values, which the large object extents give back
+  int64_t merge_drop_large_values;
+  int64_t merge_drop_large_value_bytes;
+
   // write amplification
   double write_amp;
 };
@@ -251,6 +251,8 @@ int NewCompactionIterator::record_large_objects_info(
   if (FAILED(lob_value.deserialize(large_value.data(), large_value.size(), pos))) {
     COMPACTION_LOG(WARN, "fail to deserialize large value", K(ret), "size", large_value.size(), K(pos));
   } else {
+    ++iter_stats_.num_record_drop_large_value;
+    iter_stats_.total_drop_large_value_bytes += lob_value.size_;
     for (uint32_t i = 0; SUCCED(ret) && i < lob_value.oob_extents_.size(); ++i) {
       if (FAILED(change_info_.delete_large_object_extent(lob_value.oob_extents_.at(i)))) {
         COMPACTION_LOG(WARN, "fail to delete large object extent", K(ret), K(i), "extents_size", lob_value.oob_extents_.size(), "extent_id", lob_value.oob_extents_.at(i));
@@ -1386,6 +1386,12 @@ Status ColumnFamilyData::SetOptions(
   MutableCFOptions new_mutable_cf_options;
   Status s = GetMutableOptionsFromStrings(mutable_cf_options_, options_map,
                                           &new_mutable_cf_options);
+  if (s.ok() && new_mutable_cf_options.memtable_factory &&
+      column_family_set_->global_ctx_->options_.allow_concurrent_memtable_write &&
+      !new_mutable_cf_options.memtable_factory->IsInsertConcurrentlySupported()) {
+    s = Status::InvalidArgument(
+        "Memtable doesn't concurrent writes (allow_concurrent_memtable_write)");
+  }
   if (s.ok()) {
     mutable_cf_options_ = new_mutable_cf_options;
     mutable_cf_options_.RefreshDerivedOptions(ioptions_);
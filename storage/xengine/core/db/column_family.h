@@ -273,6 +273,14 @@ class ColumnFamilyData {
            && !pending_dump() && !pending_shrink()
            && storage_manager_.can_gc();
   }
+  // Separating values is paused while the value extents of the subtable are
+  // mostly garbage, see value_separation_min_live_ratio.
+  bool can_separate_values() const
+  {
+    return 0 == ioptions_.value_separation_threshold
+           || storage_manager_.get_lob_live_ratio()
+              >= static_cast<int64_t>(ioptions_.value_separation_min_live_ratio);
+  }
   bool can_shrink()
   {
     return !IsDropped() && !is_bg_stopped()
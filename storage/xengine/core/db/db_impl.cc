@@ -33,6 +33,7 @@
 #include <utility>
 #include <vector>
 
+#include "cache/cache_prewarm.h"
 #include "cache/row_cache.h"
 #include "cache/sharded_cache.h"
 #include "compact/compaction_job.h"
@@ -405,7 +406,9 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname)
       num_running_gc_(0),
       bg_gc_scheduled_(0),
       bg_ebr_scheduled_(0),
+      bg_cache_prewarm_scheduled_(0),
       shrink_running_(false),
+      shrink_progress_(),
       max_seq_in_rp_(0),
       disable_delete_obsolete_files_(0),
       delete_obsolete_files_last_run_(env_->NowMicros()),
@@ -527,7 +530,8 @@ void DBImpl::CancelAllBackgroundWork(bool wait) {
   }
   // Wait for background work to finish
   while (bg_compaction_scheduled_ || bg_flush_scheduled_ || bg_gc_scheduled_ 
-         || bg_dump_scheduled_ || master_thread_running() || bg_ebr_scheduled_) {
+         || bg_dump_scheduled_ || master_thread_running() || bg_ebr_scheduled_
+         || bg_cache_prewarm_scheduled_) {
     bg_cv_.Wait();
   }
 }
@@ -553,7 +557,8 @@ DBImpl::~DBImpl() {
 
   // Wait for background work to finish
   while (bg_compaction_scheduled_ || bg_flush_scheduled_ || bg_dump_scheduled_ ||
-         bg_purge_scheduled_ || bg_recycle_scheduled_ || master_thread_running()) {
+         bg_purge_scheduled_ || bg_recycle_scheduled_ || master_thread_running() ||
+         bg_cache_prewarm_scheduled_) {
     TEST_SYNC_POINT("DBImpl::~DBImpl:WaitJob");
     bg_cv_.Wait();
   }
@@ -722,6 +727,7 @@ void DBImpl::bg_master_thread_func() {
   uint64_t last_auto_compaction_ts = last_stats_dump_ts;
   uint64_t last_shrink_ts = last_stats_dump_ts;
   uint64_t last_ebr_ts = last_stats_dump_ts;
+  uint64_t last_cache_prewarm_dump_ts = last_stats_dump_ts;
   uint64_t stats_dump_period_ms = mutable_db_options_.stats_dump_period_sec * 1000;
   uint64_t cache_purge_ms = 3000; // 3s
   uint64_t gc_ms = 5 * 1000 * 60; // 5min
@@ -826,7 +832,16 @@ void DBImpl::bg_master_thread_func() {
       XENGINE_LOG(INFO, "BG_TASK: ebr task", K(env_->NowMicros()));
       schedule_ebr();
     }
+    // (7) persist the hot blocks and rows for cache prewarm
+    uint64_t cache_prewarm_dump_ms = mutable_db_options_.cache_prewarm_dump_period_sec * 1000;
+    if (cache_prewarm_dump_ms > 0
+        && env_->NowMicros() / 1000 > last_cache_prewarm_dump_ts + cache_prewarm_dump_ms) {
+      last_cache_prewarm_dump_ts = env_->NowMicros() / 1000;
+      dump_hot_cache_entries();
+    }
   }
+  // keep what was hot right before shutdown for the next start
+  dump_hot_cache_entries();
   //we should set stat while holding mutex_
   mutex_.Lock();
   master_thread_running_.store(false, std::memory_order_release);
@@ -1522,6 +1537,8 @@ Status DBImpl::GetImpl(const ReadOptions& read_options,
     if (FAILED(get_from_row_cache(cfd, snapshot, key, row_cache_key, pinnable_val, done))) {
       s = Status(ret);
       XENGINE_LOG(WARN, "failed to get row from row_cache", K(ret));
+    } else if (nullptr != immutable_db_options_.hot_cache_tracker) {
+      immutable_db_options_.hot_cache_tracker->record_row(row_cache_key.GetUserKey());
     }
   }
 
@@ -3934,6 +3951,14 @@ int DBImpl::shrink_table_space(int32_t table_space_id) {
   return ret;
 }
 
+int DBImpl::get_shrink_progress(ShrinkProgress &shrink_progress)
+{
+  mutex_.Lock();
+  shrink_progress = shrink_progress_;
+  mutex_.Unlock();
+  return Status::kOk;
+}
+
 bool DBImpl::get_columnfamily_stats(ColumnFamilyHandle* column_family, int64_t &data_size,
                                     int64_t &num_entries, int64_t &num_deletes, int64_t &disk_size) {
   if (LIKELY(column_family != nullptr)) {
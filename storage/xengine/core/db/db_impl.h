@@ -19,6 +19,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <unordered_set>
 #include <vector>
 
 #include "db/batch_group.h"
@@ -68,12 +69,18 @@ class ShrinkExtentSpacesJobTest;
 namespace util {
 class TransactionImpl;
 class Arena;
+class RateLimiter;
 }
 
 namespace table {
 struct ExternalSstFileInfo;
 }
 
+namespace cache {
+struct HotBlock;
+struct HotRow;
+}
+
 namespace common {
 struct MemTableInfo;
 }
@@ -370,6 +377,8 @@ class DBImpl : public DB {
     return extent_space_manager_->get_data_file_stats(data_file_stats);
   }
 
+  virtual int get_shrink_progress(storage::ShrinkProgress &shrink_progress) override;
+
   virtual common::Status GetUpdatesSince(
       common::SequenceNumber seq_number,
       unique_ptr<TransactionLogIterator>* iter,
@@ -514,6 +523,13 @@ class DBImpl : public DB {
   // Wait for background filter build task.
   void TEST_wait_for_filter_build();
 
+  // Wait for the cache prewarm job started by open.
+  void TEST_wait_for_cache_prewarm();
+
+  // Dump the active memtable of the subtable and wait until the dump is
+  // done. The memtable must hold writes of a WAL older than the current one.
+  int TEST_dump_subtable(ColumnFamilyData *sub_table);
+
   // Return the maximum overlapping data (in bytes) at next level for any
   // file at a level >= 1.
   int64_t TEST_MaxNextLevelOverlappingBytes(
@@ -1219,6 +1235,20 @@ protected:
   int schedule_gc();
   int schedule_shrink();
   void schedule_ebr();
+  void schedule_cache_prewarm();
+  int dump_hot_cache_entries();
+  int prewarm_block_cache(std::vector<cache::HotBlock> &blocks,
+                          util::RateLimiter *rate_limiter);
+  int get_meta_snapshot_extent_ids(const Snapshot *meta_snapshot,
+                                   std::unordered_set<int64_t> &extent_ids);
+  void prewarm_sub_table_blocks(ColumnFamilyData *sub_table,
+                                const std::unordered_set<int64_t> &extent_ids,
+                                std::vector<cache::HotBlock> &blocks,
+                                util::RateLimiter *rate_limiter,
+                                uint64_t &add_blocks,
+                                int64_t &skipped_count);
+  int prewarm_row_cache(const std::vector<cache::HotRow> &rows,
+                        util::RateLimiter *rate_limiter);
   void SchedulePendingFlush(ColumnFamilyData* cfd);
   void SchedulePendingCompaction(ColumnFamilyData* cfd,
                                  const CompactionScheduleType type = CompactionScheduleType::NORMAL);
@@ -1237,11 +1267,13 @@ protected:
   static void bg_work_recycle(void* db);
   static void bg_work_shrink(void *arg);
   static void bg_work_ebr(void *db);
+  static void bg_work_cache_prewarm(void *db);
   void BackgroundCallCompaction(void* arg);
   void BackgroundCallFlush();
   void background_call_dump();
   void background_call_gc();
   void background_call_ebr();
+  void background_call_cache_prewarm();
   void BackgroundCallPurge();
   common::Status background_call_recycle();
   void schedule_background_recycle();
@@ -1704,11 +1736,17 @@ protected:
   // number of background ebr jobs, submitted to the high pool
   int bg_ebr_scheduled_;
 
+  // number of cache prewarm jobs, submitted to the low pool, at most one
+  // after open
+  int bg_cache_prewarm_scheduled_;
+
 //  util::TimerService *timer_service_;
 //  util::Timer *gc_timer_;
 //  util::Timer *cache_purge_timer_;
 //  util::Timer *shrink_timer_;
   std::atomic<bool> shrink_running_;
+  // progress of the running or the last shrink job, protected by mutex_
+  storage::ShrinkProgress shrink_progress_;
 
   //max sequence number among all recovery point after recovery sst data
   common::SequenceNumber max_seq_in_rp_;
@@ -153,6 +153,7 @@ int DBImpl::run_one_flush_task(ColumnFamilyData *sub_table,
   if (storage::INVALID_EVENT != event) {
     MiniTables mtables;
     mtables.space_manager = sub_table->get_extent_space_manager();
+    mtables.separate_values = sub_table->can_separate_values();
     if (FAILED(flush_job->prepare_flush_task(mtables))){
       XENGINE_LOG(WARN, "failed to prepare flush task", K(ret));
     } else {
@@ -229,6 +230,7 @@ Status DBImpl::FlushMemTableToOutputFile(
   context.task_type_ = st_flush_job.get_task_type();
   context.storage_logger_ = storage_logger_;
   context.enable_thread_tracking_ = immutable_db_options_.enable_thread_tracking;
+  context.separate_values_ = sub_table->can_separate_values();
   context.output_level_  = FLUSH_LEVEL1_TASK == st_flush_job.get_task_type() ? 1 : 0;
   job_context.task_type_ = st_flush_job.get_task_type();
   job_context.output_level_ = context.output_level_;
@@ -1506,13 +1508,28 @@ int DBImpl::shrink_extent_space(const ShrinkInfo &shrink_info)
 {
   int ret = Status::kOk;
   storage::ShrinkJob *shrink_job = nullptr;
+  int64_t round_extent_count = 0;
+  int64_t rate_limit = 0;
+
+  mutex_.Lock();
+  round_extent_count = mutable_db_options_.shrink_round_extent_count;
+  rate_limit = mutable_db_options_.shrink_rate_limit;
+  shrink_progress_.reset();
+  mutex_.Unlock();
+  if (0 == round_extent_count) {
+    round_extent_count = INT64_MAX;
+  }
 
   if (IS_NULL(shrink_job = MOD_NEW_OBJECT(ModId::kShrinkJob, ShrinkJob))) {
     ret = Status::kMemoryLimit;
     XENGINE_LOG(WARN, "fail to allocate memory for ShrinkJob", K(ret));
   } else if (FAILED(shrink_job->init(&mutex_,
                                      versions_->get_global_ctx(),
-                                     shrink_info))) {
+                                     shrink_info,
+                                     round_extent_count,
+                                     rate_limit,
+                                     &shrink_progress_,
+                                     &shutting_down_))) {
     XENGINE_LOG(WARN, "fail to init shrink job", K(ret));
   } else if (FAILED(shrink_job->run())) {
         XENGINE_LOG(WARN, "fail  to run shrink job", K(ret));
@@ -2144,6 +2161,7 @@ Status DBImpl::build_compaction_job(LogBuffer* log_buffer,
   context.storage_logger_ = storage_logger_;
   context.enable_thread_tracking_ = immutable_db_options_.enable_thread_tracking;
   context.need_check_snapshot_ = cf_job.need_check_snapshot_;
+  context.separate_values_ = cfd->can_separate_values();
   storage::ColumnFamilyDesc cf_desc((int32_t)cfd->GetID(), cfd->GetName());
   const CompactionTasksPicker &task_picker = cfd->get_task_picker();
   CompactionTasksPicker::TaskInfo &task_info = cf_job.task_info_;
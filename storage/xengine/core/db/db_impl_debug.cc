@@ -108,6 +108,31 @@ void DBImpl::TEST_wait_for_filter_build() {
   }
 }
 
+int DBImpl::TEST_dump_subtable(ColumnFamilyData *sub_table) {
+  int ret = Status::kOk;
+  bool do_dump = false;
+  InstrumentedMutexLock l(&mutex_);
+  if (FAILED(build_dump_job(sub_table, do_dump))) {
+    XENGINE_LOG(WARN, "failed to build dump job", K(ret));
+  } else if (!do_dump) {
+    ret = Status::kTryAgain;
+  } else {
+    maybe_schedule_dump();
+    while ((unscheduled_dumps_ > 0 || bg_dump_scheduled_ > 0) && bg_error_.ok()) {
+      bg_cv_.Wait();
+    }
+    ret = bg_error_.code();
+  }
+  return ret;
+}
+
+void DBImpl::TEST_wait_for_cache_prewarm() {
+  InstrumentedMutexLock l(&mutex_);
+  while (bg_cache_prewarm_scheduled_) {
+    bg_cv_.Wait();
+  }
+}
+
 void DBImpl::TEST_LockMutex() { mutex_.Lock(); }
 
 void DBImpl::TEST_UnlockMutex() { mutex_.Unlock(); }
@@ -15,6 +15,7 @@
 #include <inttypes.h>
 #include <thread>
 
+#include "cache/cache_prewarm.h"
 #include "db/builder.h"
 #include "db/debug_info.h"
 #include "db/replay_task.h"
@@ -127,6 +128,11 @@ DBOptions SanitizeOptions(const std::string& dbname, const DBOptions& src) {
     result.new_table_reader_for_compaction_inputs = true;
   }
 
+  if (result.cache_prewarm_max_entries > 0 && !result.hot_cache_tracker) {
+    result.hot_cache_tracker = std::make_shared<cache::HotCacheTracker>(
+        result.cache_prewarm_max_entries);
+  }
+
   return result;
 }
 
@@ -2226,6 +2232,7 @@ Status DB::Open(const DBOptions& db_options, const std::string& dbname,
     impl->opened_successfully_ = true;
     impl->MaybeScheduleFlushOrCompaction();
     impl->schedule_master_thread();
+    impl->schedule_cache_prewarm();
 //    if (FAILED(impl->init_cache_purge_timer())) {
 //      s = Status(ret);
 //      XENGINE_LOG(WARN, "failed init cache purge timer", K(ret));
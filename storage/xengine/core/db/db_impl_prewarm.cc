@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2020, Alibaba Group Holding Limited
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "db/db_impl.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include "cache/cache_prewarm.h"
+#include "db/table_cache.h"
+#include "monitoring/iostats_context_imp.h"
+#include "table/sstable_scan_struct.h"
+#include "util/aio_wrapper.h"
+#include "util/coding.h"
+#include "util/sync_point.h"
+#include "xengine/rate_limiter.h"
+
+using namespace xengine;
+using namespace common;
+using namespace util;
+using namespace table;
+using namespace cache;
+using namespace storage;
+using namespace monitor;
+
+namespace xengine {
+namespace db {
+
+namespace {
+// blocks (or rows) warmed up together, reads of one batch are in flight at
+// the same time
+const int64_t CACHE_PREWARM_BATCH_SIZE = 64;
+
+void throttle_cache_prewarm(RateLimiter *rate_limiter, int64_t bytes)
+{
+  if (nullptr != rate_limiter) {
+    while (bytes > 0) {
+      int64_t request_bytes = std::min(bytes, rate_limiter->GetSingleBurstBytes());
+      rate_limiter->Request(request_bytes, Env::IO_LOW, nullptr /* stats */);
+      bytes -= request_bytes;
+    }
+  }
+}
+} // namespace
+
+void DBImpl::schedule_cache_prewarm()
+{
+  mutex_.AssertHeld();
+  if (nullptr == immutable_db_options_.hot_cache_tracker) {
+    // cache prewarm is disabled
+  } else if (shutting_down_.load(std::memory_order_acquire)) {
+    // DB is being deleted; no more background prewarm
+  } else if (0 == bg_cache_prewarm_scheduled_) {
+    bg_cache_prewarm_scheduled_ = 1;
+    // no tag, ~DBImpl waits for the job instead of unscheduling it
+    env_->Schedule(&DBImpl::bg_work_cache_prewarm, this, Env::Priority::LOW, nullptr);
+  }
+}
+
+void DBImpl::bg_work_cache_prewarm(void *db)
+{
+  IOSTATS_SET_THREAD_POOL_ID(Env::Priority::LOW);
+  TEST_SYNC_POINT("DBImpl::bg_work_cache_prewarm");
+  reinterpret_cast<DBImpl *>(db)->background_call_cache_prewarm();
+  TEST_SYNC_POINT("DBImpl::bg_work_cache_prewarm:done");
+}
+
+void DBImpl::background_call_cache_prewarm()
+{
+  int ret = Status::kOk;
+  HotCacheTracker *tracker = immutable_db_options_.hot_cache_tracker.get();
+  std::string fname = CachePrewarmFileName(dbname_);
+  std::vector<HotBlock> blocks;
+  std::vector<HotRow> rows;
+  std::unique_ptr<RateLimiter> rate_limiter;
+  uint64_t start_ts = env_->NowMicros();
+
+  if (ISNULL(tracker)) {
+    ret = Status::kErrorUnexpected;
+    XENGINE_LOG(WARN, "hot cache tracker is nullptr", K(ret));
+  } else if (!env_->FileExists(fname).ok()) {
+    XENGINE_LOG(INFO, "no cache prewarm file, start with cold caches", K(fname));
+  } else if (FAILED(HotCacheTracker::load(env_, fname, blocks, rows))) {
+    XENGINE_LOG(WARN, "failed to load cache prewarm file", K(ret), K(fname));
+  } else {
+    // what was hot before the restart stays tracked until the foreground
+    // reads it again, otherwise the next dump would forget about it
+    tracker->restore(blocks, rows);
+    if (mutable_db_options_.cache_prewarm_rate_limit > 0) {
+      rate_limiter.reset(NewGenericRateLimiter(
+          static_cast<int64_t>(mutable_db_options_.cache_prewarm_rate_limit)));
+    }
+    if (FAILED(prewarm_block_cache(blocks, rate_limiter.get()))) {
+      XENGINE_LOG(WARN, "failed to prewarm block cache", K(ret));
+    } else if (FAILED(prewarm_row_cache(rows, rate_limiter.get()))) {
+      XENGINE_LOG(WARN, "failed to prewarm row cache", K(ret));
+    } else {
+      XENGINE_LOG(INFO, "finish cache prewarm", "block_count", blocks.size(),
+                  "row_count", rows.size(),
+                  "cost_us", env_->NowMicros() - start_ts);
+    }
+  }
+
+  InstrumentedMutexLock lock_guard(&mutex_);
+  bg_cache_prewarm_scheduled_ = 0;
+  bg_cv_.SignalAll();
+}
+
+int DBImpl::dump_hot_cache_entries()
+{
+  int ret = Status::kOk;
+  HotCacheTracker *tracker = immutable_db_options_.hot_cache_tracker.get();
+  if (nullptr != tracker) {
+    if (FAILED(tracker->dump(env_, CachePrewarmFileName(dbname_)))) {
+      XENGINE_LOG(WARN, "failed to dump hot cache entries", K(ret));
+    }
+  }
+  return ret;
+}
+
+// The blocks come hottest first. They are only read through the subtable
+// whose current version references their extent, with its table cache and
+// comparator, while that version is pinned so the extent can't be recycled
+// and reused under the reads. Extents that no subtable references anymore
+// were compacted away since the dump and are skipped. The subtables are
+// warmed up in the order of their hottest block.
+int DBImpl::prewarm_block_cache(std::vector<HotBlock> &blocks,
+                                RateLimiter *rate_limiter)
+{
+  int ret = Status::kOk;
+  if (nullptr == block_cache_ || blocks.empty()) {
+    return ret;
+  }
+  std::unordered_map<int64_t, size_t> extent_rank; // hottest block per extent
+  std::unordered_map<int64_t, int64_t> extent_owner;
+  std::vector<std::pair<size_t, int64_t>> owners;  // hottest block, subtable
+  std::unordered_map<int64_t, std::vector<HotBlock>> owned_blocks;
+  std::unordered_set<int64_t> extent_ids;
+  uint64_t add_blocks = 0;
+  int64_t skipped_count = 0;
+
+  for (size_t i = blocks.size(); i > 0; --i) {
+    extent_rank[blocks[i - 1].extent_id_] = i - 1;
+  }
+  {
+    AllSubTableGuard all_sub_table_guard(versions_->get_global_ctx());
+    for (const auto &entry : all_sub_table_guard.get_subtable_map()) {
+      ColumnFamilyData *sub_table = entry.second;
+      if (nullptr == sub_table || sub_table->IsDropped()) {
+        continue;
+      }
+      const Snapshot *meta_snapshot = sub_table->get_meta_snapshot();
+      extent_ids.clear();
+      int tmp_ret = get_meta_snapshot_extent_ids(meta_snapshot, extent_ids);
+      sub_table->release_meta_snapshot(meta_snapshot);
+      if (Status::kOk != tmp_ret) {
+        XENGINE_LOG(WARN, "failed to get extents of subtable for prewarm",
+                    K(tmp_ret), "index_id", entry.first);
+        continue;
+      }
+      size_t rank = blocks.size();
+      for (int64_t extent_id : extent_ids) {
+        auto iter = extent_rank.find(extent_id);
+        if (extent_rank.end() != iter
+            && extent_owner.emplace(extent_id, entry.first).second) {
+          rank = std::min(rank, iter->second);
+        }
+      }
+      if (rank < blocks.size()) {
+        owners.emplace_back(rank, entry.first);
+      }
+    }
+  }
+  for (const HotBlock &block : blocks) {
+    auto iter = extent_owner.find(block.extent_id_);
+    if (extent_owner.end() == iter) {
+      ++skipped_count;
+    } else {
+      owned_blocks[iter->second].push_back(block);
+    }
+  }
+  std::sort(owners.begin(), owners.end());
+
+  for (size_t i = 0; SUCCED(ret) && i < owners.size() && !db_shutting_down(); ++i) {
+    std::vector<HotBlock> &sub_table_blocks = owned_blocks[owners[i].second];
+    AllSubTableGuard all_sub_table_guard(versions_->get_global_ctx());
+    const SubTableMap &sub_table_map = all_sub_table_guard.get_subtable_map();
+    auto iter = sub_table_map.find(owners[i].second);
+    if (sub_table_map.end() == iter
+        || nullptr == iter->second
+        || iter->second->IsDropped()) {
+      skipped_count += sub_table_blocks.size();
+      continue;
+    }
+    ColumnFamilyData *sub_table = iter->second;
+    const Snapshot *meta_snapshot = sub_table->get_meta_snapshot();
+    extent_ids.clear();
+    if (FAILED(get_meta_snapshot_extent_ids(meta_snapshot, extent_ids))) {
+      XENGINE_LOG(WARN, "failed to get extents of subtable for prewarm", K(ret),
+                  "index_id", owners[i].second);
+    } else {
+      prewarm_sub_table_blocks(sub_table, extent_ids, sub_table_blocks,
+                               rate_limiter, add_blocks, skipped_count);
+    }
+    sub_table->release_meta_snapshot(meta_snapshot);
+  }
+  XENGINE_LOG(INFO, "prewarm block cache", "block_count", blocks.size(),
+              K(add_blocks), K(skipped_count));
+  return ret;
+}
+
+int DBImpl::get_meta_snapshot_extent_ids(const Snapshot *meta_snapshot,
+                                         std::unordered_set<int64_t> &extent_ids)
+{
+  int ret = Status::kOk;
+  util::autovector<ExtentId> level_extent_ids;
+  ExtentLayerVersion *extent_layer_version = nullptr;
+
+  for (int64_t level = 0; SUCCED(ret) && level < storage::MAX_TIER_COUNT; ++level) {
+    level_extent_ids.clear();
+    if (nullptr == (extent_layer_version = meta_snapshot->get_extent_layer_version(level))) {
+      // no such level
+    } else if (FAILED(extent_layer_version->get_all_extent_ids(level_extent_ids))) {
+      XENGINE_LOG(WARN, "failed to get extent ids", K(ret), K(level));
+    } else {
+      for (size_t i = 0; i < level_extent_ids.size(); ++i) {
+        extent_ids.insert(level_extent_ids[i].id());
+      }
+    }
+  }
+  return ret;
+}
+
+// Called with the current version of the subtable pinned, extent_ids are
+// the extents it references. Each batch keeps the hottest first order
+// against the following batches, inside of it the blocks are sorted by
+// extent and offset, all the reads missing the cache are sent
+// asynchronously and then waited for one by one while the blocks are put
+// into the cache.
+void DBImpl::prewarm_sub_table_blocks(ColumnFamilyData *sub_table,
+                                      const std::unordered_set<int64_t> &extent_ids,
+                                      std::vector<HotBlock> &blocks,
+                                      RateLimiter *rate_limiter,
+                                      uint64_t &add_blocks,
+                                      int64_t &skipped_count)
+{
+  TableCache *table_cache = sub_table->table_cache();
+  ReadOptions read_options;
+  TableReaderHandle readers[CACHE_PREWARM_BATCH_SIZE];
+  BlockDataHandle<Block> handles[CACHE_PREWARM_BATCH_SIZE];
+  bool pending[CACHE_PREWARM_BATCH_SIZE];
+  BlockIter data_block_iter;
+
+  for (size_t start = 0;
+       start < blocks.size() && !db_shutting_down();
+       start += CACHE_PREWARM_BATCH_SIZE) {
+    size_t end = std::min(start + CACHE_PREWARM_BATCH_SIZE, blocks.size());
+    std::sort(blocks.begin() + start, blocks.begin() + end,
+              [](const HotBlock &a, const HotBlock &b) {
+                return a.extent_id_ < b.extent_id_
+                       || (a.extent_id_ == b.extent_id_ && a.offset_ < b.offset_);
+              });
+    int64_t batch_bytes = 0;
+    for (size_t i = start; i < end; ++i) {
+      const HotBlock &block = blocks[i];
+      TableReaderHandle &reader = readers[i - start];
+      BlockDataHandle<Block> &handle = handles[i - start];
+      int tmp_ret = Status::kOk;
+      pending[i - start] = false;
+      if (block.offset_ + block.size_ + kBlockTrailerSize > (uint64_t)MAX_EXTENT_SIZE
+          || 0 == extent_ids.count(block.extent_id_)) {
+        ++skipped_count;
+        continue;
+      }
+      FileDescriptor fd(block.extent_id_, 0, MAX_EXTENT_SIZE);
+      reader.extent_id_ = fd.extent_id;
+      if (Status::kOk != (tmp_ret = table_cache->FindTable(env_options_,
+                                                           sub_table->internal_comparator(),
+                                                           fd,
+                                                           &reader.cache_handle_,
+                                                           false /* no_io */,
+                                                           false /* record_read_stats */).code())) {
+        ++skipped_count;
+        XENGINE_LOG(DEBUG, "failed to open extent for prewarm", K(tmp_ret), K(fd.extent_id));
+        continue;
+      }
+      reader.table_cache_ = table_cache;
+      reader.table_reader_ = table_cache->GetTableReaderFromHandle(reader.cache_handle_);
+      handle.extent_id_ = fd.extent_id;
+      handle.block_handle_.set_offset(block.offset_);
+      handle.block_handle_.set_size(block.size_);
+      if (Status::kOk != (tmp_ret = reader.reader()->prefetch_data_block(read_options, handle))) {
+        ++skipped_count;
+        XENGINE_LOG(DEBUG, "failed to lookup block for prewarm", K(tmp_ret), K(fd.extent_id));
+      } else if (nullptr == handle.block_entry_.value) {
+        handle.aio_handle_.aio_req_.reset(new AIOReq());
+        if (Status::kOk != (tmp_ret = reader.reader()->do_io_prefetch(
+                block.offset_, block.size_ + kBlockTrailerSize, &handle.aio_handle_))) {
+          ++skipped_count;
+          XENGINE_LOG(DEBUG, "failed to prefetch block", K(tmp_ret), K(fd.extent_id));
+        } else {
+          pending[i - start] = true;
+          batch_bytes += block.size_ + kBlockTrailerSize;
+        }
+      }
+    }
+    throttle_cache_prewarm(rate_limiter, batch_bytes);
+
+    for (size_t i = start; i < end; ++i) {
+      int tmp_ret = Status::kOk;
+      if (pending[i - start]
+          && Status::kOk != (tmp_ret = readers[i - start].reader()->new_data_block_iterator(
+                  read_options, handles[i - start], data_block_iter,
+                  &add_blocks, std::numeric_limits<uint64_t>::max()))) {
+        ++skipped_count;
+        XENGINE_LOG(DEBUG, "failed to load block for prewarm", K(tmp_ret),
+                    K(readers[i - start].extent_id_));
+      }
+      handles[i - start].reset();
+      readers[i - start].reset();
+    }
+  }
+}
+
+// Rows are read through the normal point get path, which puts them into the
+// row cache, and brings their data blocks along into the block cache.
+int DBImpl::prewarm_row_cache(const std::vector<HotRow> &rows,
+                              RateLimiter *rate_limiter)
+{
+  int ret = Status::kOk;
+  if (nullptr == immutable_db_options_.row_cache || rows.empty()) {
+    return ret;
+  }
+  ReadOptions read_options;
+  ColumnFamilyHandleInternal cf_handle;
+  PinnableSlice value;
+  int64_t warmed_count = 0;
+
+  for (size_t start = 0;
+       SUCCED(ret) && start < rows.size() && !db_shutting_down();
+       start += CACHE_PREWARM_BATCH_SIZE) {
+    size_t end = std::min(start + CACHE_PREWARM_BATCH_SIZE, rows.size());
+    int64_t batch_bytes = 0;
+    {
+      AllSubTableGuard all_sub_table_guard(versions_->get_global_ctx());
+      const SubTableMap &sub_table_map = all_sub_table_guard.get_subtable_map();
+      for (size_t i = start; i < end; ++i) {
+        Slice key(rows[i].key_);
+        uint32_t sub_table_id = 0;
+        if (!GetVarint32(&key, &sub_table_id)) {
+          continue;
+        }
+        auto iter = sub_table_map.find(sub_table_id);
+        if (sub_table_map.end() == iter
+            || nullptr == iter->second
+            || iter->second->IsDropped()) {
+          continue;
+        }
+        cf_handle.SetCFD(iter->second);
+        value.Reset();
+        if (GetImpl(read_options, &cf_handle, key, &value).ok()) {
+          ++warmed_count;
+          batch_bytes += key.size() + value.size();
+        }
+      }
+    }
+    throttle_cache_prewarm(rate_limiter, batch_bytes);
+  }
+  XENGINE_LOG(INFO, "prewarm row cache", "row_count", rows.size(), K(warmed_count));
+  return ret;
+}
+
+}  // namespace db
+}  // namespace xengine
@@ -9,6 +9,8 @@
 
 #include "db/db_test_util.h"
 #include "db/memtable.h"
+#include "db/merge_context.h"
+#include "db/range_del_aggregator.h"
 #include "port/stack_trace.h"
 #include "xengine/memtablerep.h"
 #include "xengine/slice_transform.h"
@@ -163,6 +165,118 @@ TEST_F(DBMemTableTest, InsertWithHint) {
   ASSERT_EQ("bar_v2", Get("bar_k2"));
   ASSERT_EQ("vvv", Get("whitelisted"));
 }
+
+TEST_F(DBMemTableTest, HashIndexSkipList) {
+  Options options;
+  options.create_if_missing = true;
+  options.allow_concurrent_memtable_write = true;
+  options.memtable_prefix_bloom_size_ratio = 0.1;
+  options.env = env_;
+  Reopen(options);
+
+  // not supporting concurrent inserts, refused
+  ColumnFamilyHandle* cf = db_->DefaultColumnFamily();
+  ASSERT_NOK(dbfull()->SetOptions(cf, {{"memtable", "prefix_hash"}}));
+  // small bucket count to get chains with several user keys
+  ASSERT_OK(dbfull()->SetOptions(cf, {{"memtable", "hash_index:8"}}));
+  ASSERT_EQ(std::string("HashIndexSkipListRepFactory"),
+            db_->GetOptions(cf).memtable_factory->Name());
+  // takes effect from the next memtable
+  ASSERT_OK(Flush());
+
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_OK(Put("key" + ToString(i), "v1_" + ToString(i)));
+  }
+  const Snapshot* snapshot = db_->GetSnapshot();
+  for (int i = 0; i < 100; i += 2) {
+    ASSERT_OK(Put("key" + ToString(i), "v2_" + ToString(i)));
+  }
+  for (int i = 0; i < 100; i += 10) {
+    ASSERT_OK(Delete("key" + ToString(i)));
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    const std::string key = "key" + ToString(i);
+    if (i % 10 == 0) {
+      ASSERT_EQ("NOT_FOUND", Get(key));
+    } else if (i % 2 == 0) {
+      ASSERT_EQ("v2_" + ToString(i), Get(key));
+    } else {
+      ASSERT_EQ("v1_" + ToString(i), Get(key));
+    }
+    ASSERT_EQ("v1_" + ToString(i), Get(key, snapshot));
+  }
+  ASSERT_EQ("NOT_FOUND", Get("key100"));
+  db_->ReleaseSnapshot(snapshot);
+
+  // scans go through the ordered skip list
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+  int count = 0;
+  std::string prev;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ASSERT_LT(prev, iter->key().ToString());
+    prev = iter->key().ToString();
+    ++count;
+  }
+  ASSERT_EQ(90, count);
+  iter->Seek("key55");
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ("key55", iter->key().ToString());
+
+  ASSERT_OK(dbfull()->SetOptions(cf, {{"memtable", "skip_list"}}));
+  ASSERT_OK(Flush());
+  ASSERT_EQ("v2_2", Get("key2"));
+}
+
+TEST_F(DBMemTableTest, HashIndexVersionsOutOfOrder) {
+  // concurrent writers may insert the versions of a key in any sequence
+  // order, a single bucket also puts all the keys in one chain
+  InternalKeyComparator cmp(BytewiseComparator());
+  Options options;
+  options.memtable_factory.reset(NewHashIndexSkipListRepFactory(1));
+  ImmutableCFOptions ioptions(options);
+  WriteBufferManager wb(options.db_write_buffer_size);
+  MemTable* mem = new MemTable(cmp, ioptions, MutableCFOptions(options), &wb,
+                               kMaxSequenceNumber);
+  mem->Ref();
+  MemTablePostProcessInfo post_process_info;
+
+  const SequenceNumber seqs[] = {5, 1, 9, 3, 7};
+  for (SequenceNumber seq : seqs) {
+    mem->Add(seq, kTypeValue, "k2", "k2_v" + ToString(seq), true,
+             &post_process_info);
+    mem->Add(seq + 1, kTypeValue, "k1", "k1_v" + ToString(seq + 1), true,
+             &post_process_info);
+  }
+  mem->Add(4, kTypeDeletion, "k2", "", true, &post_process_info);
+
+  auto get = [&](const std::string& key, SequenceNumber snapshot) {
+    LookupKey lkey(key, snapshot);
+    std::string value;
+    Status s;
+    MergeContext merge_context;
+    RangeDelAggregator range_del_agg(cmp, snapshot);
+    if (!mem->Get(lkey, &value, &s, &merge_context, &range_del_agg,
+                  ReadOptions())) {
+      return std::string("MISS");
+    }
+    return s.IsNotFound() ? std::string("NOT_FOUND") : value;
+  };
+
+  ASSERT_EQ("MISS", get("k2", 0));
+  ASSERT_EQ("k2_v1", get("k2", 1));
+  ASSERT_EQ("k2_v3", get("k2", 3));
+  ASSERT_EQ("NOT_FOUND", get("k2", 4));
+  ASSERT_EQ("k2_v5", get("k2", 6));
+  ASSERT_EQ("k2_v9", get("k2", kMaxSequenceNumber));
+  ASSERT_EQ("MISS", get("k1", 1));
+  ASSERT_EQ("k1_v6", get("k1", 7));
+  ASSERT_EQ("k1_v10", get("k1", kMaxSequenceNumber));
+  ASSERT_EQ("MISS", get("k0", kMaxSequenceNumber));
+  ASSERT_EQ("MISS", get("k3", kMaxSequenceNumber));
+
+  delete mem->Unref();
+}
 }
 }  // namespace xengine
 
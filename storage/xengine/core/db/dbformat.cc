@@ -18,6 +18,7 @@
 #include "monitoring/query_perf_context.h"
 #include "port/port.h"
 #include "storage/extent_space_manager.h"
+#include "util/aligned_buffer.h"
 #include "util/coding.h"
 #include "util/serialization.h"
 #include "util/string_util.h"
@@ -35,24 +36,77 @@ using namespace xengine;
 int64_t LargeValue::get_serialize_size() const {
   int64_t ret = util::get_serialize_size(version_, compression_type_, size_) +
                 util::get_serialize_v_size(oob_extents_);
+  if (in_value_extent()) {
+    ret += util::get_serialize_size(offset_);
+  }
   return ret;
 }
 
 int LargeValue::serialize(char *buffer, int64_t bufsiz, int64_t &pos) const {
   int ret = util::serialize(buffer, bufsiz, pos, version_, compression_type_, size_) ||
             util::serialize_v(buffer, bufsiz, pos, oob_extents_);
+  if (Status::kOk == ret && in_value_extent()) {
+    ret = util::serialize(buffer, bufsiz, pos, offset_);
+  }
   return ret;
 }
 
 int LargeValue::deserialize(const char *buffer, int64_t bufsiz, int64_t &pos) {
   oob_extents_.clear();
+  offset_ = 0;
   int ret = util::deserialize(buffer, bufsiz, pos, version_, compression_type_, size_) ||
             util::deserialize_v(buffer, bufsiz, pos, oob_extents_);
+  if (Status::kOk == ret && in_value_extent()) {
+    ret = util::deserialize(buffer, bufsiz, pos, offset_);
+  }
   return ret;
 }
 
 DEFINE_SERIALIZATION(LargeObject, key_, value_);
 
+// Only the pages holding the value are read, the value is then moved to the
+// start of oob_uptr, where the callers expect it.
+static int get_value_extent_value(storage::ExtentSpaceManager *space_manager,
+                                  const db::LargeValue& large_value,
+                                  std::unique_ptr<char[], void(&)(void *)>& oob_uptr,
+                                  size_t& oob_size) {
+  int ret = Status::kOk;
+  const uint64_t page_size = 4096;
+  uint64_t read_offset = large_value.offset_ & ~(page_size - 1);
+  uint64_t read_size = util::Roundup(large_value.offset_ + large_value.size_, page_size) - read_offset;
+  if (1 != large_value.oob_extents_.size()
+      || read_offset + read_size > (uint64_t)storage::MAX_EXTENT_SIZE) {
+    __XENGINE_LOG(ERROR, "corrupted value extent pointer\n");
+    return Status::kCorruption;
+  }
+  if (read_size > oob_size) {
+    oob_uptr.reset((char *)base_memalign(page_size, read_size, memory::ModId::kLargeObject));
+    if (!oob_uptr) {
+      oob_size = 0;
+      __XENGINE_LOG(ERROR, "cannot allocate momery to store large object\n");
+      return Status::kMemoryLimit;
+    }
+    oob_size = read_size;
+  }
+
+  storage::RandomAccessExtent extent;
+  Slice result;
+  if (Status::kOk != (ret = space_manager->get_random_access_extent(large_value.oob_extents_[0], extent).code())) {
+    __XENGINE_LOG(ERROR, "cannot get access extent for separated value");
+  } else if (Status::kOk != (ret = extent.Read(read_offset, read_size, &result, oob_uptr.get()).code())) {
+    __XENGINE_LOG(ERROR, "cannot read extent for separated value");
+  } else if (result.size() < read_size) {
+    ret = Status::kCorruption;
+    __XENGINE_LOG(ERROR, "short read of separated value");
+  } else {
+    if (result.data() != oob_uptr.get()) {
+      memcpy(oob_uptr.get(), result.data(), read_size);
+    }
+    memmove(oob_uptr.get(), oob_uptr.get() + (large_value.offset_ - read_offset), large_value.size_);
+  }
+  return ret;
+}
+
 int get_oob_large_value(const Slice& value_in_kv,
                         storage::ExtentSpaceManager *space_manager,
                         db::LargeValue& large_value,
@@ -66,6 +120,10 @@ int get_oob_large_value(const Slice& value_in_kv,
     return ret;
   }
 
+  if (large_value.in_value_extent()) {
+    return get_value_extent_value(space_manager, large_value, oob_uptr, oob_size);
+  }
+
   size_t req_size = oob_extents.size() * storage::MAX_EXTENT_SIZE;
   if (req_size > oob_size) {
     oob_uptr.reset((char *)base_memalign(4096, req_size, memory::ModId::kLargeObject));
@@ -87,10 +87,16 @@ inline bool IsValueOrLargeType(ValueType t) {
 struct LargeValue {
   static const int32_t COMPRESSION_FORMAT_VERSION = 2;
   static const int32_t LATEST_VERSION = 0;
+  // the value shares its extent with other separated values, it is stored at
+  // offset_ of the only extent in oob_extents_
+  static const int32_t VALUE_EXTENT_VERSION = 1;
   int32_t version_;  // version of this structure
   int32_t compression_type_;
   uint64_t size_;    // size of the zipped (if applied) value
   util::autovector<storage::ExtentId> oob_extents_;
+  uint64_t offset_;  // only serialized since VALUE_EXTENT_VERSION
+
+  bool in_value_extent() const { return version_ >= VALUE_EXTENT_VERSION; }
 
   DECLARE_SERIALIZATION();
 };
@@ -183,6 +183,42 @@ TEST_F(FormatTest, IterKeyOperation) {
                         "abcdefghijklmnopqrstuvwxyz"));
 }
 
+TEST_F(FormatTest, LargeValueSerialize) {
+  char buf[128];
+  LargeValue large_value;
+  large_value.version_ = LargeValue::LATEST_VERSION;
+  large_value.compression_type_ = kNoCompression;
+  large_value.size_ = 3 * 1024 * 1024;
+  large_value.oob_extents_.push_back(ExtentId(1, 2));
+  large_value.oob_extents_.push_back(ExtentId(1, 3));
+  int64_t pos = 0;
+  ASSERT_EQ(Status::kOk, large_value.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(large_value.get_serialize_size(), pos);
+
+  LargeValue decoded;
+  pos = 0;
+  ASSERT_EQ(Status::kOk, decoded.deserialize(buf, sizeof(buf), pos));
+  ASSERT_FALSE(decoded.in_value_extent());
+  ASSERT_EQ(0, decoded.offset_);
+  ASSERT_EQ(2, decoded.oob_extents_.size());
+
+  // a value packed into a value extent also carries its offset
+  large_value.version_ = LargeValue::VALUE_EXTENT_VERSION;
+  large_value.size_ = 8192;
+  large_value.oob_extents_.pop_back();
+  large_value.offset_ = 12345;
+  pos = 0;
+  ASSERT_EQ(Status::kOk, large_value.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(large_value.get_serialize_size(), pos);
+  pos = 0;
+  ASSERT_EQ(Status::kOk, decoded.deserialize(buf, sizeof(buf), pos));
+  ASSERT_TRUE(decoded.in_value_extent());
+  ASSERT_EQ(8192, decoded.size_);
+  ASSERT_EQ(12345, decoded.offset_);
+  ASSERT_EQ(1, decoded.oob_extents_.size());
+  ASSERT_EQ(ExtentId(1, 2).id(), decoded.oob_extents_[0].id());
+}
+
 TEST_F(FormatTest, UpdateInternalKey) {
   std::string user_key("abcdefghijklmnopqrstuvwxyz");
   uint64_t new_seq = 0x123456;
@@ -295,7 +295,8 @@ int BaseFlush::delete_old_M0(const InternalKeyComparator *internal_comparator, M
       for (int32_t i = 0; i < dump_layer->lob_extent_arr_.size() && SUCC(ret); i++) {
         lob_extent_meta = dump_layer->lob_extent_arr_.at(i);
         FLUSH_LOG(INFO, "delete large object extent for dump", K(cfd_->GetID()), "extent_id", lob_extent_meta->extent_id_);
-        if (FAILED(mtables.change_info_->delete_large_object_extent(lob_extent_meta->extent_id_))) {
+        // the whole value extent goes, none of the values in it survive the dump
+        if (FAILED(mtables.change_info_->drop_large_object_extent(lob_extent_meta->extent_id_))) {
           FLUSH_LOG(WARN, "failed to delete large object extent", K(ret), K(i));
         }
       }
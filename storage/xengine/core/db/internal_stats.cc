@@ -324,6 +324,7 @@ static const std::string current_version_number =
 static const std::string estimate_live_data_size = "estimate-live-data-size";
 static const std::string min_log_number_to_keep = "min-log-number-to-keep";
 static const std::string base_level = "base-level";
+static const std::string value_extent_live_ratio = "value-extent-live-ratio";
 static const std::string total_sst_files_size = "total-sst-files-size";
 static const std::string estimate_pending_comp_bytes =
     "estimate-pending-compaction-bytes";
@@ -425,6 +426,8 @@ const std::string DB::Properties::kMinLogNumberToKeep =
 const std::string DB::Properties::kTotalSstFilesSize =
     rocksdb_prefix + total_sst_files_size;
 const std::string DB::Properties::kBaseLevel = rocksdb_prefix + base_level;
+const std::string DB::Properties::kValueExtentLiveRatio =
+    rocksdb_prefix + value_extent_live_ratio;
 const std::string DB::Properties::kEstimatePendingCompactionBytes =
     rocksdb_prefix + estimate_pending_comp_bytes;
 const std::string DB::Properties::kAggregatedTableProperties =
@@ -540,6 +543,8 @@ const std::unordered_map<std::string, DBPropertyInfo>
          {false, nullptr, &InternalStats::HandleMinLogNumberToKeep, nullptr}},
         {DB::Properties::kBaseLevel,
          {false, nullptr, &InternalStats::HandleBaseLevel, nullptr}},
+        {DB::Properties::kValueExtentLiveRatio,
+         {false, nullptr, &InternalStats::HandleValueExtentLiveRatio, nullptr}},
         {DB::Properties::kTotalSstFilesSize,
          {false, nullptr, &InternalStats::HandleTotalSstFilesSize, nullptr}},
         {DB::Properties::kEstimatePendingCompactionBytes,
@@ -964,6 +969,12 @@ bool InternalStats::HandleBaseLevel(uint64_t* value, DBImpl* db)
   return true;
 }
 
+bool InternalStats::HandleValueExtentLiveRatio(uint64_t* value, DBImpl* db)
+{
+  *value = static_cast<uint64_t>(cfd_->get_storage_manager()->get_lob_live_ratio());
+  return true;
+}
+
 bool InternalStats::HandleTotalSstFilesSize(uint64_t* value, DBImpl* db)
 {
   return true;
@@ -499,6 +499,7 @@ class InternalStats {
   bool HandleCurrentSuperVersionNumber(uint64_t* value, DBImpl* db);
   bool HandleIsFileDeletionsEnabled(uint64_t* value, DBImpl* db);
   bool HandleBaseLevel(uint64_t* value, DBImpl* db);
+  bool HandleValueExtentLiveRatio(uint64_t* value, DBImpl* db);
   bool HandleTotalSstFilesSize(uint64_t* value, DBImpl* db);
   bool HandleEstimatePendingCompactionBytes(uint64_t* value, DBImpl* db);
   bool HandleEstimateTableReadersMem(uint64_t* value, DBImpl* db);
@@ -105,8 +105,11 @@ MemTable::MemTable(const InternalKeyComparator& cmp,
              mutable_cf_options.memtable_huge_page_size,
              memory::ModId::kMemtable),
       allocator_(&arena_, write_buffer_manager),
-      table_(ioptions.memtable_factory->CreateMemTableRep(
-          comparator_, &allocator_, ioptions.prefix_extractor)),
+      table_((mutable_cf_options.memtable_factory
+                  ? mutable_cf_options.memtable_factory.get()
+                  : ioptions.memtable_factory)
+                 ->CreateMemTableRep(comparator_, &allocator_,
+                                     ioptions.prefix_extractor)),
       range_del_table_(SkipListFactory().CreateMemTableRep(
           comparator_, &allocator_, nullptr /* transform */)),
       is_range_del_table_empty_(true),
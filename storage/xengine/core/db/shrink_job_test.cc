@@ -38,6 +38,24 @@ public:
   ShrinkJobTest() : DBTestBase("shrink_job_test")
   {
   }
+
+  /**poll the shrink progress until the scheduled job has run to the end,
+  give up after timeout_us*/
+  bool wait_shrink_done(const uint64_t timeout_us = 30 * 1000 * 1000)
+  {
+    storage::ShrinkProgress shrink_progress;
+    uint64_t deadline = env_->NowMicros() + timeout_us;
+    while (env_->NowMicros() < deadline) {
+      shrink_progress.reset();
+      if (Status::kOk == db_->get_shrink_progress(shrink_progress)
+          && shrink_progress.start_time_ > 0
+          && !shrink_progress.running_) {
+        return true;
+      }
+      env_->SleepForMicroseconds(10 * 1000);
+    }
+    return false;
+  }
 };
 
 TEST_F(ShrinkJobTest, shrink_failed)
@@ -174,7 +192,58 @@ TEST_F(ShrinkJobTest, shrink_success)
   ASSERT_EQ(0, data_file_stats[0].free_extent_count_);
 }
 
-} // namespace 
+TEST_F(ShrinkJobTest, shrink_in_rounds)
+{
+  Options options;
+  options.create_if_missing = true;
+  options.env = env_;
+  options.wal_recovery_mode = WALRecoveryMode::kAbsoluteConsistency;
+  options.parallel_wal_recovery = false;
+  options.shrink_allocate_interval = 0;
+  options.max_free_extent_percent = 1;
+  options.shrink_round_extent_count = 1;
+
+  CreateAndReopenWithCF({"yuanfeng", "pinglan"}, options);
+  /**Insert data, generate three extents, [1, 1], [1, 2], [1, 3]*/
+  for (int i = 0; i < 60; ++i) {
+    std::string key = "zds" + std::to_string(i);
+    std::string value = "ppl" + std::to_string(i);
+    ASSERT_OK(Put(1, key, value));
+    if (19 == i % 20) {
+      Flush(1);
+    }
+  }
+
+  /**Intro level0 compaction, merge [1, 1],[1, 2],[1, 3] to [1, 4]*/
+  CompactRange(1, INTRA_COMPACTION_TASK);
+  sleep(5); //wait async compaction end
+
+  std::vector<storage::DataFileStatistics> data_file_stats;
+  test_get_data_file_stats(1, data_file_stats);
+  ASSERT_EQ(1, data_file_stats.size());
+  ASSERT_EQ(5, data_file_stats[0].total_extent_count_);
+  ASSERT_EQ(3, data_file_stats[0].free_extent_count_);
+
+  /**schedule shrink, one extent per round*/
+  schedule_shrink();
+  ASSERT_TRUE(wait_shrink_done());
+
+  /**check shrink result*/
+  data_file_stats.clear();
+  test_get_data_file_stats(1, data_file_stats);
+  ASSERT_EQ(1, data_file_stats.size());
+  ASSERT_EQ(2, data_file_stats[0].total_extent_count_);
+  ASSERT_EQ(0, data_file_stats[0].free_extent_count_);
+
+  storage::ShrinkProgress shrink_progress;
+  ASSERT_EQ(Status::kOk, db_->get_shrink_progress(shrink_progress));
+  ASSERT_FALSE(shrink_progress.running_);
+  ASSERT_EQ(1, shrink_progress.table_space_id_);
+  ASSERT_EQ(3, shrink_progress.shrunk_extent_count_);
+  ASSERT_EQ(3, shrink_progress.round_count_);
+}
+
+} // namespace
 } // namespace xengine
 
 int main(int argc, char **argv)
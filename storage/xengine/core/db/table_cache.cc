@@ -123,6 +123,13 @@ Status TableCache::GetTableReader(
     RandomAccessFileReader *file_reader = MOD_NEW_OBJECT(memory::ModId::kDefaultMod, RandomAccessFileReader,
         extent, ioptions_.env, record_read_stats ? ioptions_.statistics : nullptr, SST_READ_MICROS,
         file_read_hist, &ioptions_, env_options);
+    // the reads of the table readers are the foreground reads that the
+    // auto tuned rate limiter protects from the background IO, timing them
+    // is not worth it for the other rate limiters
+    if (nullptr != file_reader && nullptr != ioptions_.rate_limiter
+        && ioptions_.rate_limiter->IsAutoTuned()) {
+      file_reader->set_rate_limiter(ioptions_.rate_limiter);
+    }
     s = ioptions_.table_factory->NewTableReader(
         TableReaderOptions(ioptions_, env_options, internal_comparator, &fd,
                            file_read_hist, skip_filters, level),
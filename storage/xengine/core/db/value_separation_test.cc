@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2020, Alibaba Group Holding Limited
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "db/db_test_util.h"
+#include "port/stack_trace.h"
+
+using namespace xengine;
+using namespace common;
+using namespace util;
+
+namespace xengine
+{
+namespace db
+{
+class ValueSeparationTest : public DBTestBase
+{
+public:
+  ValueSeparationTest() : DBTestBase("/value_separation_test") {}
+
+  Options get_options()
+  {
+    Options options = CurrentOptions();
+    options.value_separation_threshold = 4096;
+    return options;
+  }
+
+  static std::string make_value(int i, int round, size_t size)
+  {
+    std::string value = std::to_string(round) + "_" + std::to_string(i) + "_";
+    value.resize(size, static_cast<char>('a' + (i + round) % 26));
+    return value;
+  }
+};
+
+TEST_F(ValueSeparationTest, get_and_scan)
+{
+  Options options = get_options();
+  CreateAndReopenWithCF({"value_separation"}, options);
+  const int count = 500;
+  std::map<std::string, std::string> expected;
+  for (int i = 0; i < count; ++i) {
+    // mix of inline and separated values, the separated ones span several
+    // value extents
+    std::string key = "key" + std::to_string(1000 + i);
+    std::string value = make_value(i, 0, 0 == i % 5 ? 100 : 4096 + 10 * i);
+    ASSERT_OK(Put(1, key, value));
+    expected[key] = value;
+  }
+  ASSERT_OK(Flush(1));
+
+  for (const auto &kv : expected) {
+    ASSERT_EQ(kv.second, Get(1, kv.first));
+  }
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions(), handles_[1]));
+  auto expected_iter = expected.begin();
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++expected_iter) {
+    ASSERT_TRUE(expected.end() != expected_iter);
+    ASSERT_EQ(expected_iter->first, iter->key().ToString());
+    ASSERT_EQ(expected_iter->second, iter->value().ToString());
+  }
+  ASSERT_TRUE(expected.end() == expected_iter);
+  iter.reset();
+
+  ReopenWithColumnFamilies({"default", "value_separation"}, options);
+  for (const auto &kv : expected) {
+    ASSERT_EQ(kv.second, Get(1, kv.first));
+  }
+}
+
+TEST_F(ValueSeparationTest, overwrite_and_compact)
+{
+  Options options = get_options();
+  CreateAndReopenWithCF({"value_separation"}, options);
+  const int count = 300;
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < count; ++i) {
+      ASSERT_OK(Put(1, "key" + std::to_string(i), make_value(i, round, 8192)));
+    }
+    ASSERT_OK(Flush(1));
+  }
+  for (int i = 0; i < count; i += 3) {
+    ASSERT_OK(Delete(1, "key" + std::to_string(i)));
+  }
+  ASSERT_OK(Flush(1));
+
+  // the older versions are dropped, and with them the references to the
+  // value extents of the first rounds
+  ASSERT_OK(CompactRange(1, INTRA_COMPACTION_TASK));
+  dbfull()->TEST_WaitForCompact();
+  for (int i = 0; i < count; ++i) {
+    if (0 == i % 3) {
+      ASSERT_EQ("NOT_FOUND", Get(1, "key" + std::to_string(i)));
+    } else {
+      ASSERT_EQ(make_value(i, 2, 8192), Get(1, "key" + std::to_string(i)));
+    }
+  }
+
+  ReopenWithColumnFamilies({"default", "value_separation"}, options);
+  for (int i = 1; i < count; i += 3) {
+    ASSERT_EQ(make_value(i, 2, 8192), Get(1, "key" + std::to_string(i)));
+  }
+}
+
+TEST_F(ValueSeparationTest, dump_twice)
+{
+  Options options = get_options();
+  CreateAndReopenWithCF({"value_separation", "other"}, options);
+  ColumnFamilyData *sub_table = reinterpret_cast<ColumnFamilyHandleImpl *>(handles_[1])->cfd();
+  storage::StorageManager *storage_manager = sub_table->get_storage_manager();
+  const int count = 300;
+  int64_t lob_extent_count[2] = {0, 0};
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 0; i < count; ++i) {
+      ASSERT_OK(Put(1, "key" + std::to_string(i), make_value(i, round, 8192)));
+    }
+    // switch to a new WAL, so that the memtable can be dumped
+    ASSERT_OK(Put(2, "key", "value"));
+    ASSERT_OK(Flush(2));
+    ASSERT_EQ(Status::kOk, dbfull()->TEST_dump_subtable(sub_table));
+    lob_extent_count[round] = storage_manager->get_lob_extent_count();
+  }
+
+  // the second dump replaces the first one, and with it all of its value
+  // extents, though the values in them were never dropped one by one
+  ASSERT_GT(lob_extent_count[0], 0);
+  ASSERT_EQ(lob_extent_count[0], lob_extent_count[1]);
+  for (int i = 0; i < count; ++i) {
+    ASSERT_EQ(make_value(i, 1, 8192), Get(1, "key" + std::to_string(i)));
+  }
+}
+
+TEST_F(ValueSeparationTest, pause_on_low_live_ratio)
+{
+  Options options = get_options();
+  options.value_separation_min_live_ratio = 90;
+  CreateAndReopenWithCF({"value_separation"}, options);
+  ColumnFamilyData *sub_table = reinterpret_cast<ColumnFamilyHandleImpl *>(handles_[1])->cfd();
+  storage::StorageManager *storage_manager = sub_table->get_storage_manager();
+  uint64_t live_ratio = 0;
+  const int count = 300;
+
+  for (int i = 0; i < count; ++i) {
+    ASSERT_OK(Put(1, "key" + std::to_string(i), make_value(i, 0, 8192)));
+  }
+  ASSERT_OK(Flush(1));
+  ASSERT_TRUE(db_->GetIntProperty(handles_[1], DB::Properties::kValueExtentLiveRatio, &live_ratio));
+  ASSERT_EQ(100, live_ratio);
+
+  // drop half of the values of the first value extents, they stay allocated
+  for (int i = 0; i < count; i += 2) {
+    ASSERT_OK(Put(1, "key" + std::to_string(i), make_value(i, 1, 8192)));
+  }
+  ASSERT_OK(Flush(1));
+  ASSERT_OK(CompactRange(1, INTRA_COMPACTION_TASK));
+  dbfull()->TEST_WaitForCompact();
+  ASSERT_TRUE(db_->GetIntProperty(handles_[1], DB::Properties::kValueExtentLiveRatio, &live_ratio));
+  ASSERT_LT(live_ratio, 90);
+  ASSERT_FALSE(sub_table->can_separate_values());
+
+  // new values are kept inline, no value extent is added
+  int64_t lob_extent_count = storage_manager->get_lob_extent_count();
+  for (int i = 0; i < count; ++i) {
+    ASSERT_OK(Put(1, "new_key" + std::to_string(i), make_value(i, 2, 8192)));
+  }
+  ASSERT_OK(Flush(1));
+  ASSERT_EQ(lob_extent_count, storage_manager->get_lob_extent_count());
+  for (int i = 0; i < count; ++i) {
+    ASSERT_EQ(make_value(i, 0 == i % 2 ? 1 : 0, 8192), Get(1, "key" + std::to_string(i)));
+    ASSERT_EQ(make_value(i, 2, 8192), Get(1, "new_key" + std::to_string(i)));
+  }
+}
+
+} // namespace db
+} // namespace xengine
+
+int main(int argc, char **argv)
+{
+  xengine::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  xengine::util::test::init_logger(__FILE__);
+  return RUN_ALL_TESTS();
+}
@@ -158,6 +158,8 @@ struct MiniTables {
   storage::ChangeInfo *change_info_ = nullptr;
   int level = 0;
   int64_t table_space_id_ = -1;
+  // false keeps values inline though value_separation_threshold is set
+  bool separate_values = true;
 };
 }  // namespace db
 }  // namespace xengine
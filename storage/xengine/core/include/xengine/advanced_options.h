@@ -537,6 +537,24 @@ struct AdvancedColumnFamilyOptions {
   // Default: false
   bool report_bg_io_stats = false;
 
+  // Values of at least this many bytes are separated from their keys when
+  // flushed: they are packed into value extents shared by several values and
+  // the sst only keeps a pointer, so compactions no longer rewrite them.
+  // Values of 1.5MB and more always go to large object extents of their own.
+  // Default: 0 (disabled)
+  uint64_t value_separation_threshold = 0;
+
+  // WARNING: a value extent is only reclaimed once every value in it has been
+  // dropped by compaction, partly live value extents are never rewritten, so
+  // separated values can cost up to 100 / live ratio of their size on disk.
+  // Once the live ratio (percent of the values packed into the value extents
+  // of a subtable that are still referenced, see the
+  // "xengine.value-extent-live-ratio" property) is below this, new values are
+  // kept inline until whole value extents are reclaimed again. 0 never stops
+  // separating.
+  // Default: 50
+  uint64_t value_separation_min_live_ratio = 50;
+
   // Create ColumnFamilyOptions with default values for all fields
   AdvancedColumnFamilyOptions();
   // Create ColumnFamilyOptions from Options
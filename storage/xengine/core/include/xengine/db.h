@@ -73,6 +73,7 @@ class ExtentSpaceManager;
 struct CompactionJobStatsInfo;
 class StorageLogger;
 struct DataFileStatistics;
+struct ShrinkProgress;
 }
 
 namespace db {
@@ -649,6 +650,11 @@ class DB {
     //      compacted.
     static const std::string kBaseLevel;
 
+    //  "xengine.value-extent-live-ratio" - returns the percent of the values
+    //      packed into the large object and value extents of the column family
+    //      that are still referenced, 100 if there is none.
+    static const std::string kValueExtentLiveRatio;
+
     //  "xengine.estimate-pending-compaction-bytes" - returns estimated total
     //      number of bytes compaction needs to rewrite to get all levels down
     //      to under target size. Not valid for other compactions than level-
@@ -744,6 +750,7 @@ class DB {
   //  "xengine.min-log-number-to-keep"
   //  "xengine.total-sst-files-size"
   //  "xengine.base-level"
+  //  "xengine.value-extent-live-ratio"
   //  "xengine.estimate-pending-compaction-bytes"
   //  "xengine.num-running-compactions"
   //  "xengine.num-running-flushes"
@@ -1063,6 +1070,8 @@ class DB {
 
   virtual int get_data_file_stats(std::vector<storage::DataFileStatistics> &data_file_stats) = 0;
 
+  virtual int get_shrink_progress(storage::ShrinkProgress &shrink_progress) = 0;
+
   // information schema
   virtual std::list<storage::CompactionJobStatsInfo*> &get_compaction_history(std::mutex **mu,
           storage::CompactionJobStatsInfo **sum) = 0;
@@ -306,6 +306,15 @@ extern MemTableRepFactory* NewHashSkipListRepFactory(
     size_t bucket_count = 1000000, int32_t skiplist_height = 4,
     int32_t skiplist_branching_factor = 4);
 
+// This factory keeps all the entries in an ordered skip list, which serves
+// iterators and flush, plus a fixed array of buckets hashing the whole user
+// key to the entries, which serves point lookups. No prefix extractor is
+// needed, and concurrent inserts are supported.
+// bucket_count: number of fixed array buckets, allocated (8 bytes each) from
+//               the arena of every memtable, the default costs 2MB each
+extern MemTableRepFactory* NewHashIndexSkipListRepFactory(
+    size_t bucket_count = 262144);
+
 // The factory is to create memtables based on a hash table:
 // it contains a fixed array of buckets, each pointing to either a linked list
 // or a skip list if number of entries inside the bucket exceeds
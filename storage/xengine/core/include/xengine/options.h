@@ -58,6 +58,7 @@ class FilterPolicy;
 namespace cache {
 class Cache;
 class RowCache;
+class HotCacheTracker;
 }
 
 namespace util {
@@ -1006,9 +1007,28 @@ struct DBOptions {
   uint64_t shrink_allocate_interval = 60 * 60; //1 hour
   uint64_t max_shrink_extent_count = 512;
   uint64_t total_max_shrink_extent_count = 15 * 512;
+  // A shrink job moves at most this many extents per round, the subtables are
+  // released between rounds so that flush and compaction can go on
+  uint64_t shrink_round_extent_count = 64;
+  // Bytes per second a shrink job moves, 0 means unlimited
+  uint64_t shrink_rate_limit = 0;
   uint64_t idle_tasks_schedule_time = 60; // 60s
   uint64_t table_cache_size = 1 * 1024 * 1024 * 1024; // 1GB
   uint64_t auto_shrink_schedule_interval = 60 * 60; // 1 hour
+
+  // Number of the hottest data blocks and rows kept across restarts. Reads
+  // are sampled, and the hottest ones are persisted to the CACHE_PREWARM file
+  // in the db directory. On open they are read back into the block cache and
+  // the row cache in the background.
+  // Default: 0 (disabled)
+  uint64_t cache_prewarm_max_entries = 0;
+  // Seconds between two dumps of the hot blocks and rows, 0 only dumps at
+  // shutdown
+  uint64_t cache_prewarm_dump_period_sec = 10 * 60; // 10 minutes
+  // Bytes per second read when warming the caches up, 0 means unlimited
+  uint64_t cache_prewarm_rate_limit = 64 * 1024 * 1024;
+  // Created on open when cache_prewarm_max_entries is set
+  std::shared_ptr<cache::HotCacheTracker> hot_cache_tracker = nullptr;
 };
 
 // Options to control the behavior of a database (passed to DB::Open)
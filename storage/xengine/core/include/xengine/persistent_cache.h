@@ -65,9 +65,13 @@ class PersistentCache {
 };
 
 // Factor method to create a new persistent cache
+// Create a persistent cache on local storage (SSD or NVM). A block is cached
+// after it has been inserted admission_min_inserts times, see
+// PersistentCacheConfig::admission_min_inserts
 common::Status NewPersistentCache(util::Env* const env, const std::string& path,
                                   const uint64_t size,
                                   const bool optimized_for_nvm,
-                                  std::shared_ptr<PersistentCache>* cache);
+                                  std::shared_ptr<PersistentCache>* cache,
+                                  const uint32_t admission_min_inserts = 1);
 }  // namespace cache
 }  // namespace xengine
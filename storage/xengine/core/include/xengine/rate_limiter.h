@@ -55,6 +55,26 @@ class RateLimiter {
   // Total # of requests that go though rate limiter
   virtual int64_t GetTotalRequests(
       const Env::IOPriority pri = Env::IO_TOTAL) const = 0;
+
+  // Bytes per second currently granted, it's below the one set by
+  // SetBytesPerSecond() when the rate limiter is auto tuned.
+  virtual int64_t GetBytesPerSecond() const { return 0; }
+
+  // Whether the rate is tuned by the rate limiter itself, only then it uses
+  // the foreground reads reported to it.
+  virtual bool IsAutoTuned() const { return false; }
+
+  // Report the latency of a foreground read. An auto tuned rate limiter
+  // backs off the background IO while the foreground reads are slower than
+  // the target.
+  virtual void ReportForegroundRead(const uint64_t /* micros */) {}
+
+  // Average latency of the foreground reads during the last tune interval
+  virtual uint64_t GetForegroundReadLatency() const { return 0; }
+
+  // Target latency of the foreground reads, 0 means the rate limiter is tuned
+  // only by how often the background IO drains it.
+  virtual void SetForegroundReadLatencyTarget(const uint64_t /* micros */) {}
 };
 
 // Create a RateLimiter object, which can be shared among RocksDB instances to
@@ -75,9 +95,14 @@ class RateLimiter {
 // continuouly. This fairness parameter grants low-pri requests permission by
 // 1/fairness chance even though high-pri requests exist to avoid starvation.
 // You should be good by leaving it at default 10.
+// @auto_tuned: Enables dynamic adjustment of rate limit within the range
+// `[rate_bytes_per_sec / 20, rate_bytes_per_sec]`, according to how often the
+// background IO drains the rate limiter and the latency of the foreground
+// reads reported by ReportForegroundRead().
 extern RateLimiter* NewGenericRateLimiter(int64_t rate_bytes_per_sec,
                                           int64_t refill_period_us = 100 * 1000,
-                                          int32_t fairness = 10);
+                                          int32_t fairness = 10,
+                                          bool auto_tuned = false);
 
 }  // namespace util
 }  // namespace xengine
@@ -389,6 +389,11 @@ class StackableDB : public db::DB {
     return db_->get_data_file_stats(data_file_stats);
   }
 
+  virtual int get_shrink_progress(storage::ShrinkProgress &shrink_progress) override
+  {
+    return db_->get_shrink_progress(shrink_progress);
+  }
+
   virtual std::list<storage::CompactionJobStatsInfo*> &get_compaction_history(std::mutex **mu,
           storage::CompactionJobStatsInfo **sum) override {
     return db_->get_compaction_history(mu, sum);
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "xengine/comparator.h"
 #include "xengine/iterator.h"
@@ -221,6 +222,15 @@ class WriteBatchWithIndex : public db::WriteBatchBase {
                                    const common::Slice& key,
                                    std::string* value);
 
+  // Similar to GetFromBatchAndDB() for each of the keys, but the keys that
+  // are not in this batch are read from the DB in a single DB::MultiGet(),
+  // which pins the super version once for all of them.
+  std::vector<common::Status> MultiGetFromBatchAndDB(
+      db::DB* db, const common::ReadOptions& read_options,
+      const std::vector<db::ColumnFamilyHandle*>& column_family,
+      const std::vector<common::Slice>& keys,
+      std::vector<std::string>* values);
+
   // Records the state of the batch for future calls to RollbackToSavePoint().
   // May be called multiple times to set multiple save points.
   void SetSavePoint() override;
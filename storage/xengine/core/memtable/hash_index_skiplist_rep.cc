@@ -0,0 +1,195 @@
+//  Portions Copyright (c) 2020, Alibaba Group Holding Limited
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under the BSD-style license found in the
+//  LICENSE file in the root directory of this source tree. An additional grant
+//  of patent rights can be found in the PATENTS file in the same directory.
+//
+
+#ifndef ROCKSDB_LITE
+#include "memtable/hash_index_skiplist_rep.h"
+
+#include <atomic>
+
+#include "db/memtable.h"
+#include "memtable/memtable_allocator.h"
+#include "util/murmurhash.h"
+#include "xengine/memtablerep.h"
+#include "xengine/slice.h"
+using namespace xengine;
+using namespace common;
+using namespace util;
+using namespace db;
+
+namespace xengine {
+namespace memtable {
+namespace {
+
+// An ordered skip list with a hash index on the whole user key next to it.
+// Point lookups only walk the hash chain of the user key, all the iterators
+// (scans, flush) go through the skip list, so unlike HashSkipListRep no
+// prefix extractor is needed and total order iteration stays cheap.
+class HashIndexSkipListRep : public MemTableRep {
+ public:
+  HashIndexSkipListRep(const MemTableRep::KeyComparator& compare,
+                       MemTableAllocator* allocator,
+                       const SliceTransform* transform, size_t bucket_size);
+
+  virtual KeyHandle Allocate(const size_t len, char** buf) override {
+    return ordered_->Allocate(len, buf);
+  }
+
+  virtual void Insert(KeyHandle handle) override;
+
+  virtual void InsertWithHint(KeyHandle handle, void** hint) override;
+
+  virtual void InsertConcurrently(KeyHandle handle) override;
+
+  virtual bool Contains(const char* key) const override {
+    return ordered_->Contains(key);
+  }
+
+  virtual void MarkReadOnly() override { ordered_->MarkReadOnly(); }
+
+  virtual void Get(const LookupKey& k, void* callback_args,
+                   bool (*callback_func)(void* arg,
+                                         const char* entry)) override;
+
+  virtual uint64_t ApproximateNumEntries(const Slice& start_ikey,
+                                         const Slice& end_ikey) override {
+    return ordered_->ApproximateNumEntries(start_ikey, end_ikey);
+  }
+
+  virtual size_t ApproximateMemoryUsage() override {
+    // All memory is allocated through allocator; nothing to report here
+    return 0;
+  }
+
+  virtual ~HashIndexSkipListRep() {}
+
+  virtual MemTableRep::Iterator* GetIterator(Arena* arena = nullptr) override {
+    return ordered_->GetIterator(arena);
+  }
+
+  virtual MemTableRep::Iterator* GetDynamicPrefixIterator(
+      Arena* arena = nullptr) override {
+    return ordered_->GetDynamicPrefixIterator(arena);
+  }
+
+ private:
+  // One entry of a bucket chain, points to the key in the skip list. A chain
+  // is kept sorted by the internal key comparator (so the versions of a user
+  // key are adjacent, newest first) and nodes are never unlinked, so readers
+  // need no lock.
+  struct Node {
+    const char* key_;
+    std::atomic<Node*> next_;
+  };
+
+  const size_t bucket_size_;
+
+  std::atomic<Node*>* buckets_;
+
+  const MemTableRep::KeyComparator& compare_;
+
+  std::unique_ptr<MemTableRep> ordered_;
+
+  inline size_t GetHash(const Slice& user_key) const {
+    return MurmurHash(user_key.data(), static_cast<int>(user_key.size()), 0) %
+           bucket_size_;
+  }
+
+  void AddToIndex(const char* key);
+};
+
+HashIndexSkipListRep::HashIndexSkipListRep(
+    const MemTableRep::KeyComparator& compare, MemTableAllocator* allocator,
+    const SliceTransform* transform, size_t bucket_size)
+    : MemTableRep(allocator),
+      bucket_size_(bucket_size),
+      compare_(compare),
+      ordered_(SkipListFactory().CreateMemTableRep(compare, allocator,
+                                                   transform)) {
+  auto mem =
+      allocator->AllocateAligned(sizeof(std::atomic<Node*>) * bucket_size);
+  buckets_ = new (mem) std::atomic<Node*>[ bucket_size ];
+
+  for (size_t i = 0; i < bucket_size_; ++i) {
+    buckets_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+void HashIndexSkipListRep::AddToIndex(const char* key) {
+  auto mem = allocator_->AllocateAligned(sizeof(Node));
+  Node* node = new (mem) Node();
+  node->key_ = key;
+
+  // Link the node in front of the first node not smaller than it. A failed
+  // CAS means another writer linked a node at the same place, retry from
+  // there: the predecessor is still in the chain and still smaller.
+  std::atomic<Node*>* link = &buckets_[GetHash(UserKey(key))];
+  Node* next = link->load(std::memory_order_acquire);
+  while (true) {
+    if (next != nullptr && compare_(next->key_, key) < 0) {
+      link = &next->next_;
+      next = link->load(std::memory_order_acquire);
+      continue;
+    }
+    node->next_.store(next, std::memory_order_relaxed);
+    if (link->compare_exchange_weak(next, node, std::memory_order_release,
+                                    std::memory_order_acquire)) {
+      break;
+    }
+  }
+}
+
+void HashIndexSkipListRep::Insert(KeyHandle handle) {
+  ordered_->Insert(handle);
+  AddToIndex(static_cast<char*>(handle));
+}
+
+void HashIndexSkipListRep::InsertWithHint(KeyHandle handle, void** hint) {
+  ordered_->InsertWithHint(handle, hint);
+  AddToIndex(static_cast<char*>(handle));
+}
+
+void HashIndexSkipListRep::InsertConcurrently(KeyHandle handle) {
+  ordered_->InsertConcurrently(handle);
+  AddToIndex(static_cast<char*>(handle));
+}
+
+void HashIndexSkipListRep::Get(const LookupKey& k, void* callback_args,
+                               bool (*callback_func)(void* arg,
+                                                     const char* entry)) {
+  // The chain is sorted, skip the nodes before the lookup key, then hand over
+  // the versions of the user key newest first the way a skip list seek would,
+  // the first node of another user key ends them.
+  const Slice user_key = k.user_key();
+  const Slice internal_key = k.internal_key();
+  for (Node* node = buckets_[GetHash(user_key)].load(std::memory_order_acquire);
+       node != nullptr; node = node->next_.load(std::memory_order_acquire)) {
+    if (compare_(node->key_, internal_key) < 0) {
+      continue;
+    }
+    if (UserKey(node->key_) != user_key ||
+        !callback_func(callback_args, node->key_)) {
+      break;
+    }
+  }
+}
+
+}  // anon namespace
+
+MemTableRep* HashIndexSkipListRepFactory::CreateMemTableRep(
+    const MemTableRep::KeyComparator& compare, MemTableAllocator* allocator,
+    const SliceTransform* transform) {
+  return new HashIndexSkipListRep(compare, allocator, transform,
+                                  bucket_count_);
+}
+
+MemTableRepFactory* NewHashIndexSkipListRepFactory(size_t bucket_count) {
+  return new HashIndexSkipListRepFactory(bucket_count);
+}
+
+}  // namespace memtable
+}  // namespace xengine
+#endif  // ROCKSDB_LITE
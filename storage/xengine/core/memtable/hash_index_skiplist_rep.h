@@ -0,0 +1,37 @@
+//  Portions Copyright (c) 2020, Alibaba Group Holding Limited
+// Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#pragma once
+#ifndef ROCKSDB_LITE
+#include "xengine/memtablerep.h"
+#include "xengine/slice_transform.h"
+
+namespace xengine {
+namespace memtable {
+
+class HashIndexSkipListRepFactory : public MemTableRepFactory {
+ public:
+  explicit HashIndexSkipListRepFactory(size_t bucket_count)
+      : bucket_count_(bucket_count) {}
+
+  virtual ~HashIndexSkipListRepFactory() {}
+
+  virtual MemTableRep* CreateMemTableRep(
+      const MemTableRep::KeyComparator& compare, MemTableAllocator* allocator,
+      const common::SliceTransform* transform) override;
+
+  virtual const char* Name() const override {
+    return "HashIndexSkipListRepFactory";
+  }
+
+  bool IsInsertConcurrentlySupported() const override { return true; }
+
+ private:
+  const size_t bucket_count_;
+};
+}
+}
+#endif  // ROCKSDB_LITE
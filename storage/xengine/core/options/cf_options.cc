@@ -78,8 +78,11 @@ ImmutableCFOptions::ImmutableCFOptions(const ImmutableDBOptions& db_options,
       num_levels(cf_options.num_levels),
       optimize_filters_for_hits(cf_options.optimize_filters_for_hits),
       force_consistency_checks(cf_options.force_consistency_checks),
+      value_separation_threshold(cf_options.value_separation_threshold),
+      value_separation_min_live_ratio(cf_options.value_separation_min_live_ratio),
       listeners(db_options.listeners),
       row_cache(db_options.row_cache),
+      hot_cache_tracker(db_options.hot_cache_tracker),
       max_subcompactions(db_options.max_subcompactions),
       memtable_insert_with_hint_prefix_extractor(
           cf_options.memtable_insert_with_hint_prefix_extractor.get()),
@@ -146,6 +149,8 @@ void MutableCFOptions::Dump() const {
   __XENGINE_LOG(INFO,
                  "                 inplace_update_num_locks: %" ROCKSDB_PRIszt,
                  inplace_update_num_locks);
+  __XENGINE_LOG(INFO, "                         memtable_factory: %s",
+                 memtable_factory ? memtable_factory->Name() : "None");
   __XENGINE_LOG(INFO, "                 disable_auto_compactions: %d",
                  disable_auto_compactions);
   __XENGINE_LOG(INFO, "      soft_pending_compaction_bytes_limit: %" PRIu64,
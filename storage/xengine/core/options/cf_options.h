@@ -122,12 +122,19 @@ struct ImmutableCFOptions {
 
   bool force_consistency_checks;
 
+  uint64_t value_separation_threshold;
+
+  uint64_t value_separation_min_live_ratio;
+
   // A vector of EventListeners which call-back functions will be called
   // when specific event happens.
   std::vector<std::shared_ptr<EventListener>> listeners;
 
   std::shared_ptr<cache::RowCache> row_cache;
 
+  // Samples the data block reads, nullptr if cache prewarm is disabled
+  std::shared_ptr<cache::HotCacheTracker> hot_cache_tracker;
+
   uint32_t max_subcompactions;
 
   const SliceTransform* memtable_insert_with_hint_prefix_extractor;
@@ -149,6 +156,7 @@ struct MutableCFOptions {
         memtable_huge_page_size(options.memtable_huge_page_size),
         max_successive_merges(options.max_successive_merges),
         inplace_update_num_locks(options.inplace_update_num_locks),
+        memtable_factory(options.memtable_factory),
         disable_auto_compactions(options.disable_auto_compactions),
         soft_pending_compaction_bytes_limit(
             options.soft_pending_compaction_bytes_limit),
@@ -196,6 +204,7 @@ struct MutableCFOptions {
         memtable_huge_page_size(0),
         max_successive_merges(0),
         inplace_update_num_locks(0),
+        memtable_factory(),
         disable_auto_compactions(false),
         soft_pending_compaction_bytes_limit(0),
         hard_pending_compaction_bytes_limit(0),
@@ -252,6 +261,9 @@ struct MutableCFOptions {
   size_t memtable_huge_page_size;
   size_t max_successive_merges;
   size_t inplace_update_num_locks;
+  // Per subtable memtable representation, takes effect from the next
+  // memtable. Falls back to ImmutableCFOptions::memtable_factory if null.
+  std::shared_ptr<memtable::MemTableRepFactory> memtable_factory;
 
   // Compaction related options
   bool disable_auto_compactions;
@@ -101,7 +101,9 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions &options)
       cpu_compaction_thread_num(options.cpu_compaction_thread_num),
       fpga_compaction_thread_num(options.fpga_compaction_thread_num),
       fpga_device_id(options.fpga_device_id),
-      table_cache_size(options.table_cache_size) {
+      table_cache_size(options.table_cache_size),
+      cache_prewarm_max_entries(options.cache_prewarm_max_entries),
+      hot_cache_tracker(options.hot_cache_tracker) {
 }
 
 void ImmutableDBOptions::Dump() const {
@@ -250,6 +252,8 @@ void ImmutableDBOptions::Dump() const {
                    fpga_device_id);
   __XENGINE_LOG(INFO, "                       Options.table_cache_size: %d",
                    table_cache_size);
+  __XENGINE_LOG(INFO, "              Options.cache_prewarm_max_entries: %" PRIu64,
+                   cache_prewarm_max_entries);
 }
 
 MutableDBOptions::MutableDBOptions()
@@ -279,8 +283,12 @@ MutableDBOptions::MutableDBOptions()
       shrink_allocate_interval(60 * 60),
       max_shrink_extent_count(512),
       total_max_shrink_extent_count(15 * 512),
+      shrink_round_extent_count(64),
+      shrink_rate_limit(0),
       idle_tasks_schedule_time(60),
-      auto_shrink_schedule_interval(60 * 60)
+      auto_shrink_schedule_interval(60 * 60),
+      cache_prewarm_dump_period_sec(10 * 60),
+      cache_prewarm_rate_limit(64 * 1024 * 1024)
   {
   }
 
@@ -317,8 +325,12 @@ MutableDBOptions::MutableDBOptions(const DBOptions& options)
       shrink_allocate_interval(options.shrink_allocate_interval),
       max_shrink_extent_count(options.max_shrink_extent_count),
       total_max_shrink_extent_count(options.total_max_shrink_extent_count),
+      shrink_round_extent_count(options.shrink_round_extent_count),
+      shrink_rate_limit(options.shrink_rate_limit),
       idle_tasks_schedule_time(options.idle_tasks_schedule_time),
-      auto_shrink_schedule_interval(options.auto_shrink_schedule_interval)
+      auto_shrink_schedule_interval(options.auto_shrink_schedule_interval),
+      cache_prewarm_dump_period_sec(options.cache_prewarm_dump_period_sec),
+      cache_prewarm_rate_limit(options.cache_prewarm_rate_limit)
   {
   }
 void MutableDBOptions::Dump() const {
@@ -384,12 +396,24 @@ void MutableDBOptions::Dump() const {
   __XENGINE_LOG(INFO,
                 "           Options.total_max_shrink_extent_count: %d)",
                 total_max_shrink_extent_count);
+  __XENGINE_LOG(INFO,
+                "           Options.shrink_round_extent_count: %d)",
+                shrink_round_extent_count);
+  __XENGINE_LOG(INFO,
+                "           Options.shrink_rate_limit: %d)",
+                shrink_rate_limit);
   __XENGINE_LOG(INFO,
                 "           Options.idle_tasks_schedule_time: %d)",
                 idle_tasks_schedule_time);
   __XENGINE_LOG(INFO,
                 "           Options.auto_shrink_schedule_interval: %d)",
                 auto_shrink_schedule_interval);
+  __XENGINE_LOG(INFO,
+                "           Options.cache_prewarm_dump_period_sec: %d)",
+                cache_prewarm_dump_period_sec);
+  __XENGINE_LOG(INFO,
+                "           Options.cache_prewarm_rate_limit: %d)",
+                cache_prewarm_rate_limit);
 
 }
 
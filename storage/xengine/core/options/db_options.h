@@ -90,6 +90,8 @@ struct ImmutableDBOptions {
   uint64_t fpga_compaction_thread_num;
   uint64_t fpga_device_id;
   uint64_t table_cache_size;
+  uint64_t cache_prewarm_max_entries;
+  std::shared_ptr<cache::HotCacheTracker> hot_cache_tracker;
 };
 
 struct MutableDBOptions {
@@ -127,8 +129,12 @@ struct MutableDBOptions {
   uint64_t shrink_allocate_interval;
   uint64_t max_shrink_extent_count;
   uint64_t total_max_shrink_extent_count;
+  uint64_t shrink_round_extent_count;
+  uint64_t shrink_rate_limit;
   uint64_t idle_tasks_schedule_time;
   uint64_t auto_shrink_schedule_interval;
+  uint64_t cache_prewarm_dump_period_sec;
+  uint64_t cache_prewarm_rate_limit;
 };
 
 }  // namespace common
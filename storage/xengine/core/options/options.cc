@@ -95,7 +95,9 @@ AdvancedColumnFamilyOptions::AdvancedColumnFamilyOptions(const Options& options)
       optimize_filters_for_hits(options.optimize_filters_for_hits),
       paranoid_file_checks(options.paranoid_file_checks),
       force_consistency_checks(options.force_consistency_checks),
-      report_bg_io_stats(options.report_bg_io_stats) {
+      report_bg_io_stats(options.report_bg_io_stats),
+      value_separation_threshold(options.value_separation_threshold),
+      value_separation_min_live_ratio(options.value_separation_min_live_ratio) {
   assert(memtable_factory.get() != nullptr);
   if (max_bytes_for_level_multiplier_additional.size() <
       static_cast<unsigned int>(num_levels)) {
@@ -240,8 +242,14 @@ DBOptions::DBOptions(const Options &options)
       shrink_allocate_interval(options.shrink_allocate_interval),
       max_shrink_extent_count(options.max_shrink_extent_count),
       total_max_shrink_extent_count(options.total_max_shrink_extent_count),
+      shrink_round_extent_count(options.shrink_round_extent_count),
+      shrink_rate_limit(options.shrink_rate_limit),
       table_cache_size(options.table_cache_size),
-      auto_shrink_schedule_interval(options.auto_shrink_schedule_interval)
+      auto_shrink_schedule_interval(options.auto_shrink_schedule_interval),
+      cache_prewarm_max_entries(options.cache_prewarm_max_entries),
+      cache_prewarm_dump_period_sec(options.cache_prewarm_dump_period_sec),
+      cache_prewarm_rate_limit(options.cache_prewarm_rate_limit),
+      hot_cache_tracker(options.hot_cache_tracker)
 {
 }
 
@@ -435,6 +443,10 @@ void ColumnFamilyOptions::Dump() const {
                    force_consistency_checks);
   __XENGINE_LOG(INFO, "               Options.report_bg_io_stats: %d",
                    report_bg_io_stats);
+  __XENGINE_LOG(INFO, "       Options.value_separation_threshold: %" PRIu64,
+                   value_separation_threshold);
+  __XENGINE_LOG(INFO, "  Options.value_separation_min_live_ratio: %" PRIu64,
+                   value_separation_min_live_ratio);
 }  // ColumnFamilyOptions::Dump
 
 void Options::Dump() const {
@@ -165,7 +165,13 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.max_free_extent_percent = mutable_db_options.max_free_extent_percent;
   options.shrink_allocate_interval = mutable_db_options.shrink_allocate_interval;
   options.total_max_shrink_extent_count = mutable_db_options.total_max_shrink_extent_count;
+  options.shrink_round_extent_count = mutable_db_options.shrink_round_extent_count;
+  options.shrink_rate_limit = mutable_db_options.shrink_rate_limit;
   options.auto_shrink_schedule_interval = mutable_db_options.auto_shrink_schedule_interval;
+  options.cache_prewarm_max_entries = immutable_db_options.cache_prewarm_max_entries;
+  options.cache_prewarm_dump_period_sec = mutable_db_options.cache_prewarm_dump_period_sec;
+  options.cache_prewarm_rate_limit = mutable_db_options.cache_prewarm_rate_limit;
+  options.hot_cache_tracker = immutable_db_options.hot_cache_tracker;
 
   return options;
 }
@@ -189,6 +195,9 @@ ColumnFamilyOptions BuildColumnFamilyOptions(
   cf_opts.max_successive_merges = mutable_cf_options.max_successive_merges;
   cf_opts.inplace_update_num_locks =
       mutable_cf_options.inplace_update_num_locks;
+  if (mutable_cf_options.memtable_factory) {
+    cf_opts.memtable_factory = mutable_cf_options.memtable_factory;
+  }
 
   // Compaction related options
   cf_opts.disable_auto_compactions =
@@ -699,6 +708,16 @@ Status GetMutableOptionsFromStrings(
   *new_options = base_options;
   for (const auto& o : options_map) {
     try {
+      // memtable representation is switched per subtable, the next memtable
+      // is created with it
+      if (o.first == "memtable") {
+        std::unique_ptr<MemTableRepFactory> new_mem_factory;
+        if (!GetMemTableRepFactoryFromString(o.second, &new_mem_factory).ok()) {
+          return Status::InvalidArgument("Error parsing " + o.first);
+        }
+        new_options->memtable_factory.reset(new_mem_factory.release());
+        continue;
+      }
       auto iter = cf_options_type_info.find(o.first);
       if (iter == cf_options_type_info.end()) {
         return Status::InvalidArgument("Unrecognized option: " + o.first);
@@ -1345,6 +1364,15 @@ Status GetMemTableRepFactoryFromString(
     } else if (1 == len) {
       mem_factory = NewHashSkipListRepFactory();
     }
+  } else if (opts_list[0] == "hash_index") {
+    // Expecting format
+    // hash_index:<hash_bucket_count>
+    if (2 == len) {
+      size_t hash_bucket_count = ParseSizeT(opts_list[1]);
+      mem_factory = NewHashIndexSkipListRepFactory(hash_bucket_count);
+    } else if (1 == len) {
+      mem_factory = NewHashIndexSkipListRepFactory();
+    }
   } else if (opts_list[0] == "hash_linkedlist") {
     // Expecting format
     // hash_linkedlist:<hash_bucket_count>
@@ -441,6 +441,14 @@ static std::unordered_map<std::string, OptionTypeInfo> db_options_type_info = {
      {offsetof(struct DBOptions, total_max_shrink_extent_count),
       OptionType::kUInt64T, OptionVerificationType::kNormal, true,
       offsetof(struct MutableDBOptions, total_max_shrink_extent_count)}},
+    {"shrink_round_extent_count",
+     {offsetof(struct DBOptions, shrink_round_extent_count),
+      OptionType::kUInt64T, OptionVerificationType::kNormal, true,
+      offsetof(struct MutableDBOptions, shrink_round_extent_count)}},
+    {"shrink_rate_limit",
+     {offsetof(struct DBOptions, shrink_rate_limit),
+      OptionType::kUInt64T, OptionVerificationType::kNormal, true,
+      offsetof(struct MutableDBOptions, shrink_rate_limit)}},
     {"idle_tasks_schedule_time",
      {offsetof(struct DBOptions, idle_tasks_schedule_time),
       OptionType::kUInt64T, OptionVerificationType::kNormal, true,
@@ -452,6 +460,17 @@ static std::unordered_map<std::string, OptionTypeInfo> db_options_type_info = {
      {offsetof(struct DBOptions, auto_shrink_schedule_interval),
       OptionType::kUInt64T, OptionVerificationType::kNormal, true,
       offsetof(struct MutableDBOptions, auto_shrink_schedule_interval)}},
+    {"cache_prewarm_max_entries",
+     {offsetof(struct DBOptions, cache_prewarm_max_entries),
+      OptionType::kUInt64T, OptionVerificationType::kNormal, false, 0}},
+    {"cache_prewarm_dump_period_sec",
+     {offsetof(struct DBOptions, cache_prewarm_dump_period_sec),
+      OptionType::kUInt64T, OptionVerificationType::kNormal, true,
+      offsetof(struct MutableDBOptions, cache_prewarm_dump_period_sec)}},
+    {"cache_prewarm_rate_limit",
+     {offsetof(struct DBOptions, cache_prewarm_rate_limit),
+      OptionType::kUInt64T, OptionVerificationType::kNormal, true,
+      offsetof(struct MutableDBOptions, cache_prewarm_rate_limit)}},
 };
 
 // offset_of is used to get the offset of a class data member
@@ -510,6 +529,12 @@ static std::unordered_map<std::string, OptionTypeInfo> cf_options_type_info = {
     {"force_consistency_checks",
      {offset_of(&ColumnFamilyOptions::force_consistency_checks),
       OptionType::kBoolean, OptionVerificationType::kNormal, false, 0}},
+    {"value_separation_threshold",
+     {offset_of(&ColumnFamilyOptions::value_separation_threshold),
+      OptionType::kUInt64T, OptionVerificationType::kNormal, false, 0}},
+    {"value_separation_min_live_ratio",
+     {offset_of(&ColumnFamilyOptions::value_separation_min_live_ratio),
+      OptionType::kUInt64T, OptionVerificationType::kNormal, false, 0}},
     {"purge_redundant_kvs_while_flush",
      {offset_of(&ColumnFamilyOptions::purge_redundant_kvs_while_flush),
       OptionType::kBoolean, OptionVerificationType::kNormal, false, 0}},
@@ -77,6 +77,13 @@ int ChangeInfo::delete_large_object_extent(const ExtentId &extent_id)
   return push_large_object_extent_change(extent_change);
 }
 
+int ChangeInfo::drop_large_object_extent(const ExtentId &extent_id)
+{
+  LayerPosition dummy_layer_position(0, 0);
+  ExtentChange extent_change(dummy_layer_position, extent_id, ExtentChange::F_DEL | ExtentChange::F_DROP);
+  return push_large_object_extent_change(extent_change);
+}
+
 int ChangeInfo::merge(const ChangeInfo &change_info)
 {
   int ret = Status::kOk;
@@ -27,6 +27,8 @@ struct ExtentChange
 	static const uint8_t F_INIT = 0X0;
 	static const uint8_t F_ADD = 0X1;
 	static const uint8_t F_DEL = 0X2;
+  // with F_DEL, drop the whole lob extent instead of one value of it
+  static const uint8_t F_DROP = 0X4;
   LayerPosition layer_position_;
 	ExtentId extent_id_;
 	uint8_t flag_;
@@ -41,6 +43,7 @@ struct ExtentChange
 	~ExtentChange() {}
   bool is_add() const { return flag_ & F_ADD; }
   bool is_delete() const { return flag_ & F_DEL; }
+  bool is_drop() const { return flag_ & F_DROP; }
 
   DECLARE_AND_DEFINE_TO_STRING(KV_(layer_position), KV_(extent_id), KV_(flag));
   DECLARE_COMPACTIPLE_SERIALIZATION(EXTENT_CHANGE_VERSION);
@@ -63,6 +66,7 @@ struct ChangeInfo
   int replace_extent(const LayerPosition &layer_position, const ExtentId &old_extent, const ExtentId &new_extent);
   int add_large_object_extent(const ExtentId &extent_id);
   int delete_large_object_extent(const ExtentId &extent_id);
+  int drop_large_object_extent(const ExtentId &extent_id);
   int merge(const ChangeInfo &change_info);
   //TODO:yuanfeng, extent DEFINE_TO_STRING to support unordered_map
   int64_t to_string(char *buf, const int64_t buf_len) const
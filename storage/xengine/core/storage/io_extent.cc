@@ -326,7 +326,8 @@ size_t RandomAccessExtent::GetUniqueId(char *id, size_t max_size) const {
 AsyncRandomAccessExtent::AsyncRandomAccessExtent()
   : aio_(nullptr),
     aio_req_(),
-    rate_limiter_(nullptr)
+    rate_limiter_(nullptr),
+    io_priority_(Env::IO_LOW)
 {
 }
 
@@ -359,7 +360,14 @@ int AsyncRandomAccessExtent::prefetch() {
     XENGINE_LOG(WARN, "failed to prepare iocb", K(ret));
   } else {
     if (nullptr != rate_limiter_) {
-      rate_limiter_->Request(MAX_EXTENT_SIZE, Env::IOPriority::IO_LOW, nullptr /*stats_*/);
+      // a request must not exceed a single burst
+      int64_t left_bytes = MAX_EXTENT_SIZE;
+      int64_t request_bytes = 0;
+      while (left_bytes > 0) {
+        request_bytes = std::min(left_bytes, rate_limiter_->GetSingleBurstBytes());
+        rate_limiter_->Request(request_bytes, io_priority_, nullptr /*stats_*/);
+        left_bytes -= request_bytes;
+      }
     }
     if (FAILED(aio_->submit(&aio_req_, 1))) {
       XENGINE_LOG(WARN, "failed to submit aio request", K(ret));
@@ -123,8 +123,10 @@ class AsyncRandomAccessExtent : public RandomAccessExtent {
   ~AsyncRandomAccessExtent();
 
   virtual int init(const ExtentIOInfo &io_info, ExtentSpaceManager *space_manager);
-  void set_rate_limiter(util::RateLimiter *rate_limiter) {
+  void set_rate_limiter(util::RateLimiter *rate_limiter,
+                        const util::Env::IOPriority io_priority = util::Env::IO_LOW) {
     rate_limiter_ = rate_limiter;
+    io_priority_ = io_priority;
   }
   // call prefetch & read in pair
   int prefetch();
@@ -136,6 +138,7 @@ class AsyncRandomAccessExtent : public RandomAccessExtent {
     aio_ = nullptr;
     aio_req_.reset();
     rate_limiter_ = nullptr;
+    io_priority_ = util::Env::IO_LOW;
   }
 
  private:
@@ -145,6 +148,7 @@ class AsyncRandomAccessExtent : public RandomAccessExtent {
   util::AIOReq aio_req_;
 
   util::RateLimiter* rate_limiter_;
+  util::Env::IOPriority io_priority_;
 };
 
 }  // storage
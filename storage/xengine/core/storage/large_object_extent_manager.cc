@@ -29,6 +29,7 @@ namespace storage
 LargeObjectExtentMananger::LargeObjectExtentMananger()
     : is_inited_(false),
       lob_extent_(),
+      live_value_count_(),
       delete_lob_extent_(),
       lob_extent_wait_to_recycle_()
 {
@@ -43,6 +44,7 @@ void LargeObjectExtentMananger::destroy()
 {
   if (is_inited_)  {
     lob_extent_.clear();
+    live_value_count_.clear();
     delete_lob_extent_.clear();
     lob_extent_wait_to_recycle_.clear();
     is_inited_ = false;
@@ -90,7 +92,7 @@ int LargeObjectExtentMananger::apply(const ChangeInfo &change_info, common::Sequ
             XENGINE_LOG(WARN, "fail to add extent", K(ret), K(*extent_meta));
           }
         } else if (extent_change.is_delete()) {
-          if (FAILED(delete_extent(extent_meta))) {
+          if (FAILED(delete_extent(extent_meta, extent_change.is_drop()))) {
             XENGINE_LOG(WARN, "fail to delete extent", K(ret), K(*extent_meta));
           }
         } else {
@@ -156,6 +158,22 @@ int LargeObjectExtentMananger::force_recycle(bool for_recovery)
   return ret;
 }
 
+int64_t LargeObjectExtentMananger::get_live_ratio() const
+{
+  int64_t total_value_count = 0;
+  int64_t live_value_count = 0;
+
+  for (auto iter = lob_extent_.begin(); lob_extent_.end() != iter; ++iter) {
+    auto count_iter = live_value_count_.find(iter->first);
+    total_value_count += std::max((int64_t)iter->second->num_entries_, (int64_t)1);
+    if (live_value_count_.end() != count_iter) {
+      live_value_count += count_iter->second;
+    }
+  }
+
+  return 0 == total_value_count ? 100 : live_value_count * 100 / total_value_count;
+}
+
 int LargeObjectExtentMananger::recover_extent_space()
 {
   int ret = Status::kOk;
@@ -204,6 +222,8 @@ int LargeObjectExtentMananger::serialize(char *buf, int64_t buf_length, int64_t
     pos += sizeof(version);
     if (FAILED(util::serialize_v(buf, buf_length, pos, extent_ids))) {
       XENGINE_LOG(WARN, "fail to serialize extent ids", K(ret));
+    } else if (FAILED(util::serialize_v(buf, buf_length, pos, live_value_count_))) {
+      XENGINE_LOG(WARN, "fail to serialize live value count", K(ret));
     }
   }
 
@@ -216,6 +236,7 @@ int LargeObjectExtentMananger::deserialize(const char *buf, int64_t buf_length,
   int64_t size = 0;
   int64_t version = 0;
   std::vector<ExtentId> extent_ids;
+  std::unordered_map<int64_t, int64_t> live_value_count;
 
   if (!is_inited_) {
     ret = Status::kNotInit;
@@ -232,6 +253,12 @@ int LargeObjectExtentMananger::deserialize(const char *buf, int64_t buf_length,
       XENGINE_LOG(WARN, "fail to deserialize extent ids", K(ret));
     } else if (FAILED(build_lob_extent(extent_ids))) {
       XENGINE_LOG(WARN, "fail to build lob extent", K(ret));
+    } else if (version < 2) {
+      // every lob extent held one large object
+    } else if (FAILED(util::deserialize_v(buf, buf_length, pos, live_value_count))) {
+      XENGINE_LOG(WARN, "fail to deserialize live value count", K(ret));
+    } else if (FAILED(build_live_value_count(live_value_count))) {
+      XENGINE_LOG(WARN, "fail to build live value count", K(ret));
     }
   }
 
@@ -249,6 +276,7 @@ int64_t LargeObjectExtentMananger::get_serialize_size() const
   } else {
     size += 2 * sizeof(int64_t); //size and version
     size += util::get_serialize_v_size(extent_ids);
+    size += util::get_serialize_v_size(live_value_count_);
   }
   return size;
 }
@@ -266,6 +294,7 @@ int LargeObjectExtentMananger::add_extent(ExtentMeta *extent_meta)
     ret = Status::kErrorUnexpected;
     XENGINE_LOG(WARN, "unexpected error, fail to emplace large object extent", K(ret), K(*extent_meta));
   } else {
+    live_value_count_[extent_meta->extent_id_.id()] = std::max((int64_t)extent_meta->num_entries_, (int64_t)1);
     extent_meta->ref();
     XENGINE_LOG(INFO, "success to add lob extent", K(*extent_meta));
   }
@@ -273,7 +302,9 @@ int LargeObjectExtentMananger::add_extent(ExtentMeta *extent_meta)
   return ret;
 }
 
-int LargeObjectExtentMananger::delete_extent(ExtentMeta *extent_meta)
+// drop one value of the lob extent, or all of them when the extent is
+// released as a whole, e.g. the value extents of a replaced dump
+int LargeObjectExtentMananger::delete_extent(ExtentMeta *extent_meta, bool drop_all_values)
 {
   int ret = Status::kOk;
 
@@ -285,12 +316,20 @@ int LargeObjectExtentMananger::delete_extent(ExtentMeta *extent_meta)
     XENGINE_LOG(WARN, "invalid argument", K(ret), KP(extent_meta));
   } else {
     auto iter = lob_extent_.find(extent_meta->extent_id_.id());
-    if (lob_extent_.end() == iter) {
+    auto count_iter = live_value_count_.find(extent_meta->extent_id_.id());
+    if (lob_extent_.end() == iter || live_value_count_.end() == count_iter) {
       ret = Status::kErrorUnexpected;
       XENGINE_LOG(WARN, "unexpected error, the extent to drop not exist", K(ret), K(*extent_meta));
+    } else if (count_iter->second <= 0) {
+      ret = Status::kErrorUnexpected;
+      XENGINE_LOG(WARN, "unexpected error, all values of the extent have been dropped", K(ret), K(*extent_meta));
+    } else if (!drop_all_values && --count_iter->second > 0) {
+      // other values in the value extent are still alive
+      XENGINE_LOG(DEBUG, "drop one value of lob extent", K(*extent_meta), "live_value_count", count_iter->second);
     } else {
+      count_iter->second = 0;
       delete_lob_extent_.push_back(extent_meta);
-      XENGINE_LOG(INFO, "success to delete lob extent", K(*extent_meta));
+      XENGINE_LOG(INFO, "success to delete lob extent", K(*extent_meta), K(drop_all_values));
     }
   }
 
@@ -315,6 +354,8 @@ int LargeObjectExtentMananger::update(common::SequenceNumber sequence_number)
         } else if (1 != (erase_count = lob_extent_.erase(extent_meta->extent_id_.id()))) {
           ret = Status::kErrorUnexpected;
           XENGINE_LOG(WARN, "unexpected error, erased count not expected", K(ret), K(erase_count), K(*extent_meta));
+        } else {
+          live_value_count_.erase(extent_meta->extent_id_.id());
         }
       }
 
@@ -425,6 +466,7 @@ int LargeObjectExtentMananger::build_lob_extent(std::vector<ExtentId> &extent_id
         ret = Status::kErrorUnexpected;
         XENGINE_LOG(WARN, "fail to emplace to lob extent", K(ret), K(i), K(extent_id), K(*extent_meta));
       } else {
+        live_value_count_[extent_id.id()] = std::max((int64_t)extent_meta->num_entries_, (int64_t)1);
         extent_meta->ref();
         XENGINE_LOG(INFO, "success to add lob extent", K(extent_id));
       }
@@ -434,6 +476,28 @@ int LargeObjectExtentMananger::build_lob_extent(std::vector<ExtentId> &extent_id
   return ret;
 }
 
+int LargeObjectExtentMananger::build_live_value_count(const std::unordered_map<int64_t, int64_t> &live_value_count)
+{
+  int ret = Status::kOk;
+
+  if (UNLIKELY(!is_inited_)) {
+    ret = Status::kNotInit;
+    XENGINE_LOG(WARN, "LargeObjectExtentMananger should been inited first", K(ret));
+  } else {
+    for (auto iter = live_value_count.begin(); SUCCED(ret) && live_value_count.end() != iter; ++iter) {
+      auto count_iter = live_value_count_.find(iter->first);
+      if (live_value_count_.end() == count_iter) {
+        ret = Status::kErrorUnexpected;
+        XENGINE_LOG(WARN, "unexpected error, live value count of unknown lob extent", K(ret), "extent_id", iter->first);
+      } else {
+        count_iter->second = iter->second;
+      }
+    }
+  }
+
+  return ret;
+}
+
 int LargeObjectExtentMananger::deserialize_and_dump(const char *buf, int64_t buf_len, int64_t &pos,
                                                     char *str_buf, int64_t str_buf_len, int64_t &str_pos)
 {
@@ -441,6 +505,7 @@ int LargeObjectExtentMananger::deserialize_and_dump(const char *buf, int64_t buf
   int64_t size = 0;
   int64_t version = 0;
   std::vector<ExtentId> extent_ids;
+  std::unordered_map<int64_t, int64_t> live_value_count;
 
   if (IS_NULL(buf) || buf_len < 0 || pos >= buf_len) {
     ret = Status::kInvalidArgument;
@@ -452,11 +517,17 @@ int LargeObjectExtentMananger::deserialize_and_dump(const char *buf, int64_t buf
     pos += sizeof(version);
     if (FAILED(util::deserialize_v(buf, buf_len, pos, extent_ids))) {
       XENGINE_LOG(WARN, "fail to deserialize extent ids", K(ret));
+    } else if (version >= 2 && FAILED(util::deserialize_v(buf, buf_len, pos, live_value_count))) {
+      XENGINE_LOG(WARN, "fail to deserialize live value count", K(ret));
     } else {
       util::databuff_printf(str_buf, str_buf_len, str_pos, "{");
       util::databuff_print_json_wrapped_kv(str_buf, str_buf_len, str_pos, "lob", "");
       for (uint32_t i = 0; i < extent_ids.size(); ++i) {
         util::databuff_print_json_wrapped_kv(str_buf, str_buf_len, str_pos, "extent_id", extent_ids.at(i));
+        auto iter = live_value_count.find(extent_ids.at(i).id());
+        if (live_value_count.end() != iter) {
+          util::databuff_print_json_wrapped_kv(str_buf, str_buf_len, str_pos, "live_value_count", iter->second);
+        }
       }
       util::databuff_printf(str_buf, str_buf_len, str_pos, "}");
     }
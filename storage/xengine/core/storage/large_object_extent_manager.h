@@ -41,24 +41,33 @@ public:
   //recycle the lob extent not expilict delete, when the sutable has been dropped
   int force_recycle(bool for_recovery);
   int64_t get_lob_extent_count() const { return lob_extent_.size(); }
+  // percent of the values packed into the lob extents still referenced, 100
+  // if there is no lob extent
+  int64_t get_live_ratio() const;
   int recover_extent_space();
   int deserialize_and_dump(const char *buf, int64_t buf_len, int64_t &pos,
                            char *str_buf, int64_t str_buf_len, int64_t &str_pos);
   DECLARE_SERIALIZATION();
 private:
   int add_extent(ExtentMeta *extent_meta);
-  int delete_extent(ExtentMeta *extent_meta);
+  int delete_extent(ExtentMeta *extent_meta, bool drop_all_values);
   int update(common::SequenceNumber sequence_number);
   int recycle_extents(const std::vector<ExtentMeta *> &extents, bool for_recovery);
   int recycle_extent(ExtentMeta *extent_meta, bool for_recovery);
   int get_all_extent_ids(std::vector<ExtentId> &extent_ids) const;
   int build_lob_extent(std::vector<ExtentId> &extent_ids);
+  int build_live_value_count(const std::unordered_map<int64_t, int64_t> &live_value_count);
 private:
-    static const int64_t LARGE_OBJECT_EXTENT_MANAGER_VERSION = 1;
+  // version 2 persists the live value count of the lob extents
+  static const int64_t LARGE_OBJECT_EXTENT_MANAGER_VERSION = 2;
 private:
   bool is_inited_;
   ExtentSpaceManager *extent_space_mgr_;
   std::unordered_map<int64_t, ExtentMeta*> lob_extent_;
+  // values still pointing into each lob extent. An extent holding one large
+  // object has one, a value extent as many as the values packed into it, it
+  // is recycled once they are all dropped.
+  std::unordered_map<int64_t, int64_t> live_value_count_;
   std::vector<ExtentMeta *> delete_lob_extent_;
   std::unordered_map<common::SequenceNumber, std::vector<ExtentMeta *>> lob_extent_wait_to_recycle_;
 };
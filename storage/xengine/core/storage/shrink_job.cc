@@ -17,6 +17,8 @@
 #include "db/version_set.h"
 #include "shrink_job.h"
 #include "storage_logger.h"
+#include "xengine/rate_limiter.h"
+#include "xengine/xengine_constants.h"
 
 namespace xengine
 {
@@ -27,7 +29,14 @@ ShrinkJob::ShrinkJob()
     : is_inited_(false),
       mutex_(nullptr),
       global_ctx_(nullptr),
-      shrink_info_()
+      shrink_info_(),
+      round_shrink_info_(),
+      round_(0),
+      shrunk_extent_count_(0),
+      round_extent_count_(INT64_MAX),
+      rate_limit_(0),
+      progress_(nullptr),
+      shutting_down_(nullptr)
 {
 }
 
@@ -37,7 +46,11 @@ ShrinkJob::~ShrinkJob()
 
 int ShrinkJob::init(monitor::InstrumentedMutex *mutex,
                     db::GlobalContext *global_ctx,
-                    const ShrinkInfo &shrink_info)
+                    const ShrinkInfo &shrink_info,
+                    const int64_t round_extent_count,
+                    const int64_t rate_limit,
+                    ShrinkProgress *progress,
+                    const std::atomic<bool> *shutting_down)
 {
   int ret = Status::kOk;
 
@@ -46,45 +59,136 @@ int ShrinkJob::init(monitor::InstrumentedMutex *mutex,
     XENGINE_LOG(WARN, "ShrinkJob has been inited", K(ret));
   } else if (IS_NULL(mutex)
              || IS_NULL(global_ctx) 
-             || UNLIKELY(!shrink_info.is_valid())) {
+             || UNLIKELY(!shrink_info.is_valid())
+             || UNLIKELY(round_extent_count <= 0)
+             || UNLIKELY(rate_limit < 0)) {
     ret = Status::kInvalidArgument;
-    XENGINE_LOG(WARN, "invalid argument", K(ret), KP(mutex), KP(global_ctx), K(shrink_info));
+    XENGINE_LOG(WARN, "invalid argument", K(ret), KP(mutex), KP(global_ctx), K(shrink_info),
+        K(round_extent_count), K(rate_limit));
   } else {
     mutex_ = mutex;
     global_ctx_ = global_ctx;
     shrink_info_ = shrink_info;
+    round_extent_count_ = round_extent_count;
+    rate_limit_ = rate_limit;
+    progress_ = progress;
+    shutting_down_ = shutting_down;
     is_inited_ = true;
   }
 
   return ret;
 }
 
+/**The job is split into rounds of at most round_extent_count_ extents, the
+subtables are set pending_shrink and the table space is locked only during a
+round, so flush, compaction and the foreground writes go on between rounds.*/
 int ShrinkJob::run()
 {
   int ret = Status::kOk;
   bool can_shrink = true;
+  uint64_t round_start_time = 0;
 
   if (UNLIKELY(!is_inited_)) {
     ret = Status::kNotInit;
     XENGINE_LOG(WARN, "ShrinkJob should been inited first", K(ret));
-  } else if (FAILED(before_shrink(can_shrink))) {
-    XENGINE_LOG(WARN, "fail to prepare for shrink", K(ret));
   } else {
-    if (can_shrink) {
-      if (FAILED(do_shrink())) {
-        XENGINE_LOG(WARN, "fail to do shrink", K(ret));
+    update_progress(true);
+    while (SUCCED(ret) && can_shrink && shrunk_extent_count_ < shrink_info_.shrink_extent_count_) {
+      if (is_shutting_down()) {
+        XENGINE_LOG(INFO, "db is shutting down, stop the shrink job",
+            K_(round), K_(shrunk_extent_count), K_(shrink_info));
+        break;
+      }
+      reset_round();
+      round_start_time = global_ctx_->env_->NowMicros();
+      if (FAILED(before_shrink(can_shrink))) {
+        XENGINE_LOG(WARN, "fail to prepare for shrink", K(ret), K_(round));
+      } else if (can_shrink) {
+        if (FAILED(do_shrink())) {
+          XENGINE_LOG(WARN, "fail to do shrink", K(ret), K_(round));
+        }
+        /**if can_shrink is true, after_shrink should execute anyway
+         * because unref the subtable and reset pending_shrink must been done*/
+        after_shrink();
+        if (SUCCED(ret)) {
+          shrunk_extent_count_ += round_shrink_info_.shrink_extent_count_;
+          ++round_;
+          update_progress(true);
+          throttle(round_start_time, round_shrink_info_.shrink_extent_count_);
+        }
+      } else if (0 == round_) {
+        XENGINE_LOG(INFO, "the shrink job can't run");
+      } else {
+        XENGINE_LOG(INFO, "stop the shrink job, the left will be shrunk by next job",
+            K_(round), K_(shrunk_extent_count), K_(shrink_info));
       }
-      /**if can_shrink is true, after_shrink should execute anyway
-       * because unref the subtable and reset pending_shrink must been done*/
-      after_shrink();
-    } else {
-      XENGINE_LOG(INFO, "the shrink job can't run");
     }
+    update_progress(false);
   }
 
   return ret;
 }
 
+void ShrinkJob::reset_round()
+{
+  subtable_map_.clear();
+  extent_info_map_.clear();
+  extent_replace_map_.clear();
+  change_info_map_.clear();
+}
+
+void ShrinkJob::update_progress(const bool running)
+{
+  if (nullptr != progress_) {
+    mutex_->Lock();
+    if (running && 0 == round_) {
+      progress_->table_space_id_ = shrink_info_.table_space_id_;
+      progress_->extent_space_type_ = shrink_info_.extent_space_type_;
+      progress_->total_extent_count_ = shrink_info_.shrink_extent_count_;
+      progress_->start_time_ = global_ctx_->env_->NowMicros();
+    }
+    progress_->running_ = running;
+    progress_->shrunk_extent_count_ = shrunk_extent_count_;
+    progress_->round_count_ = round_;
+    mutex_->Unlock();
+  }
+}
+
+bool ShrinkJob::is_shutting_down() const
+{
+  return nullptr != shutting_down_ && shutting_down_->load(std::memory_order_acquire);
+}
+
+void ShrinkJob::throttle(const uint64_t round_start_time, const int64_t moved_extent_count)
+{
+  /**sleep in slices, so that the shutdown does not wait for a whole round*/
+  static const uint64_t MAX_SLEEP_SLICE = 100 * 1000; // 100ms
+  util::RateLimiter *rate_limiter = global_ctx_->options_.rate_limiter.get();
+  if (nullptr != rate_limiter && moved_extent_count > 0) {
+    /**the moved extents share the background IO budget with major compaction*/
+    int64_t left_bytes = moved_extent_count * MAX_EXTENT_SIZE;
+    int64_t request_bytes = 0;
+    while (left_bytes > 0 && !is_shutting_down()) {
+      request_bytes = std::min(left_bytes, rate_limiter->GetSingleBurstBytes());
+      rate_limiter->Request(request_bytes, util::Env::IO_LOW, nullptr /*stats*/);
+      left_bytes -= request_bytes;
+    }
+  }
+
+  if (rate_limit_ > 0 && moved_extent_count > 0) {
+    /**a tiny rate_limit gives an expect time beyond uint64_t, clamp it in double*/
+    double expect_time_d = (moved_extent_count * MAX_EXTENT_SIZE * 1000000.0) / rate_limit_;
+    uint64_t expect_time = expect_time_d >= static_cast<double>(UINT64_MAX)
+                           ? UINT64_MAX : static_cast<uint64_t>(expect_time_d);
+    uint64_t now = global_ctx_->env_->NowMicros();
+    while (now - round_start_time < expect_time && !is_shutting_down()) {
+      global_ctx_->env_->SleepForMicroseconds(static_cast<int>(
+          std::min(expect_time - (now - round_start_time), MAX_SLEEP_SLICE)));
+      now = global_ctx_->env_->NowMicros();
+    }
+  }
+}
+
 int ShrinkJob::before_shrink(bool &can_shrink)
 {
   int ret = Status::kOk;
@@ -173,7 +277,7 @@ int ShrinkJob::do_shrink()
   } else if (FAILED(shrink_physical_space())) {
     XENGINE_LOG(WARN, "fail to shrink physical space", K(ret));
   } else {
-    XENGINE_LOG(INFO, "success to do shrink", K_(shrink_info));
+    XENGINE_LOG(INFO, "success to do shrink", K_(round), K_(round_shrink_info));
   }
 
   return ret;
@@ -200,7 +304,7 @@ int ShrinkJob::move_extent()
 
   if (FAILED(get_extent_infos())) {
     XENGINE_LOG(WARN, "fail to get extent infos", K(ret));
-  } else if (FAILED(global_ctx_->extent_space_mgr_->move_extens_to_front(shrink_info_, extent_replace_map_))) {
+  } else if (FAILED(global_ctx_->extent_space_mgr_->move_extens_to_front(round_shrink_info_, extent_replace_map_))) {
     XENGINE_LOG(WARN, "fail to move extents to front", K(ret));
   }
   
@@ -355,13 +459,13 @@ int ShrinkJob::shrink_physical_space()
   }
 
   if (can_shrink) {
-    if (FAILED(global_ctx_->extent_space_mgr_->shrink_extent_space(shrink_info_))) {
+    if (FAILED(global_ctx_->extent_space_mgr_->shrink_extent_space(round_shrink_info_))) {
       XENGINE_LOG(WARN, "fail to shrink extent space", K(ret));
     } else {
-      XENGINE_LOG(INFO, "success to shrink extent space", K_(shrink_info));
+      XENGINE_LOG(INFO, "success to shrink extent space", K_(round_shrink_info));
     }
   } else {
-    XENGINE_LOG(INFO, "cant't do pyhsical shrink", K_(shrink_info));
+    XENGINE_LOG(INFO, "cant't do pyhsical shrink", K_(round_shrink_info));
   }
 
   return ret;
@@ -397,18 +501,36 @@ int ShrinkJob::double_check_shrink_info(bool &can_shrink)
 {
   int ret = Status::kOk;
   ShrinkInfo current_shrink_info;
+  ShrinkCondition shrink_condition = shrink_info_.shrink_condition_;
+
+  /**the allocate interval only decides whether to start the job, the foreground
+  writes allocate extents between rounds, so ignore it after the first round*/
+  if (round_ > 0) {
+    shrink_condition.shrink_allocate_interval_ = 0;
+  }
 
   if (FAILED(global_ctx_->extent_space_mgr_->get_shrink_info(shrink_info_.table_space_id_,
-          shrink_info_.extent_space_type_, shrink_info_.shrink_condition_, current_shrink_info))) {
+          shrink_info_.extent_space_type_, shrink_condition, current_shrink_info))) {
     XENGINE_LOG(WARN, "fail to get shrink info", K(ret), K_(shrink_info));
-  } else {
+  } else if (0 == round_) {
     if (shrink_info_ == current_shrink_info) {
-      //do nothing
+      round_shrink_info_ = shrink_info_;
     } else {
       can_shrink = false;
       XENGINE_LOG(INFO, "the shrink info has changed, cancel this shrink job", K_(shrink_info),
           K(current_shrink_info));
     }
+  } else if (!current_shrink_info.is_valid()
+             || shrink_info_.index_id_set_ != current_shrink_info.index_id_set_) {
+    can_shrink = false;
+    XENGINE_LOG(INFO, "no need to shrink any more", K_(round), K_(shrink_info), K(current_shrink_info));
+  } else {
+    round_shrink_info_ = current_shrink_info;
+  }
+
+  if (SUCCED(ret) && can_shrink) {
+    round_shrink_info_.shrink_extent_count_ = std::min(round_shrink_info_.shrink_extent_count_,
+        std::min(round_extent_count_, shrink_info_.shrink_extent_count_ - shrunk_extent_count_));
   }
 
   return ret;
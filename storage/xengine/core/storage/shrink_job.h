@@ -37,12 +37,24 @@ public:
   ShrinkJob();
   ~ShrinkJob();
 
+  /**round_extent_count bounds the extents moved in one round, the subtables
+  are only held with pending_shrink for a round, rate_limit (bytes per second)
+  throttles the moved extents, 0 means unlimited, the job stops between
+  rounds once shutting_down is set*/
   int init(monitor::InstrumentedMutex *mutex,
            db::GlobalContext *global_ctx,
-           const ShrinkInfo &shrink_info);
+           const ShrinkInfo &shrink_info,
+           const int64_t round_extent_count = INT64_MAX,
+           const int64_t rate_limit = 0,
+           ShrinkProgress *progress = nullptr,
+           const std::atomic<bool> *shutting_down = nullptr);
   int run();
 
 private:
+  void reset_round();
+  void update_progress(const bool running);
+  bool is_shutting_down() const;
+  void throttle(const uint64_t round_start_time, const int64_t moved_extent_count);
   int before_shrink(bool &can_shrink);
   int do_shrink();
   int after_shrink();
@@ -63,6 +75,14 @@ private:
   monitor::InstrumentedMutex *mutex_;
   db::GlobalContext *global_ctx_;
   ShrinkInfo shrink_info_;
+  /**the part of shrink_info_ done in the current round*/
+  ShrinkInfo round_shrink_info_;
+  int64_t round_;
+  int64_t shrunk_extent_count_;
+  int64_t round_extent_count_;
+  int64_t rate_limit_;
+  ShrinkProgress *progress_;
+  const std::atomic<bool> *shutting_down_;
   std::unordered_map<int64_t, db::SubTable *> subtable_map_;
   ExtentIdInfoMap extent_info_map_;
   ExtentReplaceMap extent_replace_map_;
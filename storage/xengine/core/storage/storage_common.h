@@ -409,6 +409,46 @@ struct ShrinkInfo
   DECLARE_AND_DEFINE_TO_STRING(KV_(shrink_condition), KV_(table_space_id), KV_(extent_space_type), KV_(total_need_shrink_extent_count), KV_(shrink_extent_count));
 };
 
+/**progress of the running shrink job, protected by the db mutex*/
+struct ShrinkProgress
+{
+  bool running_;
+  int64_t table_space_id_;
+  int32_t extent_space_type_;
+  int64_t total_extent_count_;
+  int64_t shrunk_extent_count_;
+  int64_t round_count_;
+  uint64_t start_time_;
+
+  ShrinkProgress()
+      : running_(false),
+        table_space_id_(0),
+        extent_space_type_(0),
+        total_extent_count_(0),
+        shrunk_extent_count_(0),
+        round_count_(0),
+        start_time_(0)
+  {
+  }
+  ~ShrinkProgress()
+  {
+  }
+
+  void reset()
+  {
+    running_ = false;
+    table_space_id_ = 0;
+    extent_space_type_ = 0;
+    total_extent_count_ = 0;
+    shrunk_extent_count_ = 0;
+    round_count_ = 0;
+    start_time_ = 0;
+  }
+
+  DECLARE_AND_DEFINE_TO_STRING(KV_(running), KV_(table_space_id), KV_(extent_space_type), KV_(total_extent_count),
+                               KV_(shrunk_extent_count), KV_(round_count), KV_(start_time));
+};
+
 struct ExtentIOInfo
 {
   int fd_;
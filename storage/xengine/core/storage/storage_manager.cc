@@ -232,6 +232,16 @@ int64_t StorageManager::get_current_total_extent_count() const
   std::lock_guard<std::mutex> meta_mutex_guard(meta_mutex_);
   return current_meta_->get_total_extent_count();
 }
+int64_t StorageManager::get_lob_extent_count() const
+{
+  std::lock_guard<std::mutex> meta_mutex_guard(meta_mutex_);
+  return lob_extent_mgr_->get_lob_extent_count();
+}
+int64_t StorageManager::get_lob_live_ratio() const
+{
+  std::lock_guard<std::mutex> meta_mutex_guard(meta_mutex_);
+  return lob_extent_mgr_->get_live_ratio();
+}
 table::InternalIterator *StorageManager::get_single_level_iterator(const common::ReadOptions &read_options,
                                                                    util::Arena *arena,
                                                                    const db::Snapshot *current_meta,
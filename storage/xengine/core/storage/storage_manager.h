@@ -132,6 +132,8 @@ public:
                     const db::Snapshot *current_meta);
   const db::Snapshot *get_current_version() const { return current_meta_; }
   int64_t get_current_total_extent_count() const;
+  int64_t get_lob_extent_count() const;
+  int64_t get_lob_live_ratio() const;
   // todo
 //  void set_scan_add_blocks_limit(const uint64_t scan_add_blocks_limit) {
 //    mutable_cf_options_.scan_add_blocks_limit = scan_add_blocks_limit;
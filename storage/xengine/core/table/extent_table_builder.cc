@@ -308,6 +308,14 @@ ExtentBasedTableBuilder::ExtentBasedTableBuilder(
       not_flushed_normal_extent_id_(),
       not_flushed_lob_extent_id_(),
       flushed_lob_extent_ids_(),
+      value_extent_(),
+      value_buf_(PAGE_SIZE, EXTENT_SIZE, true),
+      value_zip_buf_(PAGE_SIZE, EXTENT_SIZE, true),
+      value_extent_entries_(0),
+      value_extent_smallest_key_(),
+      value_extent_largest_key_(),
+      value_extent_smallest_seqno_(kMaxSequenceNumber),
+      value_extent_largest_seqno_(0),
       is_flush_(is_flush) {
   assert(table_options_.format_version == 3);
   assert(table_options_.index_type !=
@@ -557,7 +565,13 @@ int ExtentBasedTableBuilder::Add(const Slice& key, const Slice& value) {
   }
 #endif
   if (LIKELY(value.size() < LARGE_OBJECT_SIZE)) {
-    return plain_add(key, value);
+    if (0 == ioptions_.value_separation_threshold
+        || !mtables_->separate_values
+        || value.size() < ioptions_.value_separation_threshold
+        || kTypeValue != ExtractValueType(key)) {
+      return plain_add(key, value);
+    }
+    return separate_add(key, value);
   }
 
   int ret = Status::kOk;
@@ -679,6 +693,108 @@ int ExtentBasedTableBuilder::Add(const Slice& key, const Slice& value) {
   return ret;
 }
 
+int ExtentBasedTableBuilder::separate_add(const Slice& key, const Slice& value) {
+  int ret = Status::kOk;
+  ParsedInternalKey ikey;
+  LargeValue large_value;
+  Slice stored_value(value);
+  // same as the large objects, values are compressed with the L2 compression
+  // type as they are not rebuilt on compaction
+  CompressionType zip_type = kNoCompression;
+  if (ioptions_.compression_per_level.size() >= 3) {
+    zip_type = ioptions_.compression_per_level[2];
+  }
+  value_zip_buf_.reset();
+
+  if (!ParseInternalKey(key, &ikey)) {
+    ret = Status::kCorruption;
+    XENGINE_LOG(WARN, "fail to parse internal key", K(ret));
+  } else if (kNoCompression != zip_type
+             && FAILED(compress_block(value, compression_opts_, zip_type,
+                                      LargeValue::COMPRESSION_FORMAT_VERSION,
+                                      Slice() /*dict*/, &value_zip_buf_, stored_value))) {
+    XENGINE_LOG(WARN, "fail to compress separated value", K(ret));
+  } else if (value_extent_entries_ > 0
+             && value_buf_.size() + stored_value.size() > (uint64_t)EXTENT_SIZE
+             && FAILED(flush_value_extent())) {
+    XENGINE_LOG(WARN, "fail to flush value extent", K(ret));
+  } else if (0 == value_extent_entries_
+             && FAILED(mtables_->space_manager->allocate(mtables_->table_space_id_,
+                                                         storage::HOT_EXTENT_SPACE,
+                                                         value_extent_))) {
+    XENGINE_LOG(WARN, "fail to allocate value extent", K(ret));
+  } else {
+    large_value.version_ = LargeValue::VALUE_EXTENT_VERSION;
+    large_value.compression_type_ = zip_type;
+    large_value.size_ = stored_value.size();
+    large_value.oob_extents_.push_back(value_extent_.get_extent_id());
+    large_value.offset_ = value_buf_.size();
+
+    std::string new_key(key.data(), key.size());
+    new_key[key.size() - 8] = kTypeValueLarge;
+    std::string pointer(large_value.get_serialize_size(), '\0');
+    int64_t pos = 0;
+    if (FAILED(value_buf_.append(stored_value))) {
+      XENGINE_LOG(WARN, "fail to append to value extent buffer", K(ret));
+    } else if (FAILED(large_value.serialize(&pointer[0], pointer.size(), pos))) {
+      XENGINE_LOG(WARN, "fail to serialize separated value pointer", K(ret));
+    } else {
+      if (0 == value_extent_entries_) {
+        value_extent_smallest_key_ = new_key;
+      }
+      value_extent_largest_key_ = new_key;
+      value_extent_smallest_seqno_ = std::min(value_extent_smallest_seqno_, ikey.sequence);
+      value_extent_largest_seqno_ = std::max(value_extent_largest_seqno_, ikey.sequence);
+      ++value_extent_entries_;
+      ret = plain_add(new_key, pointer);
+    }
+  }
+  return ret;
+}
+
+int ExtentBasedTableBuilder::flush_value_extent() {
+  int ret = Status::kOk;
+  storage::ExtentMeta extent_meta;
+  const storage::ExtentId extent_id = value_extent_.get_extent_id();
+
+  if (0 == value_extent_entries_) {
+    // nothing separated since the last flush
+  } else if (FAILED(value_extent_.Append(Slice(value_buf_.data(),
+                        util::Roundup(value_buf_.size(), PAGE_SIZE))).code())) {
+    XENGINE_LOG(WARN, "fail to write value extent", K(ret), K(extent_id));
+  } else if (FAILED(value_extent_.Sync().code())) {
+    XENGINE_LOG(WARN, "fail to sync value extent", K(ret), K(extent_id));
+  } else {
+    extent_meta.attr_ = storage::ExtentMeta::F_LARGE_OBJECT_EXTENT;
+    extent_meta.smallest_key_.DecodeFrom(value_extent_smallest_key_);
+    extent_meta.largest_key_.DecodeFrom(value_extent_largest_key_);
+    extent_meta.extent_id_ = extent_id;
+    extent_meta.smallest_seqno_ = value_extent_smallest_seqno_;
+    extent_meta.largest_seqno_ = value_extent_largest_seqno_;
+    extent_meta.refs_ = 0;
+    extent_meta.data_size_ = value_buf_.size();
+    extent_meta.index_size_ = 0;
+    extent_meta.num_data_blocks_ = 1;
+    // the large object extent manager keeps the extent until as many values
+    // have been dropped
+    extent_meta.num_entries_ = value_extent_entries_;
+    extent_meta.num_deletes_ = 0;
+    extent_meta.table_space_id_ = mtables_->table_space_id_;
+    extent_meta.extent_space_type_ = storage::HOT_EXTENT_SPACE;
+    if (FAILED(write_extent_meta(extent_meta, true /*is_large_object_extent*/))) {
+      XENGINE_LOG(WARN, "fail to write value extent meta", K(ret), K(extent_meta));
+    } else {
+      flushed_lob_extent_ids_.push_back(extent_id);
+      value_extent_entries_ = 0;
+      value_extent_smallest_seqno_ = kMaxSequenceNumber;
+      value_extent_largest_seqno_ = 0;
+      value_buf_.reset();
+      value_extent_.reset();
+    }
+  }
+  return ret;
+}
+
 int ExtentBasedTableBuilder::plain_add(const Slice& key, const Slice& value) {
 
   int& ret = status_;
@@ -1291,6 +1407,7 @@ int ExtentBasedTableBuilder::Finish() {
   if (status_ != Status::kOk) return status_;
 
   int ret = Status::kOk;
+  FAIL_RETURN_MSG(flush_value_extent(), "failed on flush_value_extent(%d)", ret);
   FAIL_RETURN_MSG(finish_one_sst(), "failed on finish_one_sst(%d)", ret);
   return ret;
 }
@@ -1335,6 +1452,19 @@ int ExtentBasedTableBuilder::Abandon() {
     }
   }
 
+  /**recycle not flushed value extent*/
+  if (SUCCED(ret) && value_extent_entries_ > 0) {
+    extent_id = value_extent_.get_extent_id();
+    if (FAILED(mtables_->space_manager->recycle(
+        mtables_->table_space_id_, storage::HOT_EXTENT_SPACE,
+        extent_id, false /*no extent meta*/))) {
+      XENGINE_LOG(WARN, "fail to recycle not flushed value extent", K(ret), K(extent_id));
+    } else {
+      value_extent_entries_ = 0;
+      value_extent_.reset();
+    }
+  }
+
   /**recycle not flushed lob extent*/
   if (SUCCED(ret) && 0 != not_flushed_lob_extent_id_.id()) {
     if (FAILED(mtables_->space_manager->recycle(
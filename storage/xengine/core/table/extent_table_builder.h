@@ -194,6 +194,13 @@ class ExtentBasedTableBuilder : public TableBuilder {
                                      const int64_t data_size,
                                      storage::ExtentMeta &extent_meta);
   int write_extent_meta(const storage::ExtentMeta &extent_meta, bool is_large_object_extent);
+  // Values of at least ioptions_.value_separation_threshold bytes, and
+  // smaller than LARGE_OBJECT_SIZE, are appended to a value extent shared
+  // with other separated values, only a pointer to it is kept in the sst.
+  int separate_add(const common::Slice& key, const common::Slice& value);
+  // Write the pending value extent out and hand it to the large object
+  // extent manager, which recycles it once all its values are dropped.
+  int flush_value_extent();
 
   struct Rep;
   Rep* rep_;
@@ -225,6 +232,15 @@ class ExtentBasedTableBuilder : public TableBuilder {
   storage::ExtentId not_flushed_normal_extent_id_;
   storage::ExtentId not_flushed_lob_extent_id_;
   util::autovector<storage::ExtentId> flushed_lob_extent_ids_;
+  // the value extent being filled by separate_add
+  storage::WritableExtent value_extent_;
+  util::WritableBuffer value_buf_;
+  util::WritableBuffer value_zip_buf_;
+  int64_t value_extent_entries_;
+  std::string value_extent_smallest_key_;
+  std::string value_extent_largest_key_;
+  common::SequenceNumber value_extent_smallest_seqno_;
+  common::SequenceNumber value_extent_largest_seqno_;
   bool is_flush_;
 #ifndef NDEBUG
   bool test_ignore_flush_data_;
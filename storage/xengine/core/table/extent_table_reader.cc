@@ -15,6 +15,7 @@
 #include <utility>
 #include <vector>
 
+#include "cache/cache_prewarm.h"
 #include "db/dbformat.h"
 #include "db/pinned_iterators_manager.h"
 
@@ -1565,6 +1566,11 @@ Status ExtentBasedTable::MaybeLoadDataBlockToCache(
   Status s;
   if (block_cache != nullptr || block_cache_compressed != nullptr) {
     Statistics* statistics = rep->ioptions.statistics;
+    if (!is_index && ro.fill_cache
+        && nullptr != rep->ioptions.hot_cache_tracker) {
+      rep->ioptions.hot_cache_tracker->record_block(
+          rep->fd.extent_id.id(), handle.offset(), handle.size());
+    }
     char cache_key[kMaxCacheKeyPrefixSize + kMaxVarint64Length];
     char compressed_cache_key[kMaxCacheKeyPrefixSize + kMaxVarint64Length];
     Slice key, /* key to the block cache */
@@ -2683,6 +2689,12 @@ int ExtentBasedTable::prefetch_data_block(const ReadOptions &read_options,
     char compressed_cache_key[kMaxCacheKeyPrefixSize + kMaxVarint64Length];
     Slice key, /* key to the block cache */
           ckey /* key to the compressed block cache */;
+    if (read_options.fill_cache && nullptr != rep_->ioptions.hot_cache_tracker) {
+      rep_->ioptions.hot_cache_tracker->record_block(
+          rep_->fd.extent_id.id(),
+          handle.block_handle_.offset(),
+          handle.block_handle_.size());
+    }
 
     // create key for block cache
     if (block_cache != nullptr) {
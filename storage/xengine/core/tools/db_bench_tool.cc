@@ -141,6 +141,8 @@ DEFINE_string(
     "randomtransaction,"
     "randomreplacekeys,"
     "timeseries,"
+    "fillrows,"
+    "rowsmixed,"
     "stress",
 
     "Comma-separated list of operations to run in the specified"
@@ -199,7 +201,13 @@ DEFINE_string(
     "\trandomreplacekeys     -- randomly replaces N keys by deleting "
     "the old version and putting the new version\n\n"
     "\ttimeseries            -- 1 writer generates time series data "
-    "and multiple readers doing random reads on id\n\n"
+    "and multiple readers doing random reads on id\n"
+    "\tfillrows              -- insert N wide rows under a primary key "
+    "plus one entry per secondary index, one transaction per row\n"
+    "\trowsmixed             -- N threads doing primary key point reads, "
+    "secondary index range reads and secondary key updates on the rows "
+    "of fillrows. Both measure the engine only, they do not run the "
+    "SQL handler\n\n"
     "Meta operations:\n"
     "\tcompact     -- Compact the entire DB\n"
     "\tstats       -- Print DB stats\n"
@@ -739,6 +747,28 @@ DEFINE_int32(transaction_sleep, 0,
 DEFINE_uint64(transaction_lock_timeout, 100,
               "If using a transaction_db, specifies the lock wait timeout in"
               " milliseconds before failing a transaction waiting on a lock");
+
+DEFINE_int32(row_columns, 20,
+             "Number of columns of the rows of fillrows/rowsmixed, half of "
+             "them are BIGINT and the others VARCHAR");
+
+DEFINE_int32(row_varchar_size, 32,
+             "Max length of the VARCHAR columns of fillrows/rowsmixed");
+
+DEFINE_int32(row_secondary_indexes, 3,
+             "Number of secondary indexes of fillrows/rowsmixed, each one is "
+             "on a BIGINT column");
+
+DEFINE_int32(row_read_percent, 50,
+             "Percentage of primary key point reads in rowsmixed");
+
+DEFINE_int32(row_range_percent, 20,
+             "Percentage of secondary index range reads in rowsmixed, the "
+             "others are secondary key updates");
+
+DEFINE_int32(row_range_size, 10,
+             "Number of rows read by a secondary index range read of "
+             "rowsmixed");
 DEFINE_string(
     options_file, "",
     "The path to a XENGINE options file.  If specified, then db_bench will "
@@ -1507,6 +1537,205 @@ class ReporterAgent {
   bool stop_;
 };
 
+#ifndef ROCKSDB_LITE
+// A table of wide rows with secondary indexes, stored as one key/value per
+// row and per index entry. The encoding is the tool's own and only gives the
+// engine relational-looking keys and values. Every key starts with the 4
+// bytes big endian index id followed by the memcmp-able key parts.
+// The primary key entry maps the primary key to the packed row: the null
+// bitmap, the 8 bytes BIGINT columns, then the length prefixed VARCHAR
+// columns. A secondary key entry is the secondary key plus the primary key
+// with an empty value. Secondary index k is on BIGINT column k.
+class RowShapedTable {
+ public:
+  static const uint32_t kPrimaryIndexId = 256;
+
+  RowShapedTable()
+      : int_columns_((FLAGS_row_columns + 1) / 2),
+        varchar_columns_(FLAGS_row_columns / 2),
+        secondary_indexes_(
+            std::min(FLAGS_row_secondary_indexes, int_columns_)) {}
+
+  int secondary_indexes() const { return secondary_indexes_; }
+
+  void EncodePrimaryKey(int64_t pk, std::string* key) const {
+    key->clear();
+    PutIndexId(kPrimaryIndexId, key);
+    PutMemcmpInt(pk, key);
+  }
+
+  void EncodeSecondaryKey(int k, int64_t column, int64_t pk,
+                          std::string* key) const {
+    key->clear();
+    PutIndexId(kPrimaryIndexId + 1 + k, key);
+    PutMemcmpInt(column, key);
+    PutMemcmpInt(pk, key);
+  }
+
+  // Prefix of all the secondary keys of index k starting from column
+  void EncodeSecondaryPrefix(int k, int64_t column, std::string* key) const {
+    key->clear();
+    PutIndexId(kPrimaryIndexId + 1 + k, key);
+    PutMemcmpInt(column, key);
+  }
+
+  void EncodeRow(Random64* rand, RandomGenerator* gen,
+                 std::vector<int64_t>* ints, std::string* row) const {
+    ints->resize(int_columns_);
+    row->clear();
+    row->append(BitmapSize(), '\0');
+    for (int i = 0; i < int_columns_; ++i) {
+      (*ints)[i] = static_cast<int64_t>(rand->Next() % FLAGS_num);
+      PutFixed64(row, static_cast<uint64_t>((*ints)[i]));
+    }
+    for (int i = 0; i < varchar_columns_; ++i) {
+      uint32_t len = static_cast<uint32_t>(
+          rand->Next() % (FLAGS_row_varchar_size + 1));
+      Slice data = gen->Generate(len);
+      row->push_back(static_cast<char>(len & 0xff));
+      if (LengthSize() > 1) {
+        row->push_back(static_cast<char>(len >> 8));
+      }
+      row->append(data.data(), data.size());
+    }
+  }
+
+  // Update BIGINT column i of a packed row in place
+  void SetIntColumn(int i, int64_t value, std::string* row) const {
+    EncodeFixed64(&(*row)[BitmapSize() + 8 * i], static_cast<uint64_t>(value));
+  }
+
+  // Unpack the BIGINT columns and walk the VARCHAR ones
+  bool DecodeRow(const Slice& row, std::vector<int64_t>* ints) const {
+    Slice input(row);
+    if (input.size() < BitmapSize() + 8 * int_columns_) {
+      return false;
+    }
+    input.remove_prefix(BitmapSize());
+    ints->resize(int_columns_);
+    for (int i = 0; i < int_columns_; ++i) {
+      (*ints)[i] = static_cast<int64_t>(DecodeFixed64(input.data()));
+      input.remove_prefix(8);
+    }
+    for (int i = 0; i < varchar_columns_; ++i) {
+      if (input.size() < LengthSize()) {
+        return false;
+      }
+      size_t len = static_cast<uint8_t>(input[0]);
+      if (LengthSize() > 1) {
+        len |= static_cast<size_t>(static_cast<uint8_t>(input[1])) << 8;
+      }
+      input.remove_prefix(LengthSize());
+      if (input.size() < len) {
+        return false;
+      }
+      input.remove_prefix(len);
+    }
+    return true;
+  }
+
+  // Primary key of a secondary key entry
+  static int64_t DecodePrimaryKey(const Slice& secondary_key) {
+    return GetMemcmpInt(secondary_key.data() + secondary_key.size() - 8);
+  }
+
+ private:
+  static size_t BitmapSize() { return (FLAGS_row_columns + 7) / 8; }
+
+  // VARCHAR lengths take 2 bytes once they may exceed 255
+  static size_t LengthSize() { return FLAGS_row_varchar_size < 256 ? 1 : 2; }
+
+  static void PutIndexId(uint32_t index_id, std::string* dst) {
+    char buf[4];
+    buf[0] = static_cast<char>(index_id >> 24);
+    buf[1] = static_cast<char>(index_id >> 16);
+    buf[2] = static_cast<char>(index_id >> 8);
+    buf[3] = static_cast<char>(index_id);
+    dst->append(buf, sizeof(buf));
+  }
+
+  // Signed integers are stored big endian with the sign bit flipped
+  static void PutMemcmpInt(int64_t value, std::string* dst) {
+    uint64_t v = static_cast<uint64_t>(value) ^ (1ULL << 63);
+    char buf[8];
+    for (int i = 7; i >= 0; --i) {
+      buf[i] = static_cast<char>(v & 0xff);
+      v >>= 8;
+    }
+    dst->append(buf, sizeof(buf));
+  }
+
+  static int64_t GetMemcmpInt(const char* src) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) {
+      v = (v << 8) | static_cast<uint8_t>(src[i]);
+    }
+    return static_cast<int64_t>(v ^ (1ULL << 63));
+  }
+
+  const int int_columns_;
+  const int varchar_columns_;
+  const int secondary_indexes_;
+};
+
+// One statement against the row-shaped table. With --transaction_db it runs
+// in a pessimistic transaction, otherwise the changes are collected in a
+// write batch.
+class RowStatement {
+ public:
+  RowStatement(DB* db, const WriteOptions& write_options,
+               const TransactionOptions& txn_options)
+      : db_(db),
+        txn_db_(FLAGS_transaction_db ? reinterpret_cast<TransactionDB*>(db)
+                                     : nullptr),
+        write_options_(write_options),
+        txn_options_(txn_options),
+        txn_(nullptr) {}
+
+  ~RowStatement() { delete txn_; }
+
+  void Begin() {
+    batch_.Clear();
+    if (txn_db_ != nullptr) {
+      txn_ = txn_db_->BeginTransaction(write_options_, txn_options_, txn_);
+    }
+  }
+
+  Status GetForUpdate(const ReadOptions& options, const Slice& key,
+                      std::string* value) {
+    return txn_ != nullptr ? txn_->GetForUpdate(options, key, value)
+                           : db_->Get(options, key, value);
+  }
+
+  Status Put(const Slice& key, const Slice& value) {
+    return txn_ != nullptr ? txn_->Put(key, value) : batch_.Put(key, value);
+  }
+
+  Status Delete(const Slice& key) {
+    return txn_ != nullptr ? txn_->Delete(key) : batch_.Delete(key);
+  }
+
+  Status Commit() {
+    return txn_ != nullptr ? txn_->Commit()
+                           : db_->Write(write_options_, &batch_);
+  }
+
+  void Rollback() {
+    if (txn_ != nullptr) {
+      txn_->Rollback();
+    }
+  }
+
+ private:
+  DB* db_;
+  TransactionDB* txn_db_;
+  const WriteOptions& write_options_;
+  const TransactionOptions& txn_options_;
+  Transaction* txn_;
+  WriteBatch batch_;
+};
+#endif  // ROCKSDB_LITE
+
 enum OperationType : unsigned char {
   kRead = 0,
   kWrite,
@@ -3132,6 +3361,10 @@ class Benchmark {
       } else if (name == "randomtransaction") {
         method = &Benchmark::RandomTransaction;
         post_process_method = &Benchmark::RandomTransactionVerify;
+      } else if (name == "fillrows") {
+        method = &Benchmark::FillRows;
+      } else if (name == "rowsmixed") {
+        method = &Benchmark::RowsMixed;
 #endif  // ROCKSDB_LITE
       } else if (name == "randomreplacekeys") {
         fresh_db = true;
@@ -5659,6 +5892,204 @@ class Benchmark {
       fprintf(stdout, "RandomTransactionVerify FAILED!!\n");
     }
   }
+
+  static bool IsRowConflict(const Status& s) {
+    return s.IsBusy() || s.IsTimedOut() || s.IsTryAgain();
+  }
+
+  // Inserts --num rows of the row-shaped table, the primary keys are spread
+  // over the threads. Each row is inserted with its secondary index entries
+  // in one transaction.
+  void FillRows(ThreadState* thread) {
+    RowShapedTable table;
+    RandomGenerator gen;
+    TransactionOptions txn_options;
+    txn_options.lock_timeout = FLAGS_transaction_lock_timeout;
+    RowStatement stmt(db_.db, write_options_, txn_options);
+    std::vector<int64_t> ints;
+    std::vector<std::string> secondary_keys(table.secondary_indexes());
+    std::string key;
+    std::string row;
+    int64_t rows = 0;
+    int64_t aborts = 0;
+    int64_t bytes = 0;
+    int threads = thread->shared->total;
+    int64_t rows_per_thread = (num_ + threads - 1) / threads;
+    Duration duration(FLAGS_duration, rows_per_thread);
+
+    for (int64_t pk = thread->tid; pk < num_ && !duration.Done(1);
+         pk += threads) {
+      table.EncodeRow(&thread->rand, &gen, &ints, &row);
+      table.EncodePrimaryKey(pk, &key);
+      for (int k = 0; k < table.secondary_indexes(); ++k) {
+        table.EncodeSecondaryKey(k, ints[k], pk, &secondary_keys[k]);
+      }
+
+      stmt.Begin();
+      Status s = stmt.Put(key, row);
+      for (int k = 0; s.ok() && k < table.secondary_indexes(); ++k) {
+        s = stmt.Put(secondary_keys[k], Slice());
+      }
+      if (s.ok()) {
+        s = stmt.Commit();
+      }
+      if (s.ok()) {
+        ++rows;
+        bytes += key.size() + row.size();
+        for (const auto& secondary_key : secondary_keys) {
+          bytes += secondary_key.size();
+        }
+      } else if (IsRowConflict(s)) {
+        stmt.Rollback();
+        ++aborts;
+      } else {
+        fprintf(stderr, "fillrows error: %s\n", s.ToString().c_str());
+        abort();
+      }
+      thread->stats.FinishedOps(nullptr, db_.db, 1, kWrite);
+    }
+
+    char msg[100];
+    snprintf(msg, sizeof(msg), "( rows:%" PRIi64 " aborts:%" PRIi64 " )", rows,
+             aborts);
+    thread->stats.AddBytes(bytes);
+    thread->stats.AddMessage(msg);
+  }
+
+  // Runs the statements of an OLTP application against the rows of fillrows:
+  //   SELECT * FROM t WHERE pk = ?
+  //   SELECT * FROM t WHERE sk >= ? LIMIT --row_range_size
+  //   UPDATE t SET sk = ? WHERE pk = ?
+  // The ops include encoding the rows and keys, which is cheap next to the
+  // engine calls.
+  void RowsMixed(ThreadState* thread) {
+    ReadOptions read_options(FLAGS_verify_checksum, true);
+    RowShapedTable table;
+    TransactionOptions txn_options;
+    txn_options.lock_timeout = FLAGS_transaction_lock_timeout;
+    RowStatement stmt(db_.db, write_options_, txn_options);
+    std::vector<int64_t> ints;
+    std::vector<int64_t> pks;
+    std::string key;
+    std::string row;
+    std::string old_secondary_key;
+    std::string new_secondary_key;
+    int64_t reads = 0;
+    int64_t found = 0;
+    int64_t ranges = 0;
+    int64_t range_rows = 0;
+    int64_t updates = 0;
+    int64_t aborts = 0;
+    Duration duration(FLAGS_duration, readwrites_);
+
+    while (!duration.Done(1)) {
+      int64_t pk = static_cast<int64_t>(thread->rand.Next() % FLAGS_num);
+      int percent = static_cast<int>(thread->rand.Next() % 100);
+      OperationType op_type = kRead;
+
+      if (percent < FLAGS_row_read_percent) {
+        table.EncodePrimaryKey(pk, &key);
+
+        Status s = db_.db->Get(read_options, key, &row);
+        if (s.ok()) {
+          table.DecodeRow(row, &ints);
+          ++found;
+        } else if (!s.IsNotFound()) {
+          fprintf(stderr, "rowsmixed get error: %s\n", s.ToString().c_str());
+          abort();
+        }
+        ++reads;
+      } else if (percent < FLAGS_row_read_percent + FLAGS_row_range_percent &&
+                 table.secondary_indexes() > 0) {
+        int k = static_cast<int>(thread->rand.Next() %
+                                 table.secondary_indexes());
+        table.EncodeSecondaryPrefix(
+            k, static_cast<int64_t>(thread->rand.Next() % FLAGS_num), &key);
+
+        // Walk the secondary index, then look up the rows by primary key
+        pks.clear();
+        Slice index_id(key.data(), 4);
+        std::unique_ptr<Iterator> iter(db_.db->NewIterator(read_options));
+        for (iter->Seek(key);
+             iter->Valid() && iter->key().starts_with(index_id) &&
+             static_cast<int>(pks.size()) < FLAGS_row_range_size;
+             iter->Next()) {
+          pks.push_back(RowShapedTable::DecodePrimaryKey(iter->key()));
+        }
+        iter.reset();
+
+        for (int64_t row_pk : pks) {
+          table.EncodePrimaryKey(row_pk, &key);
+
+          Status s = db_.db->Get(read_options, key, &row);
+          if (s.ok()) {
+            table.DecodeRow(row, &ints);
+            ++range_rows;
+          }
+        }
+        ++ranges;
+        op_type = kSeek;
+      } else {
+        table.EncodePrimaryKey(pk, &key);
+
+        stmt.Begin();
+        Status s = stmt.GetForUpdate(read_options, key, &row);
+        if (s.ok()) {
+          bool valid = table.DecodeRow(row, &ints);
+          if (!valid) {
+            fprintf(stderr, "rowsmixed corrupted row %" PRIi64 "\n", pk);
+            abort();
+          }
+
+          // Move the row to a new value of an indexed column
+          int k = table.secondary_indexes() > 0
+                      ? static_cast<int>(thread->rand.Next() %
+                                         table.secondary_indexes())
+                      : -1;
+          int64_t value = static_cast<int64_t>(thread->rand.Next() % FLAGS_num);
+          if (k >= 0) {
+            table.EncodeSecondaryKey(k, ints[k], pk, &old_secondary_key);
+            table.EncodeSecondaryKey(k, value, pk, &new_secondary_key);
+            table.SetIntColumn(k, value, &row);
+          }
+
+          if (k >= 0) {
+            s = stmt.Delete(old_secondary_key);
+            if (s.ok()) {
+              s = stmt.Put(new_secondary_key, Slice());
+            }
+          }
+          if (s.ok()) {
+            s = stmt.Put(key, row);
+          }
+          if (s.ok()) {
+            s = stmt.Commit();
+          }
+        }
+        if (s.IsNotFound()) {
+          stmt.Rollback();
+        } else if (IsRowConflict(s)) {
+          stmt.Rollback();
+          ++aborts;
+        } else if (!s.ok()) {
+          fprintf(stderr, "rowsmixed update error: %s\n",
+                  s.ToString().c_str());
+          abort();
+        }
+        ++updates;
+        op_type = kUpdate;
+      }
+      thread->stats.FinishedOps(nullptr, db_.db, 1, op_type);
+    }
+
+    char msg[200];
+    snprintf(msg, sizeof(msg),
+             "( reads:%" PRIi64 " found:%" PRIi64 " ranges:%" PRIi64
+             " range_rows:%" PRIi64 " updates:%" PRIi64 " aborts:%" PRIi64
+             " )",
+             reads, found, ranges, range_rows, updates, aborts);
+    thread->stats.AddMessage(msg);
+  }
 #endif  // ROCKSDB_LITE
 
   // Writes and deletes random keys without overwriting keys.
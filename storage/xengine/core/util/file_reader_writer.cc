@@ -127,11 +127,14 @@ int RandomAccessFileReader::read(int64_t offset,
   if (nullptr != aio_handle) {
     // try aio
     AIOInfo aio_info;
+    uint64_t start_micros = (nullptr != rate_limiter_ && nullptr != env_) ? env_->NowMicros() : 0;
     if (FAILED(file_->fill_aio_info(offset, size, aio_info))) {
       XENGINE_LOG(WARN, "failed to fill io info", K(ret), K(offset), K(size));
     } else if (FAILED(aio_handle->read(aio_info.offset_, aio_info.size_, result, scratch))) {
       XENGINE_LOG(WARN, "aio handle read failed", K(ret), K(offset), K(size), K(aio_info));
       BACKTRACE(ERROR, "aio handle read failed");
+    } else if (0 != start_micros) {
+      rate_limiter_->ReportForegroundRead(env_->NowMicros() - start_micros);
     }
   }
   // use sync IO or aio read failed
@@ -180,6 +183,7 @@ Status RandomAccessFileReader::Read(uint64_t offset, size_t n, Slice* result,
                                     char* scratch) const {
   Status s;
   uint64_t elapsed = 0;
+  uint64_t start_micros = (nullptr != rate_limiter_ && nullptr != env_) ? env_->NowMicros() : 0;
   {
     IOSTATS_TIMER_GUARD(read_nanos);
     if (use_direct_io()) {
@@ -206,6 +210,9 @@ Status RandomAccessFileReader::Read(uint64_t offset, size_t n, Slice* result,
     }
     IOSTATS_ADD_IF_POSITIVE(bytes_read, result->size());
   }
+  if (0 != start_micros && s.ok()) {
+    rate_limiter_->ReportForegroundRead(env_->NowMicros() - start_micros);
+  }
   return s;
 }
 
@@ -85,6 +85,8 @@ class RandomAccessFileReader {
   monitor::Statistics* stats_;
   uint32_t hist_type_;
   monitor::HistogramImpl* file_read_hist_;
+  // the latency of the reads is reported to it as foreground reads
+  RateLimiter* rate_limiter_;
 
  public:
   // used to read the next extent in the same logic file
@@ -103,6 +105,7 @@ class RandomAccessFileReader {
         stats_(stats),
         hist_type_(hist_type),
         file_read_hist_(file_read_hist),
+        rate_limiter_(nullptr),
         ioptions_(ioptions),
         env_options_(env_options),
         use_allocator_(use_allocator) {}
@@ -121,6 +124,7 @@ class RandomAccessFileReader {
     stats_ = std::move(o.stats_);
     hist_type_ = std::move(o.hist_type_);
     file_read_hist_ = std::move(o.file_read_hist_);
+    rate_limiter_ = o.rate_limiter_;
     return *this;
   }
 
@@ -136,6 +140,9 @@ class RandomAccessFileReader {
   }
 
   RandomAccessFile* file() { return file_; }
+  void set_rate_limiter(RateLimiter* rate_limiter) {
+    rate_limiter_ = rate_limiter;
+  }
   RandomAccessFile* release_file() {
     auto rfile = file_;
     file_ = nullptr;
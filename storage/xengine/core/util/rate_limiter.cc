@@ -32,9 +32,24 @@ struct GenericRateLimiter::Req {
   bool granted;
 };
 
+namespace {
+// Tune once every kRefillsPerTune refill periods
+const int64_t kRefillsPerTune = 100;
+// Lower the rate if the rate limiter drains less often than kLowWatermarkPct
+// of the refill periods, raise it if more often than kHighWatermarkPct. A
+// limiter that never drained isn't binding, its rate is left as is.
+const int64_t kLowWatermarkPct = 50;
+const int64_t kHighWatermarkPct = 90;
+const int64_t kAdjustFactorPct = 5;
+// Lower the rate faster when the foreground reads are too slow
+const int64_t kBackoffFactorPct = 25;
+const int64_t kAllowedRangeFactor = 20;
+}  // namespace
+
 GenericRateLimiter::GenericRateLimiter(int64_t rate_bytes_per_sec,
                                        int64_t refill_period_us,
-                                       int32_t fairness)
+                                       int32_t fairness,
+                                       bool auto_tuned)
     : refill_period_us_(refill_period_us),
       refill_bytes_per_period_(
           CalculateRefillBytesPerPeriod(rate_bytes_per_sec)),
@@ -46,7 +61,16 @@ GenericRateLimiter::GenericRateLimiter(int64_t rate_bytes_per_sec,
       next_refill_us_(NowMicrosMonotonic(env_)),
       fairness_(fairness > 100 ? 100 : fairness),
       rnd_((uint32_t)time(nullptr)),
-      leader_(nullptr) {
+      leader_(nullptr),
+      auto_tuned_(auto_tuned),
+      max_bytes_per_sec_(rate_bytes_per_sec),
+      rate_bytes_per_sec_(rate_bytes_per_sec),
+      num_drains_(0),
+      tuned_time_(NowMicrosMonotonic(env_)),
+      fg_read_micros_(0),
+      fg_read_count_(0),
+      fg_read_latency_(0),
+      fg_read_latency_target_(0) {
   total_requests_[0] = 0;
   total_requests_[1] = 0;
   total_bytes_through_[0] = 0;
@@ -72,6 +96,9 @@ GenericRateLimiter::~GenericRateLimiter() {
 // This API allows user to dynamically change rate limiter's bytes per second.
 void GenericRateLimiter::SetBytesPerSecond(int64_t bytes_per_second) {
   assert(bytes_per_second > 0);
+  // The auto tuned rate starts over from the new upper bound
+  max_bytes_per_sec_.store(bytes_per_second, std::memory_order_relaxed);
+  rate_bytes_per_sec_.store(bytes_per_second, std::memory_order_relaxed);
   refill_bytes_per_period_.store(
       CalculateRefillBytesPerPeriod(bytes_per_second),
       std::memory_order_relaxed);
@@ -79,13 +106,24 @@ void GenericRateLimiter::SetBytesPerSecond(int64_t bytes_per_second) {
 
 void GenericRateLimiter::Request(int64_t bytes, const Env::IOPriority pri,
                                  Statistics* stats) {
-  assert(bytes <= refill_bytes_per_period_.load(std::memory_order_relaxed));
   TEST_SYNC_POINT("GenericRateLimiter::Request");
   MutexLock g(&request_mutex_);
   if (stop_) {
     return;
   }
 
+  if (auto_tuned_) {
+    int64_t now = NowMicrosMonotonic(env_);
+    if (now - tuned_time_ >= kRefillsPerTune * refill_period_us_) {
+      Tune(now);
+    }
+  }
+
+  // The burst may have been lowered by Tune() or SetBytesPerSecond() since
+  // the caller sized its request, never wait for more than one refill.
+  bytes = std::min(bytes,
+                   refill_bytes_per_period_.load(std::memory_order_relaxed));
+
   ++total_requests_[pri];
 
   if (available_bytes_ >= bytes) {
@@ -121,6 +159,7 @@ void GenericRateLimiter::Request(int64_t bytes, const Env::IOPriority pri,
       } else {
         int64_t wait_until = env_->NowMicros() + delta;
         QUERY_COUNT(CountPoint::NUMBER_RATE_LIMITER_DRAINS);
+        ++num_drains_;
         //__XENGINE_LOG(DEBUG, "rate limiter drain\n"); 
         timedout = r.cv.TimedWait(wait_until);
       }
@@ -225,6 +264,60 @@ void GenericRateLimiter::Refill() {
   }
 }
 
+// Called with request_mutex_ held. The rate is lowered quickly while the
+// foreground reads are slower than the target, otherwise it follows how
+// often the background IO has been throttled since the last tune, by
+// kAdjustFactorPct per tune.
+void GenericRateLimiter::Tune(const int64_t now) {
+  const int64_t max_bytes_per_sec =
+      max_bytes_per_sec_.load(std::memory_order_relaxed);
+  const int64_t min_bytes_per_sec =
+      std::max(max_bytes_per_sec / kAllowedRangeFactor, static_cast<int64_t>(1));
+  const int64_t prev_bytes_per_sec =
+      rate_bytes_per_sec_.load(std::memory_order_relaxed);
+  int64_t new_bytes_per_sec = prev_bytes_per_sec;
+
+  const int64_t elapsed_intervals =
+      (now - tuned_time_ + refill_period_us_ - 1) / refill_period_us_;
+  const int64_t drained_pct =
+      num_drains_ * 100 / std::max(elapsed_intervals, static_cast<int64_t>(1));
+
+  const uint64_t fg_read_count = fg_read_count_.exchange(0);
+  const uint64_t fg_read_micros = fg_read_micros_.exchange(0);
+  const uint64_t fg_read_latency =
+      fg_read_count > 0 ? fg_read_micros / fg_read_count : 0;
+  const uint64_t fg_read_latency_target =
+      fg_read_latency_target_.load(std::memory_order_relaxed);
+  fg_read_latency_.store(fg_read_latency, std::memory_order_relaxed);
+
+  if (fg_read_latency_target > 0 && fg_read_latency > fg_read_latency_target) {
+    new_bytes_per_sec = prev_bytes_per_sec * 100 / (100 + kBackoffFactorPct);
+  } else if (0 == drained_pct) {
+    // Idle or under the rate, keep it for the next burst of background IO
+  } else if (drained_pct < kLowWatermarkPct) {
+    new_bytes_per_sec = prev_bytes_per_sec * 100 / (100 + kAdjustFactorPct);
+  } else if (drained_pct > kHighWatermarkPct) {
+    // avoid overflow
+    if (prev_bytes_per_sec > port::kMaxInt64 / (100 + kAdjustFactorPct)) {
+      new_bytes_per_sec = max_bytes_per_sec;
+    } else {
+      new_bytes_per_sec = prev_bytes_per_sec * (100 + kAdjustFactorPct) / 100;
+    }
+  }
+  new_bytes_per_sec = std::max(min_bytes_per_sec,
+                               std::min(max_bytes_per_sec, new_bytes_per_sec));
+
+  if (new_bytes_per_sec != prev_bytes_per_sec) {
+    rate_bytes_per_sec_.store(new_bytes_per_sec, std::memory_order_relaxed);
+    refill_bytes_per_period_.store(
+        CalculateRefillBytesPerPeriod(new_bytes_per_sec),
+        std::memory_order_relaxed);
+  }
+
+  num_drains_ = 0;
+  tuned_time_ = now;
+}
+
 int64_t GenericRateLimiter::CalculateRefillBytesPerPeriod(
     int64_t rate_bytes_per_sec) {
   if (port::kMaxInt64 / rate_bytes_per_sec < refill_period_us_) {
@@ -238,11 +331,13 @@ int64_t GenericRateLimiter::CalculateRefillBytesPerPeriod(
 }
 
 RateLimiter* NewGenericRateLimiter(int64_t rate_bytes_per_sec,
-                                   int64_t refill_period_us, int32_t fairness) {
+                                   int64_t refill_period_us, int32_t fairness,
+                                   bool auto_tuned) {
   assert(rate_bytes_per_sec > 0);
   assert(refill_period_us > 0);
   assert(fairness > 0);
-  return new GenericRateLimiter(rate_bytes_per_sec, refill_period_us, fairness);
+  return new GenericRateLimiter(rate_bytes_per_sec, refill_period_us, fairness,
+                                auto_tuned);
 }
 
 }  // namespace util
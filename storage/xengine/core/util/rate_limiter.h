@@ -25,7 +25,7 @@ namespace util {
 class GenericRateLimiter : public RateLimiter {
  public:
   GenericRateLimiter(int64_t refill_bytes, int64_t refill_period_us,
-                     int32_t fairness);
+                     int32_t fairness, bool auto_tuned = false);
 
   virtual ~GenericRateLimiter();
 
@@ -33,8 +33,8 @@ class GenericRateLimiter : public RateLimiter {
   virtual void SetBytesPerSecond(int64_t bytes_per_second) override;
 
   // Request for token to write bytes. If this request can not be satisfied,
-  // the call is blocked. Caller is responsible to make sure
-  // bytes <= GetSingleBurstBytes()
+  // the call is blocked. Requests larger than GetSingleBurstBytes() are
+  // clamped to it.
   using RateLimiter::Request;
   virtual void Request(const int64_t bytes, const Env::IOPriority pri,
                        monitor::Statistics* stats) override;
@@ -62,8 +62,30 @@ class GenericRateLimiter : public RateLimiter {
     return total_requests_[pri];
   }
 
+  virtual int64_t GetBytesPerSecond() const override {
+    return rate_bytes_per_sec_.load(std::memory_order_relaxed);
+  }
+
+  virtual bool IsAutoTuned() const override { return auto_tuned_; }
+
+  virtual void ReportForegroundRead(const uint64_t micros) override {
+    if (auto_tuned_) {
+      fg_read_micros_.fetch_add(micros, std::memory_order_relaxed);
+      fg_read_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  virtual uint64_t GetForegroundReadLatency() const override {
+    return fg_read_latency_.load(std::memory_order_relaxed);
+  }
+
+  virtual void SetForegroundReadLatencyTarget(const uint64_t micros) override {
+    fg_read_latency_target_.store(micros, std::memory_order_relaxed);
+  }
+
  private:
   void Refill();
+  void Tune(const int64_t now);
   int64_t CalculateRefillBytesPerPeriod(int64_t rate_bytes_per_sec);
   uint64_t NowMicrosMonotonic(Env* env) {
     return env->NowNanos() / std::milli::den;
@@ -94,6 +116,21 @@ class GenericRateLimiter : public RateLimiter {
   struct Req;
   Req* leader_;
   std::deque<Req*> queue_[Env::IO_TOTAL];
+
+  // Auto tune the rate between max_bytes_per_sec_ / kAllowedRangeFactor and
+  // max_bytes_per_sec_, the members below are protected by request_mutex_
+  // unless they are atomic.
+  const bool auto_tuned_;
+  std::atomic<int64_t> max_bytes_per_sec_;
+  std::atomic<int64_t> rate_bytes_per_sec_;
+  int64_t num_drains_;
+  int64_t tuned_time_;
+
+  // Foreground reads reported since the last tune
+  std::atomic<uint64_t> fg_read_micros_;
+  std::atomic<uint64_t> fg_read_count_;
+  std::atomic<uint64_t> fg_read_latency_;
+  std::atomic<uint64_t> fg_read_latency_target_;
 };
 
 }  // namespace util
@@ -148,6 +148,78 @@ TEST_F(RateLimiterTest, LimitChangeTest) {
   }
 }
 
+TEST_F(RateLimiterTest, AutoTuneLowDemand) {
+  const int64_t kMaxBytesPerSec = 100 * 1024 * 1024;
+  const int64_t kRefillPeriodUs = 1000;
+  auto* env = Env::Default();
+  std::unique_ptr<RateLimiter> limiter(
+      NewGenericRateLimiter(kMaxBytesPerSec, kRefillPeriodUs, 10, true));
+  ASSERT_EQ(kMaxBytesPerSec, limiter->GetBytesPerSecond());
+
+  // a trickle of requests never drains the rate limiter, it isn't binding
+  // and keeps its rate across the tunes
+  for (int i = 0; i < 3; ++i) {
+    env->SleepForMicroseconds(static_cast<int>(100 * kRefillPeriodUs));
+    limiter->Request(1, Env::IO_LOW, nullptr /* stats */);
+  }
+  ASSERT_EQ(kMaxBytesPerSec, limiter->GetBytesPerSecond());
+
+  // a lowered rate stays where it is while idle instead of dropping to the
+  // lower bound
+  limiter->SetForegroundReadLatencyTarget(100);
+  limiter->ReportForegroundRead(1000);
+  env->SleepForMicroseconds(static_cast<int>(100 * kRefillPeriodUs));
+  limiter->Request(1, Env::IO_LOW, nullptr /* stats */);
+  ASSERT_EQ(kMaxBytesPerSec * 100 / 125, limiter->GetBytesPerSecond());
+  for (int i = 0; i < 3; ++i) {
+    env->SleepForMicroseconds(static_cast<int>(100 * kRefillPeriodUs));
+    limiter->Request(1, Env::IO_LOW, nullptr /* stats */);
+  }
+  ASSERT_EQ(kMaxBytesPerSec * 100 / 125, limiter->GetBytesPerSecond());
+
+  // a new upper bound restarts the tuning from it
+  limiter->SetBytesPerSecond(2 * kMaxBytesPerSec);
+  ASSERT_EQ(2 * kMaxBytesPerSec, limiter->GetBytesPerSecond());
+}
+
+TEST_F(RateLimiterTest, RequestLargerThanBurst) {
+  std::unique_ptr<RateLimiter> limiter(
+      NewGenericRateLimiter(100 * 1024 * 1024, 1000, 10));
+  const int64_t burst = limiter->GetSingleBurstBytes();
+
+  // clamped to a single burst instead of waiting for a refill that can
+  // never cover it
+  limiter->Request(2 * burst, Env::IO_LOW, nullptr /* stats */);
+  limiter->Request(burst + 1, Env::IO_HIGH, nullptr /* stats */);
+  ASSERT_EQ(2 * burst, limiter->GetTotalBytesThrough());
+}
+
+TEST_F(RateLimiterTest, AutoTuneSlowForegroundReads) {
+  const int64_t kMaxBytesPerSec = 100 * 1024 * 1024;
+  const int64_t kRefillPeriodUs = 1000;
+  auto* env = Env::Default();
+  std::unique_ptr<RateLimiter> limiter(
+      NewGenericRateLimiter(kMaxBytesPerSec, kRefillPeriodUs, 10, true));
+  limiter->SetForegroundReadLatencyTarget(100);
+
+  env->SleepForMicroseconds(static_cast<int>(100 * kRefillPeriodUs));
+  limiter->ReportForegroundRead(900);
+  limiter->ReportForegroundRead(1100);
+  limiter->Request(1, Env::IO_HIGH, nullptr /* stats */);
+  ASSERT_EQ(1000, limiter->GetForegroundReadLatency());
+  ASSERT_EQ(kMaxBytesPerSec * 100 / 125, limiter->GetBytesPerSecond());
+
+  // not auto tuned, the foreground reads are ignored
+  std::unique_ptr<RateLimiter> fixed_limiter(
+      NewGenericRateLimiter(kMaxBytesPerSec, kRefillPeriodUs, 10));
+  fixed_limiter->SetForegroundReadLatencyTarget(100);
+  fixed_limiter->ReportForegroundRead(1000);
+  env->SleepForMicroseconds(static_cast<int>(100 * kRefillPeriodUs));
+  fixed_limiter->Request(1, Env::IO_HIGH, nullptr /* stats */);
+  ASSERT_EQ(kMaxBytesPerSec, fixed_limiter->GetBytesPerSecond());
+  ASSERT_EQ(0, fixed_limiter->GetForegroundReadLatency());
+}
+
 }  // namespace util
 }  // namespace xengine
 
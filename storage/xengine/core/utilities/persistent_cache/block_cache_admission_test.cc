@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020, Alibaba Group Holding Limited
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+
+ * http://www.apache.org/licenses/LICENSE-2.0
+
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utilities/persistent_cache/block_cache_tier.h"
+#include "util/testharness.h"
+
+using namespace xengine;
+using namespace common;
+using namespace util;
+
+namespace xengine
+{
+namespace util
+{
+
+static const size_t kSlots = 1 << 12;
+
+// Find a key whose counter is not aged by the first min_slot offers and is
+// not exclude_slot
+static std::string find_key(const BlockCacheAdmission &admission,
+                            const size_t min_slot,
+                            const size_t exclude_slot = kSlots)
+{
+  for (int i = 0; ; i++) {
+    std::string key = "key" + std::to_string(i);
+    const size_t slot = admission.Slot(key);
+    if (slot >= min_slot && slot != exclude_slot) {
+      return key;
+    }
+  }
+}
+
+TEST(BlockCacheAdmissionTest, RejectUntilMinInserts)
+{
+  BlockCacheAdmission admission(3, kSlots);
+  const std::string key = find_key(admission, 16);
+
+  ASSERT_FALSE(admission.Admit(key));
+  ASSERT_FALSE(admission.Admit(key));
+  ASSERT_TRUE(admission.Admit(key));
+  ASSERT_TRUE(admission.Admit(key));
+}
+
+TEST(BlockCacheAdmissionTest, AgeOneRoundPerSlots)
+{
+  BlockCacheAdmission admission(3, kSlots);
+  const std::string hot = find_key(admission, 16);
+  const std::string cold = find_key(admission, 16, admission.Slot(hot));
+
+  ASSERT_FALSE(admission.Admit(hot));
+  ASSERT_FALSE(admission.Admit(hot));
+
+  // a full round of offers halves every counter once, the hot key is back
+  // to a single offer
+  for (size_t i = 2; i < kSlots; i++) {
+    admission.Admit(cold);
+  }
+
+  ASSERT_FALSE(admission.Admit(hot));
+  ASSERT_TRUE(admission.Admit(hot));
+}
+
+TEST(BlockCacheAdmissionTest, SaturateCounter)
+{
+  BlockCacheAdmission admission(UINT8_MAX, kSlots);
+  const std::string key = find_key(admission, 2 * UINT8_MAX);
+
+  for (size_t i = 1; i < UINT8_MAX; i++) {
+    ASSERT_FALSE(admission.Admit(key)) << i;
+  }
+
+  // stays admitted instead of wrapping around
+  for (size_t i = 0; i < UINT8_MAX; i++) {
+    ASSERT_TRUE(admission.Admit(key)) << i;
+  }
+}
+
+} // namespace util
+} // namespace xengine
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+	xengine::util::test::init_logger(__FILE__);
+  return RUN_ALL_TESTS();
+}
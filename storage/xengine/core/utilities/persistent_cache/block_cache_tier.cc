@@ -13,6 +13,7 @@
 
 #include "logger/logger.h"
 #include "port/port.h"
+#include "util/hash.h"
 #include "util/stop_watch.h"
 #include "util/sync_point.h"
 #include "utilities/persistent_cache/block_cache_tier_file.h"
@@ -157,6 +158,8 @@ PersistentCache::StatsType BlockCacheTier::Stats() {
       stats_.bytes_read_.Average());
   Add(&stats, "persistentcache.blockcachetier.insert_dropped",
       stats_.insert_dropped_);
+  Add(&stats, "persistentcache.blockcachetier.insert_rejected",
+      stats_.insert_rejected_);
   Add(&stats, "persistentcache.blockcachetier.cache_hits", stats_.cache_hits_);
   Add(&stats, "persistentcache.blockcachetier.cache_misses",
       stats_.cache_misses_);
@@ -178,8 +181,41 @@ PersistentCache::StatsType BlockCacheTier::Stats() {
   return out;
 }
 
+BlockCacheAdmission::BlockCacheAdmission(const uint32_t min_inserts,
+                                         const size_t slots)
+    : min_inserts_(min_inserts),
+      mask_(slots - 1),
+      counts_(new std::atomic<uint8_t>[slots]()) {
+  assert(slots && !(slots & mask_));
+}
+
+size_t BlockCacheAdmission::Slot(const Slice& key) const {
+  return GetSliceHash(key) & mask_;
+}
+
+bool BlockCacheAdmission::Admit(const Slice& key) {
+  // age one counter per offer, a full round takes as many offers as there
+  // are counters
+  auto& aged = counts_[offers_.fetch_add(1, std::memory_order_relaxed) & mask_];
+  aged.store(aged.load(std::memory_order_relaxed) >> 1,
+             std::memory_order_relaxed);
+
+  auto& count = counts_[Slot(key)];
+  uint8_t n = count.load(std::memory_order_relaxed);
+  if (n < UINT8_MAX) {
+    n = count.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  return n >= min_inserts_;
+}
+
 Status BlockCacheTier::Insert(const Slice& key, const char* data,
                               const size_t size) {
+  if (admission_ && !admission_->Admit(key)) {
+    stats_.insert_rejected_++;
+    return Status::OK();
+  }
+
   // update stats
   stats_.bytes_pipelined_.Add(size);
 
@@ -402,12 +438,14 @@ namespace cache {
 Status NewPersistentCache(Env* const env, const std::string& path,
                           const uint64_t size,
                           const bool optimized_for_nvm,
-                          std::shared_ptr<PersistentCache>* cache) {
+                          std::shared_ptr<PersistentCache>* cache,
+                          const uint32_t admission_min_inserts) {
   if (!cache) {
     return Status::IOError("invalid argument cache");
   }
 
   auto opt = PersistentCacheConfig(env, path, size);
+  opt.admission_min_inserts = admission_min_inserts;
   if (optimized_for_nvm) {
     // the default settings are optimized for SSD
     // NVM devices are better accessed with 4K direct IO and written with
@@ -11,6 +11,7 @@
 #include <unistd.h>
 #endif  // ! OS_WIN
 
+#include <atomic>
 #include <list>
 #include <memory>
 #include <set>
@@ -40,6 +41,37 @@
 namespace xengine {
 namespace util {
 
+//
+// Admission control of the block cache tier, see
+// PersistentCacheConfig::admission_min_inserts
+//
+// Counts the offers of each key hash in 8-bit counters. Every offer also
+// halves one counter, in turn, so each counter is aged once per `slots`
+// offers. The blocks that were hot a while ago don't stay admitted forever,
+// and the insert path never walks the whole array.
+//
+class BlockCacheAdmission {
+ public:
+  // Default number of counters
+  static const size_t kDefaultSlots = 1 << 20;
+
+  // slots must be a power of 2
+  BlockCacheAdmission(const uint32_t min_inserts,
+                      const size_t slots = kDefaultSlots);
+
+  // Count an offer of key, return whether it is admitted
+  bool Admit(const common::Slice& key);
+
+  // Counter of key
+  size_t Slot(const common::Slice& key) const;
+
+ private:
+  const uint32_t min_inserts_;
+  const size_t mask_;
+  std::unique_ptr<std::atomic<uint8_t>[]> counts_;  // Offers per key hash
+  std::atomic<uint64_t> offers_{0};                 // Offers since start
+};
+
 //
 // Block cache tier implementation
 //
@@ -52,6 +84,9 @@ class BlockCacheTier : public PersistentCacheTier {
         writer_(this, opt_.writer_qdepth, opt_.writer_dispatch_size) {
     __XENGINE_LOG(INFO, "Initializing allocator. size=%d B count=%d",
                   opt_.write_buffer_size, opt_.write_buffer_count());
+    if (opt_.admission_min_inserts > 1) {
+      admission_.reset(new BlockCacheAdmission(opt_.admission_min_inserts));
+    }
   }
 
   virtual ~BlockCacheTier() {
@@ -132,6 +167,7 @@ class BlockCacheTier : public PersistentCacheTier {
     uint64_t cache_misses_ = 0;
     uint64_t cache_errors_ = 0;
     uint64_t insert_dropped_ = 0;
+    uint64_t insert_rejected_ = 0;
 
     double CacheHitPct() const {
       const auto lookups = cache_hits_ + cache_misses_;
@@ -155,6 +191,8 @@ class BlockCacheTier : public PersistentCacheTier {
   BlockCacheTierMetadata metadata_;             // Cache meta data manager
   std::atomic<uint64_t> size_{0};               // Size of the cache
   Statistics stats_;                            // Statistics
+  // Admission control, null if all are admitted
+  std::unique_ptr<BlockCacheAdmission> admission_;
 };
 
 }  //  namespace util
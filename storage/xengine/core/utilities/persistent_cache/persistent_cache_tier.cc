@@ -60,6 +60,9 @@ std::string PersistentCacheConfig::ToString() const {
   ret.append(buffer);
   snprintf(buffer, kBufferSize, "    is_compressed: %d\n", is_compressed);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    admission_min_inserts: %" PRIu32 "\n",
+           admission_min_inserts);
+  ret.append(buffer);
 
   return ret;
 }
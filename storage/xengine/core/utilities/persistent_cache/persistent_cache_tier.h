@@ -121,6 +121,11 @@ struct PersistentCacheConfig {
       return common::Status::InvalidArgument("invalid writer settings");
     }
 
+    // (3) check admission settings, the counters are 8 bits
+    if (!admission_min_inserts || admission_min_inserts > UINT8_MAX) {
+      return common::Status::InvalidArgument("invalid admission settings");
+    }
+
     return common::Status::OK();
   }
 
@@ -213,6 +218,16 @@ struct PersistentCacheConfig {
   // uncompressed mode
   bool is_compressed = true;
 
+  // admission-min-inserts
+  //
+  // A block is admitted to the cache only once it has been offered this many
+  // times, i.e. it missed the block cache that many times recently. One-off
+  // reads, like a full scan, then don't churn the blocks that are read again
+  // and again. The counters are kept per key hash and halved periodically.
+  //
+  // default: 1 (admit all)
+  uint32_t admission_min_inserts = 1;
+
   std::string ToString() const;
 };
 
@@ -211,16 +211,8 @@ std::vector<Status> TransactionBaseImpl::MultiGet(
     const ReadOptions& read_options,
     const std::vector<ColumnFamilyHandle*>& column_family,
     const std::vector<Slice>& keys, std::vector<std::string>* values) {
-  size_t num_keys = keys.size();
-  values->resize(num_keys);
-
-  std::vector<Status> stat_list(num_keys);
-  for (size_t i = 0; i < num_keys; ++i) {
-    std::string* value = values ? &(*values)[i] : nullptr;
-    stat_list[i] = Get(read_options, column_family[i], keys[i], value);
-  }
-
-  return stat_list;
+  return write_batch_.MultiGetFromBatchAndDB(db_, read_options, column_family,
+                                             keys, values);
 }
 
 std::vector<Status> TransactionBaseImpl::MultiGetForUpdate(
@@ -241,14 +233,8 @@ std::vector<Status> TransactionBaseImpl::MultiGetForUpdate(
     }
   }
 
-  // TODO(agiardullo): optimize multiget?
-  std::vector<Status> stat_list(num_keys);
-  for (size_t i = 0; i < num_keys; ++i) {
-    std::string* value = values ? &(*values)[i] : nullptr;
-    stat_list[i] = Get(read_options, column_family[i], keys[i], value);
-  }
-
-  return stat_list;
+  return write_batch_.MultiGetFromBatchAndDB(db_, read_options, column_family,
+                                             keys, values);
 }
 
 Iterator* TransactionBaseImpl::GetIterator(const ReadOptions& read_options) {
@@ -581,6 +581,65 @@ Status WriteBatchWithIndex::GetFromBatchAndDB(DB* db,
   return s;
 }
 
+std::vector<Status> WriteBatchWithIndex::MultiGetFromBatchAndDB(
+    DB* db, const ReadOptions& read_options,
+    const std::vector<ColumnFamilyHandle*>& column_family,
+    const std::vector<Slice>& keys, std::vector<std::string>* values) {
+  QUERY_TRACE_SCOPE(xengine::monitor::TracePoint::DB_WRITE_BATCH_GET);
+  const ImmutableDBOptions& immuable_db_options =
+      reinterpret_cast<DBImpl*>(db)->immutable_db_options();
+  const size_t num_keys = keys.size();
+  std::vector<Status> stat_list(num_keys);
+  values->resize(num_keys);
+
+  // positions of the keys to read from the DB
+  std::vector<size_t> db_pos;
+  std::vector<ColumnFamilyHandle*> db_column_family;
+  std::vector<Slice> db_keys;
+  for (size_t i = 0; i < num_keys; ++i) {
+    db::MergeContext merge_context;
+    WriteBatchWithIndexInternal::Result result =
+        WriteBatchWithIndexInternal::GetFromBatch(
+            immuable_db_options, this, column_family[i], keys[i],
+            &merge_context, &rep->comparator, &(*values)[i],
+            rep->overwrite_key, &stat_list[i]);
+
+    switch (result) {
+      case WriteBatchWithIndexInternal::Result::kFound:
+      case WriteBatchWithIndexInternal::Result::kError:
+        // use returned status
+        break;
+      case WriteBatchWithIndexInternal::Result::kDeleted:
+        stat_list[i] = Status::NotFound();
+        break;
+      case WriteBatchWithIndexInternal::Result::kNotFound:
+        db_pos.push_back(i);
+        db_column_family.push_back(column_family[i]);
+        db_keys.push_back(keys[i]);
+        break;
+      case WriteBatchWithIndexInternal::Result::kMergeInProgress:
+        // merges are rare, resolve them one by one
+        stat_list[i] = GetFromBatchAndDB(db, read_options, column_family[i],
+                                         keys[i], &(*values)[i]);
+        break;
+      default:
+        assert(false);
+    }
+  }
+
+  if (!db_keys.empty()) {
+    std::vector<std::string> db_values;
+    std::vector<Status> db_stat_list =
+        db->MultiGet(read_options, db_column_family, db_keys, &db_values);
+    for (size_t i = 0; i < db_pos.size(); ++i) {
+      stat_list[db_pos[i]] = db_stat_list[i];
+      (*values)[db_pos[i]].swap(db_values[i]);
+    }
+  }
+
+  return stat_list;
+}
+
 void WriteBatchWithIndex::SetSavePoint() { rep->write_batch.SetSavePoint(); }
 
 Status WriteBatchWithIndex::RollbackToSavePoint() {
@@ -1121,6 +1121,63 @@ TEST_F(WriteBatchWithIndexTest, TestGetFromBatchAndDB) {
   DestroyDB(dbname, options);
 }
 
+TEST_F(WriteBatchWithIndexTest, TestMultiGetFromBatchAndDB) {
+  DB* db;
+  Options options;
+  options.create_if_missing = true;
+  std::string dbname = test::TmpDir() + "/write_batch_with_index_test";
+
+  DestroyDB(dbname, options);
+  Status s = DB::Open(options, dbname, &db);
+  ASSERT_OK(s);
+
+  WriteBatchWithIndex batch;
+  ReadOptions read_options;
+  WriteOptions write_options;
+
+  ASSERT_OK(db->Put(write_options, "a", "a"));
+  ASSERT_OK(db->Put(write_options, "b", "b"));
+  ASSERT_OK(db->Put(write_options, "c", "c"));
+
+  batch.Put("a", "batch.a");
+  batch.Delete("b");
+  batch.Put("d", "batch.d");
+
+  const std::vector<Slice> keys = {"c", "a", "x", "b", "d", "c"};
+  const std::vector<ColumnFamilyHandle*> column_families(
+      keys.size(), db->DefaultColumnFamily());
+  std::vector<std::string> values;
+  std::vector<Status> stat_list = batch.MultiGetFromBatchAndDB(
+      db, read_options, column_families, keys, &values);
+  ASSERT_EQ(keys.size(), stat_list.size());
+  ASSERT_EQ(keys.size(), values.size());
+
+  // each key gives what GetFromBatchAndDB() gives
+  for (size_t i = 0; i < keys.size(); i++) {
+    std::string value;
+    s = batch.GetFromBatchAndDB(db, read_options, keys[i], &value);
+    ASSERT_EQ(s.code(), stat_list[i].code());
+    if (s.ok()) {
+      ASSERT_EQ(value, values[i]);
+    }
+  }
+  ASSERT_EQ("c", values[0]);
+  ASSERT_EQ("batch.a", values[1]);
+  ASSERT_TRUE(stat_list[2].IsNotFound());
+  ASSERT_TRUE(stat_list[3].IsNotFound());
+  ASSERT_EQ("batch.d", values[4]);
+  ASSERT_EQ("c", values[5]);
+
+  stat_list = batch.MultiGetFromBatchAndDB(
+      db, read_options, std::vector<ColumnFamilyHandle*>(), std::vector<Slice>(),
+      &values);
+  ASSERT_TRUE(stat_list.empty());
+  ASSERT_TRUE(values.empty());
+
+  delete db;
+  DestroyDB(dbname, options);
+}
+
 TEST_F(WriteBatchWithIndexTest, TestGetFromBatchAndDBMerge) {
   DB* db;
   Options options;
@@ -627,6 +627,22 @@ static void xengine_set_total_max_shrink_extent_count(
     THD *thd, struct SYS_VAR *const var, void *const var_ptr,
     const void *const save);
 
+static void xengine_set_shrink_round_extent_count(
+    THD *thd, struct SYS_VAR *const var, void *const var_ptr,
+    const void *const save);
+
+static void xengine_set_shrink_rate_limit(
+    THD *thd, struct SYS_VAR *const var, void *const var_ptr,
+    const void *const save);
+
+static void xengine_set_cache_prewarm_dump_period(
+    THD *thd, struct SYS_VAR *const var, void *const var_ptr,
+    const void *const save);
+
+static void xengine_set_cache_prewarm_rate_limit(
+    THD *thd, struct SYS_VAR *const var, void *const var_ptr,
+    const void *const save);
+
 static void xengine_set_auto_shrink_schedule_interval(THD *thd,
                                                       struct SYS_VAR *const var,
                                                       void *const var_ptr,
@@ -639,6 +655,9 @@ static void xengine_set_rate_limiter_bytes_per_sec(THD *thd,
                                                    struct SYS_VAR *const var,
                                                    void *const var_ptr,
                                                    const void *const save);
+static void xengine_set_rate_limiter_read_latency_target(
+    THD *thd, struct SYS_VAR *const var, void *const var_ptr,
+    const void *const save);
 
 
 #if 0 // DEL-SYSVAR
@@ -672,11 +691,14 @@ static long long xengine_block_cache_size;
 static long long xengine_row_cache_size;
 /* Use unsigned long long instead of uint64_t because of MySQL compatibility */
 static unsigned long xengine_rate_limiter_bytes_per_sec;
+static bool xengine_rate_limiter_auto_tuned = false;
+static unsigned long xengine_rate_limiter_read_latency_target = 0;
 //static unsigned long long xengine_delayed_write_rate;
-//static unsigned long xengine_persistent_cache_size;
+static unsigned long xengine_persistent_cache_size;
+static uint32_t xengine_persistent_cache_admission;
 static uint32_t xengine_flush_log_at_trx_commit;
 static char *xengine_wal_dir;
-//static char *xengine_persistent_cache_path;
+static char *xengine_persistent_cache_path;
 //static uint64_t xengine_index_type;
 static uint32_t xengine_debug_optimizer_n_rows = 0;
 static bool xengine_force_compute_memtable_stats = true;
@@ -1156,7 +1178,7 @@ static MYSQL_SYSVAR_STR(wal_dir, xengine_wal_dir,
                         PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
                         "DBOptions::wal_dir for XEngine", nullptr, nullptr,
                         xengine_db_options.wal_dir.c_str());
-#if 0 // DEL-SYSVAR
+
 static MYSQL_SYSVAR_STR(
     persistent_cache_path, xengine_persistent_cache_path,
     PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
@@ -1167,9 +1189,17 @@ static MYSQL_SYSVAR_ULONG(
     persistent_cache_size, xengine_persistent_cache_size,
     PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
     "Size of cache for BlockBasedTableOptions::persistent_cache for XEngine",
-    nullptr, nullptr, xengine_persistent_cache_size,
+    nullptr, nullptr, 0,
     /* min */ 0L, /* max */ ULONG_MAX, 0);
 
+static MYSQL_SYSVAR_UINT(
+    persistent_cache_admission, xengine_persistent_cache_admission,
+    PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+    "Number of block cache misses after which a block is written to the"
+    " persistent cache for XEngine, 1 writes all blocks read",
+    nullptr, nullptr, 2, /* min */ 1, /* max */ 255, 0);
+
+#if 0 // DEL-SYSVAR
 static MYSQL_SYSVAR_ULONG(
     delete_obsolete_files_period_micros,
     xengine_db_options.delete_obsolete_files_period_micros,
@@ -1249,6 +1279,54 @@ static MYSQL_SYSVAR_ULONG(total_max_shrink_extent_count,
                           nullptr, xengine_set_total_max_shrink_extent_count,
                           xengine_db_options.total_max_shrink_extent_count,
                           /* min */ 0, /* max */ ULONG_MAX, 0);
+
+static MYSQL_SYSVAR_ULONG(shrink_round_extent_count,
+                          xengine_db_options.shrink_round_extent_count,
+                          PLUGIN_VAR_RQCMDARG,
+                          "DBOptions::shrink_round_extent_count for XEngine, "
+                          "max extents moved by a shrink job before it releases "
+                          "the subtables, 0 means the whole job in one round",
+                          nullptr, xengine_set_shrink_round_extent_count,
+                          xengine_db_options.shrink_round_extent_count,
+                          /* min */ 0, /* max */ ULONG_MAX, 0);
+
+static MYSQL_SYSVAR_ULONG(shrink_rate_limit,
+                          xengine_db_options.shrink_rate_limit,
+                          PLUGIN_VAR_RQCMDARG,
+                          "DBOptions::shrink_rate_limit for XEngine, bytes per "
+                          "second moved by a shrink job, 0 means unlimited",
+                          nullptr, xengine_set_shrink_rate_limit,
+                          xengine_db_options.shrink_rate_limit,
+                          /* min */ 0, /* max */ ULONG_MAX, 0);
+
+static MYSQL_SYSVAR_ULONG(cache_prewarm_max_entries,
+                          xengine_db_options.cache_prewarm_max_entries,
+                          PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+                          "DBOptions::cache_prewarm_max_entries for XEngine, "
+                          "hot data blocks and rows persisted to warm the "
+                          "caches up after restart, 0 disables it",
+                          nullptr, nullptr,
+                          xengine_db_options.cache_prewarm_max_entries,
+                          /* min */ 0, /* max */ ULONG_MAX, 0);
+
+static MYSQL_SYSVAR_ULONG(cache_prewarm_dump_period,
+                          xengine_db_options.cache_prewarm_dump_period_sec,
+                          PLUGIN_VAR_RQCMDARG,
+                          "DBOptions::cache_prewarm_dump_period_sec for XEngine, "
+                          "seconds between two dumps of the hot blocks and rows, "
+                          "0 only dumps at shutdown",
+                          nullptr, xengine_set_cache_prewarm_dump_period,
+                          xengine_db_options.cache_prewarm_dump_period_sec,
+                          /* min */ 0, /* max */ ULONG_MAX, 0);
+
+static MYSQL_SYSVAR_ULONG(cache_prewarm_rate_limit,
+                          xengine_db_options.cache_prewarm_rate_limit,
+                          PLUGIN_VAR_RQCMDARG,
+                          "DBOptions::cache_prewarm_rate_limit for XEngine, bytes "
+                          "per second read by the cache prewarm, 0 means unlimited",
+                          nullptr, xengine_set_cache_prewarm_rate_limit,
+                          xengine_db_options.cache_prewarm_rate_limit,
+                          /* min */ 0, /* max */ ULONG_MAX, 0);
 static MYSQL_SYSVAR_ULONG(auto_shrink_schedule_interval,
                           xengine_db_options.auto_shrink_schedule_interval,
                           PLUGIN_VAR_RQCMDARG,
@@ -1271,6 +1349,25 @@ static MYSQL_SYSVAR_ULONG(rate_limiter_bytes_per_sec,
                           /* default */ 0L,
                           /* min */ 0L, /* max */ MAX_RATE_LIMITER_BYTES_PER_SEC, 0);
 
+static MYSQL_SYSVAR_BOOL(rate_limiter_auto_tuned,
+                         xengine_rate_limiter_auto_tuned,
+                         PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+                         "Tune the rate of the rate limiter between 1/20 of "
+                         "rate_limiter_bytes_per_sec and rate_limiter_bytes_per_sec "
+                         "according to the background IO demand and the latency "
+                         "of the foreground reads",
+                         nullptr, nullptr, false);
+
+static MYSQL_SYSVAR_ULONG(rate_limiter_read_latency_target,
+                          xengine_rate_limiter_read_latency_target,
+                          PLUGIN_VAR_RQCMDARG,
+                          "Average foreground read latency in microseconds above "
+                          "which the auto tuned rate limiter backs off the "
+                          "background IO, 0 means not considered",
+                          nullptr, xengine_set_rate_limiter_read_latency_target,
+                          /* default */ 0L,
+                          /* min */ 0L, /* max */ ULONG_MAX, 0);
+
 static MYSQL_SYSVAR_INT(max_background_flushes,
                         xengine_db_options.max_background_flushes,
                         PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
@@ -2236,9 +2333,10 @@ static struct SYS_VAR *xengine_system_variables[] = {
     MYSQL_SYSVAR(max_total_wal_size),
     // MYSQL_SYSVAR(use_fsync),
     MYSQL_SYSVAR(wal_dir),
-#if 0 // DEL-SYSVAR
     MYSQL_SYSVAR(persistent_cache_path),
     MYSQL_SYSVAR(persistent_cache_size),
+    MYSQL_SYSVAR(persistent_cache_admission),
+#if 0 // DEL-SYSVAR
     MYSQL_SYSVAR(delete_obsolete_files_period_micros),
 #endif
     MYSQL_SYSVAR(base_background_compactions),
@@ -2249,6 +2347,11 @@ static struct SYS_VAR *xengine_system_variables[] = {
     MYSQL_SYSVAR(shrink_allocate_interval),
     MYSQL_SYSVAR(max_shrink_extent_count),
     MYSQL_SYSVAR(total_max_shrink_extent_count),
+    MYSQL_SYSVAR(shrink_round_extent_count),
+    MYSQL_SYSVAR(shrink_rate_limit),
+    MYSQL_SYSVAR(cache_prewarm_max_entries),
+    MYSQL_SYSVAR(cache_prewarm_dump_period),
+    MYSQL_SYSVAR(cache_prewarm_rate_limit),
     MYSQL_SYSVAR(auto_shrink_schedule_interval),
 #if 0 // DEL-SYSVAR
     MYSQL_SYSVAR(max_log_file_size),
@@ -2335,6 +2438,8 @@ static struct SYS_VAR *xengine_system_variables[] = {
     MYSQL_SYSVAR(flush_delete_record_trigger),
     MYSQL_SYSVAR(level2_usage_percent), MYSQL_SYSVAR(scan_add_blocks_limit),
     MYSQL_SYSVAR(bottommost_level), MYSQL_SYSVAR(rate_limiter_bytes_per_sec),
+    MYSQL_SYSVAR(rate_limiter_auto_tuned),
+    MYSQL_SYSVAR(rate_limiter_read_latency_target),
     MYSQL_SYSVAR(compaction_task_extents_limit),
     MYSQL_SYSVAR(idle_tasks_schedule_time),
 
@@ -3179,6 +3284,28 @@ public:
     }
   }
 
+  std::vector<xengine::common::Status> multi_get_for_update(
+      xengine::db::ColumnFamilyHandle *const column_family,
+      const std::vector<xengine::common::Slice> &keys,
+      std::vector<std::string> *const values, bool exclusive) override
+  {
+    m_lock_count += keys.size();
+    if (m_lock_count > m_max_row_locks) {
+      return std::vector<xengine::common::Status>(
+          keys.size(), xengine::common::Status(xengine::common::Status::kLockLimit));
+    }
+
+    for (const auto &key : keys) {
+      const xengine::common::Status s =
+          m_xengine_tx->TryLock(column_family, key, true /* read_only */, exclusive);
+      if (!s.ok()) {
+        return std::vector<xengine::common::Status>(keys.size(), s);
+      }
+    }
+    const std::vector<xengine::db::ColumnFamilyHandle *> column_families(keys.size(), column_family);
+    return m_xengine_tx->MultiGet(m_read_opts, column_families, keys, values);
+  }
+
   xengine::common::Status lock_unique_key(xengine::db::ColumnFamilyHandle *const column_family,
                                           const xengine::common::Slice &key,
                                           const bool skip_bloom_filter,
@@ -3501,6 +3628,15 @@ public:
     return get(column_family, key, value);
   }
 
+  std::vector<xengine::common::Status> multi_get_for_update(
+      xengine::db::ColumnFamilyHandle *const column_family,
+      const std::vector<xengine::common::Slice> &keys,
+      std::vector<std::string> *const values, bool exclusive) override
+  {
+    const std::vector<xengine::db::ColumnFamilyHandle *> column_families(keys.size(), column_family);
+    return m_batch->MultiGetFromBatchAndDB(xdb, m_read_opts, column_families, keys, values);
+  }
+
   xengine::common::Status lock_unique_key(xengine::db::ColumnFamilyHandle *const column_family,
                                           const xengine::common::Slice &key,
                                           const bool skip_bloom_filter,
@@ -4736,7 +4872,12 @@ static int xengine_init_func(void *const p) {
   }
   if (xengine_rate_limiter_bytes_per_sec != 0) {
     xengine_rate_limiter.reset(
-        xengine::util::NewGenericRateLimiter(xengine_rate_limiter_bytes_per_sec));
+        xengine::util::NewGenericRateLimiter(xengine_rate_limiter_bytes_per_sec,
+                                             100 * 1000 /* refill_period_us */,
+                                             10 /* fairness */,
+                                             xengine_rate_limiter_auto_tuned));
+    xengine_rate_limiter->SetForegroundReadLatencyTarget(
+        xengine_rate_limiter_read_latency_target);
     xengine_db_options.rate_limiter = xengine_rate_limiter;
   }
 
@@ -4855,17 +4996,23 @@ static int xengine_init_func(void *const p) {
     XDB_MUTEX_UNLOCK_CHECK(xdb_sysvars_mutex);
   }
 
-#if 0 // DEL-SYSVAR
   if (xengine_persistent_cache_size > 0) {
     std::shared_ptr<xengine::cache::PersistentCache> pcache;
-    xengine::cache::NewPersistentCache(
+    xengine::common::Status s = xengine::cache::NewPersistentCache(
         xengine::util::Env::Default(), std::string(xengine_persistent_cache_path),
-        xengine_persistent_cache_size, true, &pcache);
+        xengine_persistent_cache_size, true, &pcache,
+        xengine_persistent_cache_admission);
+    if (!s.ok()) {
+      sql_print_error("XEngine: Failed to open persistent cache at %s: %s",
+                      xengine_persistent_cache_path, s.ToString().c_str());
+      DBUG_RETURN(1);
+    }
     xengine_tbl_options.persistent_cache = pcache;
   } else if (strlen(xengine_persistent_cache_path)) {
     sql_print_error("XEngine: Must specify xengine_persistent_cache_size");
     DBUG_RETURN(1);
   }
+#if 0 // DEL-SYSVAR
   if (nullptr != xengine_filter_policy &&
       !xengine::common::GetTableFilterPolicy(
           std::string(xengine_filter_policy),
@@ -6522,6 +6669,9 @@ void ha_xengine::set_skip_unique_check_tables(const char *const whitelist) {
   m_skip_unique_check = regex_handler.matches(m_tbl_def->base_tablename());
 }
 
+static void xdb_sync_memtable_options(const TABLE *const table_arg,
+                                      const Xdb_tbl_def *const tbl_def_arg);
+
 int ha_xengine::open(const char *const name, int mode, uint test_if_locked,
                      const dd::Table *table_def) {
   //TODO by beilou this function should be implementd like mysql 8.0
@@ -6637,6 +6787,8 @@ int ha_xengine::open(const char *const name, int mode, uint test_if_locked,
     DBUG_RETURN(HA_ERR_INTERNAL_ERROR);
   }
 
+  xdb_sync_memtable_options(table, m_tbl_def.get());
+
   /* Index block size in XEngine: used by MySQL in query optimization */
   stats.block_size = xengine_tbl_options.block_size;
 
@@ -6856,6 +7008,155 @@ int ha_xengine::create_key_defs(
   DBUG_RETURN(HA_EXIT_SUCCESS);
 }
 
+/* Name of the memtable factory selected by COMMENT='memtable=hash' */
+static const char *const XDB_HASH_MEMTABLE_FACTORY =
+    "HashIndexSkipListRepFactory";
+
+/* Share of the write buffer given to the memtable bloom of hash memtables */
+static const double XDB_HASH_MEMTABLE_BLOOM_RATIO = 0.02;
+
+/*
+  Every hash memtable allocates its bucket array (8 bytes per bucket) from
+  its arena up front. Without an explicit count, one bucket is given per
+  XDB_HASH_MEMTABLE_BYTES_PER_BUCKET bytes of write buffer, which keeps the
+  array under 1% of the memtable.
+*/
+static const size_t XDB_HASH_MEMTABLE_BYTES_PER_BUCKET = 1024;
+static const size_t XDB_HASH_MEMTABLE_MIN_BUCKETS = 1024;
+static const size_t XDB_HASH_MEMTABLE_MAX_BUCKETS = 1024 * 1024;
+
+static size_t xdb_hash_memtable_buckets(const size_t write_buffer_size) {
+  return std::min(std::max(write_buffer_size /
+                               XDB_HASH_MEMTABLE_BYTES_PER_BUCKET,
+                           XDB_HASH_MEMTABLE_MIN_BUCKETS),
+                  XDB_HASH_MEMTABLE_MAX_BUCKETS);
+}
+
+/*
+  Parse the memtable option of the table comment, which selects the memtable
+  of the primary key subtable:
+
+    COMMENT='memtable=hash'       hash indexed skip list, for point lookups,
+                                  buckets sized from the write buffer
+    COMMENT='memtable=hash:<n>'   the same with <n> hash buckets, each costs
+                                  8 bytes of every memtable
+
+  @param in
+    write_buffer_size   memtable size of the subtable
+
+  @param out
+    memtable      memtable factory string understood by XEngine
+
+  @return
+    true   - hash memtable is selected
+    false  - default memtable
+*/
+static bool xdb_get_memtable_option(const TABLE *const table_arg,
+                                    const size_t write_buffer_size,
+                                    std::string *const memtable) {
+  static const char *const key = "memtable=";
+  const std::string comment(table_arg->s->comment.str,
+                            table_arg->s->comment.length);
+
+  size_t pos = comment.find(key);
+  while (pos != std::string::npos && pos > 0 &&
+         !my_isspace(system_charset_info, comment[pos - 1]) &&
+         comment[pos - 1] != ',' && comment[pos - 1] != ';') {
+    pos = comment.find(key, pos + 1);
+  }
+  if (pos == std::string::npos) {
+    return false;
+  }
+
+  pos += strlen(key);
+  size_t end = pos;
+  while (end < comment.size() &&
+         !my_isspace(system_charset_info, comment[end]) &&
+         comment[end] != ',' && comment[end] != ';') {
+    end++;
+  }
+  const std::string value = comment.substr(pos, end - pos);
+
+  if (value == "hash") {
+    *memtable = "hash_index:" +
+                std::to_string(xdb_hash_memtable_buckets(write_buffer_size));
+    return true;
+  }
+  if (value.compare(0, 5, "hash:") == 0 && value.size() > 5 &&
+      value.find_first_not_of("0123456789", 5) == std::string::npos) {
+    *memtable = "hash_index" + value.substr(4);
+    return true;
+  }
+  return false;
+}
+
+/*
+  Primary key subtable options for a newly created table, with the memtable
+  chosen by the table comment.
+*/
+static xengine::common::ColumnFamilyOptions
+xdb_get_pk_cf_options(const TABLE *const table_arg) {
+  xengine::common::ColumnFamilyOptions cf_options = xengine_default_cf_options;
+  std::string memtable;
+  if (xdb_get_memtable_option(table_arg, cf_options.write_buffer_size,
+                              &memtable) &&
+      xengine::common::GetMemTableFactory(memtable,
+                                          &cf_options.memtable_factory)) {
+    cf_options.memtable_prefix_bloom_size_ratio =
+        std::max(cf_options.memtable_prefix_bloom_size_ratio,
+                 XDB_HASH_MEMTABLE_BLOOM_RATIO);
+  }
+  return cf_options;
+}
+
+/*
+  Subtables are recovered with the default options, so the memtable of the
+  primary key subtable is checked against the table comment whenever the
+  table is opened, and switched if needed. The switch takes effect from the
+  next memtable of the subtable.
+*/
+static void xdb_sync_memtable_options(const TABLE *const table_arg,
+                                      const Xdb_tbl_def *const tbl_def_arg) {
+  const Xdb_key_def &pk_def =
+      *tbl_def_arg->m_key_descr_arr[ha_xengine::pk_index(table_arg,
+                                                         tbl_def_arg)];
+  xengine::db::ColumnFamilyHandle *const cf = pk_def.get_cf();
+  if (cf == nullptr) {
+    return;
+  }
+
+  std::string memtable;
+  const xengine::common::Options opts = xdb->GetOptions(cf);
+  const bool use_hash =
+      xdb_get_memtable_option(table_arg, opts.write_buffer_size, &memtable);
+  const bool is_hash =
+      opts.memtable_factory != nullptr &&
+      strcmp(opts.memtable_factory->Name(), XDB_HASH_MEMTABLE_FACTORY) == 0;
+  if (use_hash == is_hash) {
+    return;
+  }
+
+  double bloom_ratio =
+      xengine_default_cf_options.memtable_prefix_bloom_size_ratio;
+  if (use_hash) {
+    bloom_ratio = std::max(bloom_ratio, XDB_HASH_MEMTABLE_BLOOM_RATIO);
+  } else if (nullptr != xengine_cf_memtable_options &&
+             '\0' != xengine_cf_memtable_options[0]) {
+    memtable = xengine_cf_memtable_options;
+  } else {
+    memtable = "skip_list";
+  }
+
+  const xengine::common::Status s = xdb->SetOptions(
+      cf, {{"memtable", memtable},
+           {"memtable_prefix_bloom_size_ratio", std::to_string(bloom_ratio)}});
+  if (!s.ok()) {
+    sql_print_warning("XEngine: failed to switch memtable of %s to %s, %s",
+                      tbl_def_arg->full_tablename().c_str(), memtable.c_str(),
+                      s.ToString().c_str());
+  }
+}
+
 /*
   Checks index parameters and creates column families needed for storing data
   in xengine if necessary.
@@ -6980,8 +7281,10 @@ int ha_xengine::create_cfs(
     }
     cf_handle = cf_manager.get_or_create_cf(
         xdb, batch, thd_thread_id(thd), (*index_ids)[i], comment, tbl_def_arg->full_tablename(),
-        key_name, &is_auto_cf_flag, xengine_default_cf_options, create_table_space,
-        table_space_id);
+        key_name, &is_auto_cf_flag,
+        is_pk(i, table_arg, tbl_def_arg) ? xdb_get_pk_cf_options(table_arg)
+                                         : xengine_default_cf_options,
+        create_table_space, table_space_id);
     if (create_table_space) {
       tbl_def_arg->space_id = table_space_id;
     }
@@ -9617,6 +9920,233 @@ int ha_xengine::write_row(uchar *const buf) {
   DBUG_RETURN(rv);
 }
 
+/*
+  The batch only needs the primary key to be locked and checked for
+  duplicates, other tables go through write_row() one row at a time.
+*/
+bool ha_xengine::can_write_rows_batch() const {
+  if (table->next_number_field != nullptr || has_hidden_pk(table) ||
+      xengine_enable_bulk_load_api || skip_unique_check() ||
+      !m_tbl_def->m_added_key.empty() || !m_tbl_def->m_inplace_new_keys.empty()) {
+    return false;
+  }
+  for (uint key_id = 0; key_id < table->s->keys; key_id++) {
+    if (key_id != table->s->primary_key &&
+        (table->key_info[key_id].flags & HA_NOSAME)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+  Encode the rows once for the batch: for each row, the packed key and the
+  value of every index of kds, the primary key first, are appended to buf,
+  and ends gets the end offset of each of them. Returns the count of leading
+  rows encoded, a row too large to be put stops the batch.
+*/
+uint ha_xengine::pack_rows_batch(uchar **records, uint count,
+                                 const std::vector<const Xdb_key_def *> &kds,
+                                 std::string *const buf,
+                                 std::vector<size_t> *const ends) {
+  DBUG_ASSERT(kds[0] == m_pk_descr.get());
+  const bool store_row_debug_checksums = should_store_row_debug_checksums();
+  ends->reserve(count * 2 * kds.size());
+
+  uint i = 0;
+  for (; i < count; i++) {
+    if (records[i] != table->record[0]) {
+      memcpy(table->record[0], records[i], table->s->reclength);
+    }
+    const size_t row_begin = buf->size();
+
+    const uint pk_size = m_pk_descr->pack_record(
+        table, m_pack_buffer, table->record[0], m_pk_packed_tuple,
+        &m_pk_unpack_info, false);
+    assert(pk_size <= m_max_packed_sk_len);
+    const xengine::common::Slice pk_slice(
+        reinterpret_cast<const char *>(m_pk_packed_tuple), pk_size);
+    xengine::common::Slice value_slice;
+    if (convert_record_to_storage_format(pk_slice, &m_pk_unpack_info,
+                                         &value_slice) ||
+        pk_slice.size() + value_slice.size() > XDB_MAX_ROW_SIZE) {
+      // write_row() reports it
+      buf->resize(row_begin);
+      break;
+    }
+    buf->append(pk_slice.data(), pk_slice.size());
+    ends->push_back(buf->size());
+    buf->append(value_slice.data(), value_slice.size());
+    ends->push_back(buf->size());
+
+    for (size_t k = 1; k < kds.size(); k++) {
+      const uint sk_size = kds[k]->pack_record(
+          table, m_pack_buffer, table->record[0], m_sk_packed_tuple,
+          &m_sk_tails, store_row_debug_checksums, 0 /* hidden_pk_id */);
+      assert(sk_size <= m_max_packed_sk_len);
+      buf->append(reinterpret_cast<const char *>(m_sk_packed_tuple), sk_size);
+      ends->push_back(buf->size());
+      buf->append(reinterpret_cast<const char *>(m_sk_tails.ptr()),
+                  m_sk_tails.get_current_pos());
+      ends->push_back(buf->size());
+    }
+  }
+
+  assert(ends->size() == i * 2 * kds.size());
+  return i;
+}
+
+/*
+  Lock the primary keys of the encoded rows in key order and check that
+  none of them exists, with one read of all of them. *checked is the count
+  of leading rows found unique, it stops at the first duplicate whether it
+  is in the table or among the rows.
+*/
+int ha_xengine::check_and_lock_unique_pks(Xdb_transaction *const tx,
+                                          uint count, uint entries,
+                                          const std::string &buf,
+                                          const std::vector<size_t> &ends,
+                                          uint *const checked) {
+  std::vector<xengine::common::Slice> pk_keys(count);
+  std::vector<uint> order(count);
+  for (uint i = 0; i < count; i++) {
+    const size_t begin = i == 0 ? 0 : ends[i * entries - 1];
+    pk_keys[i] = xengine::common::Slice(buf.data() + begin,
+                                        ends[i * entries] - begin);
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&pk_keys](uint a, uint b) {
+    const int cmp = pk_keys[a].compare(pk_keys[b]);
+    return cmp < 0 || (cmp == 0 && a < b);
+  });
+
+  // the later of two rows sharing a key is a duplicate
+  uint unique_count = count;
+  for (uint i = 1; i < count; i++) {
+    if (pk_keys[order[i]] == pk_keys[order[i - 1]]) {
+      unique_count = std::min(unique_count, order[i]);
+    }
+  }
+
+  std::vector<xengine::common::Slice> keys;
+  std::vector<uint> rows;
+  keys.reserve(unique_count);
+  rows.reserve(unique_count);
+  for (uint i = 0; i < count; i++) {
+    if (order[i] < unique_count) {
+      keys.push_back(pk_keys[order[i]]);
+      rows.push_back(order[i]);
+    }
+  }
+
+  *checked = 0;
+  if (keys.empty()) {
+    return HA_EXIT_SUCCESS;
+  }
+
+  std::vector<std::string> values;
+  std::vector<xengine::common::Status> statuses =
+      tx->multi_get_for_update(m_pk_descr->get_cf(), keys, &values, true /* exclusive */);
+  // If we have a lock conflict and we are running in READ COMMITTTED mode
+  // release and reacquire the snapshot and then retry, as get_for_update()
+  if (statuses[0].IsBusy() && !statuses[0].IsDeadlock() &&
+      my_core::thd_tx_isolation(ha_thd()) == ISO_READ_COMMITTED) {
+    tx->release_snapshot();
+    tx->acquire_snapshot(false);
+    statuses = tx->multi_get_for_update(m_pk_descr->get_cf(), keys, &values, true /* exclusive */);
+  }
+
+  *checked = unique_count;
+  for (size_t i = 0; i < keys.size(); i++) {
+    const xengine::common::Status &s = statuses[i];
+    if (!s.ok() && !s.IsNotFound()) {
+      __XHANDLER_LOG(WARN, "DML: multi_get_for_update for %zu keys on index(%u) failed with error:%s, table_name: %s",
+                     keys.size(), m_pk_descr->get_index_number(),
+                     s.ToString().c_str(), table->s->table_name.str);
+      *checked = 0;
+      return tx->set_status_error(table->in_use, s, *m_pk_descr, m_tbl_def.get());
+    } else if (s.ok()) {
+      *checked = std::min(*checked, rows[i]);
+    }
+  }
+  return HA_EXIT_SUCCESS;
+}
+
+/*
+  Insert a batch of rows. Every row is encoded once, all primary keys are
+  locked and checked in one pass, and the index entries of the rows are
+  appended to the transaction's write batch without locking again. From the
+  first duplicate on, the rows go through write_row(), which reports it.
+*/
+int ha_xengine::write_rows(uchar **records, uint count) {
+  DBUG_ENTER_FUNC();
+
+  DBUG_ASSERT(m_lock_rows == XDB_LOCK_WRITE);
+  if (count <= 1 || !can_write_rows_batch()) {
+    DBUG_RETURN(handler::write_rows(records, count));
+  }
+
+  // the indexes in the order the rows are encoded, the primary key first
+  std::vector<const Xdb_key_def *> kds(1, m_pk_descr.get());
+  for (uint key_id = 0; key_id < m_tbl_def->m_key_count; key_id++) {
+    if (!is_pk(key_id, table, m_tbl_def.get())) {
+      kds.push_back(m_key_descr_arr[key_id].get());
+    }
+  }
+  const uint entries = 2 * kds.size();
+
+  int rc = HA_EXIT_SUCCESS;
+  Xdb_transaction *const tx = get_or_create_tx(table->in_use);
+  std::string buf;
+  std::vector<size_t> ends;
+  const uint packed = pack_rows_batch(records, count, kds, &buf, &ends);
+
+  uint checked = 0;
+  if (packed > 0 &&
+      (rc = check_and_lock_unique_pks(tx, packed, entries, buf, ends, &checked))) {
+    memcpy(table->record[0], records[0], table->s->reclength);
+    DBUG_RETURN(rc);
+  }
+
+  DEBUG_SYNC(ha_thd(), "xengine.write_rows_after_unique_check");
+
+  size_t begin = 0;
+  const size_t *end = ends.data();
+  for (uint i = 0; i < checked; i++) {
+    ha_statistic_increment(&SSV::ha_write_count);
+    for (const Xdb_key_def *kd : kds) {
+      const size_t key_end = *end++;
+      const size_t value_end = *end++;
+      tx->get_indexed_write_batch()->Put(
+          kd->get_cf(),
+          xengine::common::Slice(buf.data() + begin, key_end - begin),
+          xengine::common::Slice(buf.data() + key_end, value_end - key_end));
+      begin = value_end;
+    }
+    update_row_stats(ROWS_INSERTED);
+  }
+
+  if (checked > 0) {
+    bool write_batch_iter_invalid_flag = commit_in_the_middle() &&
+        tx->get_write_count() >= XDB_DEFAULT_BULK_LOAD_SIZE;
+    if (do_bulk_commit(tx)) {
+      DBUG_RETURN(HA_ERR_INTERNAL_ERROR);
+    }
+    if (write_batch_iter_invalid_flag && m_scan_it) {
+      util::BaseDeltaIterator *p_scan = dynamic_cast<util::BaseDeltaIterator *>(m_scan_it);
+      if (p_scan) {
+        p_scan->InvalidDelta();
+      }
+    }
+  }
+
+  if (checked < count) {
+    rc = handler::write_rows(records + checked, count - checked);
+  }
+
+  DBUG_RETURN(rc);
+}
+
 /**
   Constructing m_last_rowkey (XEngine key expression) from
   before_update|delete image (MySQL row expression).
@@ -12623,6 +13153,10 @@ struct xengine_status_counters_t {
   uint64_t number_superversion_releases;
   uint64_t number_superversion_cleanups;
   uint64_t number_block_not_compressed;
+  uint64_t rate_limiter_bytes_per_sec;
+  uint64_t rate_limiter_high_pri_bytes;
+  uint64_t rate_limiter_low_pri_bytes;
+  uint64_t rate_limiter_read_latency;
 };
 
 static xengine_status_counters_t xengine_status_counters;
@@ -12667,6 +13201,27 @@ DEF_SHOW_FUNC(number_superversion_releases, NUMBER_SUPERVERSION_RELEASES)
 DEF_SHOW_FUNC(number_superversion_cleanups, NUMBER_SUPERVERSION_CLEANUPS)
 DEF_SHOW_FUNC(number_block_not_compressed, NUMBER_BLOCK_NOT_COMPRESSED)
 
+#define DEF_RATE_LIMITER_SHOW_FUNC(name, expr)                                 \
+  static int SHOW_FNAME(name)(MYSQL_THD thd, SHOW_VAR * var, char *buff) {     \
+    xengine_status_counters.name =                                             \
+        xengine_rate_limiter != nullptr ? (expr) : 0;                          \
+    var->type = SHOW_LONGLONG;                                                 \
+    var->value = (char *)&xengine_status_counters.name;                        \
+    var->scope = SHOW_SCOPE_GLOBAL;                                            \
+    return HA_EXIT_SUCCESS;                                                    \
+  }
+
+DEF_RATE_LIMITER_SHOW_FUNC(rate_limiter_bytes_per_sec,
+                           xengine_rate_limiter->GetBytesPerSecond())
+DEF_RATE_LIMITER_SHOW_FUNC(rate_limiter_high_pri_bytes,
+                           xengine_rate_limiter->GetTotalBytesThrough(
+                               xengine::util::Env::IO_HIGH))
+DEF_RATE_LIMITER_SHOW_FUNC(rate_limiter_low_pri_bytes,
+                           xengine_rate_limiter->GetTotalBytesThrough(
+                               xengine::util::Env::IO_LOW))
+DEF_RATE_LIMITER_SHOW_FUNC(rate_limiter_read_latency,
+                           xengine_rate_limiter->GetForegroundReadLatency())
+
 static void myx_update_status() {
   export_stats.rows_deleted = global_stats.rows[ROWS_DELETED];
   export_stats.rows_inserted = global_stats.rows[ROWS_INSERTED];
@@ -12751,6 +13306,10 @@ static SHOW_VAR xengine_status_vars[] = {
     DEF_STATUS_VAR(number_superversion_releases),
     DEF_STATUS_VAR(number_superversion_cleanups),
     DEF_STATUS_VAR(number_block_not_compressed),
+    DEF_STATUS_VAR(rate_limiter_bytes_per_sec),
+    DEF_STATUS_VAR(rate_limiter_high_pri_bytes),
+    DEF_STATUS_VAR(rate_limiter_low_pri_bytes),
+    DEF_STATUS_VAR(rate_limiter_read_latency),
     DEF_STATUS_VAR_PTR("snapshot_conflict_errors",
                        &xengine_snapshot_conflict_errors, SHOW_LONGLONG),
     DEF_STATUS_VAR_PTR("wal_group_syncs", &xengine_wal_group_syncs,
@@ -13492,6 +14051,18 @@ static void xengine_set_rate_limiter_bytes_per_sec(
   }
 }
 
+static void xengine_set_rate_limiter_read_latency_target(
+    THD *thd, struct SYS_VAR *const var, void *const var_ptr,
+    const void *const save) {
+  DBUG_ASSERT(save != nullptr);
+
+  xengine_rate_limiter_read_latency_target = *static_cast<const ulong *>(save);
+  if (xengine_rate_limiter != nullptr) {
+    xengine_rate_limiter->SetForegroundReadLatencyTarget(
+        xengine_rate_limiter_read_latency_target);
+  }
+}
+
 void xdb_set_collation_exception_list(const char *const exception_list) {
   DBUG_ASSERT(xdb_collation_exceptions != nullptr);
 
@@ -13675,6 +14246,71 @@ static void xengine_set_total_max_shrink_extent_count(
   XDB_MUTEX_UNLOCK_CHECK(xdb_sysvars_mutex);
 }
 
+static void xengine_set_shrink_round_extent_count(
+    THD *thd, struct SYS_VAR *const var, void *const var_ptr,
+    const void *const save) {
+  DBUG_ASSERT(save != nullptr);
+
+  XDB_MUTEX_LOCK_CHECK(xdb_sysvars_mutex);
+
+  xengine_db_options.shrink_round_extent_count = *static_cast<const ulong *>(save);
+
+  xdb->SetDBOptions({{
+      "shrink_round_extent_count",
+      std::to_string(xengine_db_options.shrink_round_extent_count)}});
+
+  XDB_MUTEX_UNLOCK_CHECK(xdb_sysvars_mutex);
+}
+
+static void xengine_set_shrink_rate_limit(
+    THD *thd, struct SYS_VAR *const var, void *const var_ptr,
+    const void *const save) {
+  DBUG_ASSERT(save != nullptr);
+
+  XDB_MUTEX_LOCK_CHECK(xdb_sysvars_mutex);
+
+  xengine_db_options.shrink_rate_limit = *static_cast<const ulong *>(save);
+
+  xdb->SetDBOptions({{
+      "shrink_rate_limit",
+      std::to_string(xengine_db_options.shrink_rate_limit)}});
+
+  XDB_MUTEX_UNLOCK_CHECK(xdb_sysvars_mutex);
+}
+
+static void xengine_set_cache_prewarm_dump_period(
+    THD *thd, struct SYS_VAR *const var, void *const var_ptr,
+    const void *const save) {
+  DBUG_ASSERT(save != nullptr);
+
+  XDB_MUTEX_LOCK_CHECK(xdb_sysvars_mutex);
+
+  xengine_db_options.cache_prewarm_dump_period_sec =
+      *static_cast<const ulong *>(save);
+
+  xdb->SetDBOptions({{
+      "cache_prewarm_dump_period_sec",
+      std::to_string(xengine_db_options.cache_prewarm_dump_period_sec)}});
+
+  XDB_MUTEX_UNLOCK_CHECK(xdb_sysvars_mutex);
+}
+
+static void xengine_set_cache_prewarm_rate_limit(
+    THD *thd, struct SYS_VAR *const var, void *const var_ptr,
+    const void *const save) {
+  DBUG_ASSERT(save != nullptr);
+
+  XDB_MUTEX_LOCK_CHECK(xdb_sysvars_mutex);
+
+  xengine_db_options.cache_prewarm_rate_limit = *static_cast<const ulong *>(save);
+
+  xdb->SetDBOptions({{
+      "cache_prewarm_rate_limit",
+      std::to_string(xengine_db_options.cache_prewarm_rate_limit)}});
+
+  XDB_MUTEX_UNLOCK_CHECK(xdb_sysvars_mutex);
+}
+
 static void xengine_set_auto_shrink_schedule_interval(THD *thd,
                                                       struct SYS_VAR *const var,
                                                       void *const var_ptr,
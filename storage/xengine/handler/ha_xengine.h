@@ -803,7 +803,8 @@ public:
                 HA_CAN_INDEX_BLOBS |
                 (m_pk_can_be_decoded ? HA_PRIMARY_KEY_IN_READ_INDEX : 0) |
                 HA_PRIMARY_KEY_REQUIRED_FOR_POSITION | HA_NULL_IN_KEY |
-                HA_PARTIAL_COLUMN_READ | HA_ATTACHABLE_TRX_COMPATIBLE);
+                HA_PARTIAL_COLUMN_READ | HA_ATTACHABLE_TRX_COMPATIBLE |
+                HA_CAN_WRITE_ROWS_BATCH);
   }
 
   bool init_with_fields() ;
@@ -1026,6 +1027,8 @@ public:
 
   int write_row(uchar *const buf) override
       MY_ATTRIBUTE((__warn_unused_result__));
+  int write_rows(uchar **records, uint count) override
+      MY_ATTRIBUTE((__warn_unused_result__));
   int update_row(const uchar *const old_data, uchar *const new_data) override
       MY_ATTRIBUTE((__warn_unused_result__));
   int delete_row(const uchar *const buf) override
@@ -1233,6 +1236,15 @@ private:
   int check_uniqueness_and_lock(const struct update_row_info &row_info,
                                 bool *const pk_changed)
       MY_ATTRIBUTE((__warn_unused_result__));
+  bool can_write_rows_batch() const;
+  uint pack_rows_batch(uchar **records, uint count,
+                       const std::vector<const Xdb_key_def *> &kds,
+                       std::string *const buf, std::vector<size_t> *const ends);
+  int check_and_lock_unique_pks(Xdb_transaction *const tx, uint count,
+                                uint entries, const std::string &buf,
+                                const std::vector<size_t> &ends,
+                                uint *const checked)
+      MY_ATTRIBUTE((__warn_unused_result__));
   int check_uniqueness_and_lock_rebuild(const struct update_row_info &row_info,
                                         bool *const pk_changed)
       MY_ATTRIBUTE((__warn_unused_result__));
@@ -1928,6 +1940,15 @@ public:
       const xengine::common::Slice &key, std::string *const value,
       bool exclusive, bool only_lock = false) = 0;
 
+  /*
+    Lock the keys in the given order, then read them at once. The statuses
+    are all the same error if any of the locks fails.
+  */
+  virtual std::vector<xengine::common::Status> multi_get_for_update(
+      xengine::db::ColumnFamilyHandle *const column_family,
+      const std::vector<xengine::common::Slice> &keys,
+      std::vector<std::string> *const values, bool exclusive) = 0;
+
   virtual xengine::common::Status lock_unique_key(xengine::db::ColumnFamilyHandle *const column_family,
                                                   const xengine::common::Slice &key,
                                                   const bool skip_bloom_filter,
@@ -977,6 +977,34 @@ static int xdb_i_s_global_info_fill_table(
                                     max_index_id_buf);
   }
 
+  /* shrink extent space progress */
+  xengine::db::DB *const xdb = xdb_get_xengine_db();
+  xengine::storage::ShrinkProgress shrink_progress;
+  char shrink_buf[INT_BUF_LEN] = {0};
+
+  if (xdb != nullptr &&
+      xengine::common::Status::kOk == xdb->get_shrink_progress(shrink_progress)) {
+    ret |= xdb_global_info_fill_row(thd, tables, "SHRINK", "RUNNING",
+                                    shrink_progress.running_ ? "ON" : "OFF");
+    snprintf(shrink_buf, INT_BUF_LEN, "%ld", shrink_progress.table_space_id_);
+    ret |= xdb_global_info_fill_row(thd, tables, "SHRINK", "TABLE_SPACE_ID",
+                                    shrink_buf);
+    snprintf(shrink_buf, INT_BUF_LEN, "%d", shrink_progress.extent_space_type_);
+    ret |= xdb_global_info_fill_row(thd, tables, "SHRINK", "EXTENT_SPACE_TYPE",
+                                    shrink_buf);
+    snprintf(shrink_buf, INT_BUF_LEN, "%ld",
+             shrink_progress.total_extent_count_);
+    ret |= xdb_global_info_fill_row(thd, tables, "SHRINK",
+                                    "TOTAL_EXTENT_COUNT", shrink_buf);
+    snprintf(shrink_buf, INT_BUF_LEN, "%ld",
+             shrink_progress.shrunk_extent_count_);
+    ret |= xdb_global_info_fill_row(thd, tables, "SHRINK",
+                                    "SHRUNK_EXTENT_COUNT", shrink_buf);
+    snprintf(shrink_buf, INT_BUF_LEN, "%ld", shrink_progress.round_count_);
+    ret |= xdb_global_info_fill_row(thd, tables, "SHRINK", "ROUND_COUNT",
+                                    shrink_buf);
+  }
+
 #if 0
   /* cf_id -> cf_flags */
   char cf_id_buf[INT_BUF_LEN] = {0};
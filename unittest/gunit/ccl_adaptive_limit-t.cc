@@ -0,0 +1,120 @@
+/* Copyright (c) 2018, 2021, Alibaba and/or its affiliates. All rights reserved.
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL/Apsara GalaxyEngine hereby grant you an
+   additional permission to link the program and your derivative works with the
+   separately licensed software that they have included with
+   MySQL/Apsara GalaxyEngine.
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+// First include (the generated) my_config.h, to get correct platform defines,
+// then gtest.h (before any other MySQL headers), to avoid min() macros etc ...
+#include "my_config.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+
+#include "sql/ccl/ccl.h"
+
+namespace ccl_adaptive_limit_unittest {
+
+using im::Ccl_adaptive_limit;
+
+static const ulonglong CEILING = 32;
+static const ulonglong FLOOR = 2;
+static const ulonglong TOLERANCE = 150;
+
+/* Sample one window (the current limit worth of statements) */
+static void sample_window(Ccl_adaptive_limit *adaptive, ulonglong latency,
+                          bool waiting) {
+  ulonglong count = adaptive->get(CEILING, FLOOR);
+  for (ulonglong i = 0; i < count; i++)
+    adaptive->sample(latency, CEILING, FLOOR, TOLERANCE, waiting);
+}
+
+TEST(CclAdaptiveLimitTest, Disabled) {
+  Ccl_adaptive_limit adaptive;
+  adaptive.reset(CEILING);
+  for (int i = 0; i < 100; i++)
+    adaptive.sample(1000 * (i + 1), CEILING, FLOOR, 0, true);
+  EXPECT_EQ(CEILING, adaptive.get(CEILING, FLOOR));
+  EXPECT_EQ(0U, adaptive.get_baseline());
+}
+
+TEST(CclAdaptiveLimitTest, SteadyLatencyKeepsLimit) {
+  /* The target is relative to each slot's own baseline, so a fast and a
+     slow rule both keep their limit under a steady latency. */
+  Ccl_adaptive_limit fast;
+  Ccl_adaptive_limit slow;
+  fast.reset(CEILING);
+  slow.reset(CEILING);
+  for (int i = 0; i < 10; i++) {
+    sample_window(&fast, 50, false);
+    sample_window(&slow, 500 * 1000, false);
+  }
+  EXPECT_EQ(CEILING, fast.get(CEILING, FLOOR));
+  EXPECT_EQ(CEILING, slow.get(CEILING, FLOOR));
+  EXPECT_EQ(50U, fast.get_baseline());
+  EXPECT_EQ(500U * 1000, slow.get_baseline());
+}
+
+TEST(CclAdaptiveLimitTest, MovesBothWays) {
+  Ccl_adaptive_limit adaptive;
+  adaptive.reset(CEILING);
+
+  /* Establish the baseline */
+  sample_window(&adaptive, 1000, false);
+  EXPECT_EQ(1000U, adaptive.get_baseline());
+  EXPECT_EQ(CEILING, adaptive.get(CEILING, FLOOR));
+
+  /* Latency over the target shrinks the limit, at most by half a window */
+  sample_window(&adaptive, 4000, true);
+  ulonglong limit = adaptive.get(CEILING, FLOOR);
+  EXPECT_EQ(CEILING / 2, limit);
+
+  /* Keeps shrinking while it stays slow, down to the floor */
+  for (int i = 0; i < 10; i++) {
+    sample_window(&adaptive, 4000, true);
+    EXPECT_LE(adaptive.get(CEILING, FLOOR), limit);
+    EXPECT_GE(adaptive.get(CEILING, FLOOR), FLOOR);
+    limit = adaptive.get(CEILING, FLOOR);
+  }
+  EXPECT_LT(limit, CEILING / 2);
+
+  /* Target met without waiters, the limit stays */
+  sample_window(&adaptive, 1000, false);
+  EXPECT_EQ(limit, adaptive.get(CEILING, FLOOR));
+
+  /* Target met with waiters, the limit grows back by one per window */
+  for (int i = 0; i < 100; i++) {
+    sample_window(&adaptive, 1000, true);
+    ulonglong next = adaptive.get(CEILING, FLOOR);
+    EXPECT_EQ(std::min(limit + 1, CEILING), next);
+    limit = next;
+  }
+  EXPECT_EQ(CEILING, limit);
+}
+
+TEST(CclAdaptiveLimitTest, ResetOnNewConcurrency) {
+  Ccl_adaptive_limit adaptive;
+  adaptive.reset(CEILING);
+  sample_window(&adaptive, 1000, false);
+  sample_window(&adaptive, 8000, true);
+  EXPECT_LT(adaptive.get(CEILING, FLOOR), CEILING);
+
+  adaptive.reset(CEILING);
+  EXPECT_EQ(CEILING, adaptive.get(CEILING, FLOOR));
+  EXPECT_EQ(0U, adaptive.get_baseline());
+}
+
+}  // namespace ccl_adaptive_limit_unittest
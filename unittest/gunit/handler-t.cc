@@ -24,6 +24,7 @@
 
 #include <stddef.h>
 #include <sys/types.h>
+#include <vector>
 
 #include "sql/sql_executor.h"
 #include "unittest/gunit/fake_table.h"
@@ -284,4 +285,48 @@ TEST_F(HandlerTest, SamplingInterfaceNoRows) {
   EXPECT_EQ(mock_handler.inited, handler::NONE);
 }
 
+/**
+  The default write_rows() copies the rows to record[0] and inserts them in
+  the given order, up to the first row that fails, which is left in
+  record[0] for the error message.
+*/
+TEST_F(HandlerTest, WriteRowsDefault) {
+  Mock_field_datetime field_datetime;
+  Fake_TABLE table(&field_datetime);
+  StrictMock<Mock_WRITE_ROWS_HANDLER> mock_handler(nullptr, &table,
+                                                   table.get_share());
+  table.set_handler(&mock_handler);
+
+  uchar record[8] = {0};
+  uchar rows[3][sizeof(record)];
+  uchar *records[3];
+  for (int i = 0; i < 3; ++i) {
+    memset(rows[i], i + 1, sizeof(record));
+    records[i] = rows[i];
+  }
+  table.record[0] = record;
+  table.get_share()->reclength = sizeof(record);
+
+  std::vector<uchar> written;
+  auto write = [&written](uchar *buf) {
+    written.push_back(buf[0]);
+    return 0;
+  };
+
+  EXPECT_CALL(mock_handler, write_row(record))
+      .Times(3)
+      .WillRepeatedly(::testing::Invoke(write));
+  EXPECT_EQ(0, mock_handler.write_rows(records, 3));
+  EXPECT_EQ(std::vector<uchar>({1, 2, 3}), written);
+
+  written.clear();
+  EXPECT_CALL(mock_handler, write_row(record))
+      .Times(2)
+      .WillOnce(::testing::Invoke(write))
+      .WillOnce(::testing::Return(HA_ERR_FOUND_DUPP_KEY));
+  EXPECT_EQ(HA_ERR_FOUND_DUPP_KEY, mock_handler.write_rows(records, 3));
+  EXPECT_EQ(std::vector<uchar>({1}), written);
+  EXPECT_EQ(2, record[0]);
+}
+
 }  // namespace
@@ -61,6 +61,23 @@ class Mock_SAMPLING_HANDLER : public Base_mock_HANDLER {
   }
 };
 
+/**
+  A mock handler for testing the default write_rows(), which should insert
+  the rows one by one through write_row().
+*/
+class Mock_WRITE_ROWS_HANDLER : public Base_mock_HANDLER {
+ public:
+  MOCK_METHOD1(write_row, int(::uchar *buf));
+
+  using handler::write_rows;
+
+  Mock_WRITE_ROWS_HANDLER(handlerton *ht_arg, TABLE *table_arg,
+                          TABLE_SHARE *share)
+      : Base_mock_HANDLER(ht_arg, share) {
+    table = table_arg;
+  }
+};
+
 /**
   A mock for the handlerton struct
 */
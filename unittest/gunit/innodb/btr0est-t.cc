@@ -0,0 +1,171 @@
+/* Copyright (c) 2018, 2021, Alibaba and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "storage/innobase/include/btr0est.h"
+#include "storage/innobase/include/os0event.h"
+#include "storage/innobase/include/os0thread.h"
+#include "storage/innobase/include/srv0srv.h"
+#include "storage/innobase/include/sync0debug.h"
+#include "storage/innobase/include/univ.i"
+
+namespace innodb_btr0est_unittest {
+
+class btr0est : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    srv_max_n_threads = srv_sync_array_size + 1;
+    os_event_global_init();
+    sync_check_init(srv_max_n_threads);
+  }
+
+  static void TearDownTestCase() {
+    sync_check_close();
+    os_event_global_destroy();
+  }
+
+  void SetUp() override {
+    m_saved_size = srv_btr_range_est_cache_size;
+    m_saved_ttl = srv_btr_range_est_cache_ttl;
+    srv_btr_range_est_cache_size = 16;
+    srv_btr_range_est_cache_ttl = 3600;
+
+    /* Only the statistics fields are read by the cache */
+    m_table = new dict_table_t();
+    m_table->stats_last_recalc = 1;
+    m_table->stat_n_rows = 1000;
+    m_table->stat_modified_counter = 0;
+  }
+
+  void TearDown() override {
+    delete m_table;
+    srv_btr_range_est_cache_size = m_saved_size;
+    srv_btr_range_est_cache_ttl = m_saved_ttl;
+  }
+
+  dict_table_t *m_table;
+  ulong m_saved_size;
+  ulong m_saved_ttl;
+};
+
+TEST_F(btr0est, hit_and_miss) {
+  Range_est_cache cache;
+  int64_t n_rows = 0;
+
+  EXPECT_FALSE(cache.lookup(m_table, "a", &n_rows));
+
+  cache.insert(m_table, "a", 10);
+  cache.insert(m_table, "b", 20);
+
+  EXPECT_TRUE(cache.lookup(m_table, "a", &n_rows));
+  EXPECT_EQ(10, n_rows);
+  EXPECT_TRUE(cache.lookup(m_table, "b", &n_rows));
+  EXPECT_EQ(20, n_rows);
+  EXPECT_FALSE(cache.lookup(m_table, "c", &n_rows));
+
+  /* A new estimation of the same range replaces the old one */
+  cache.insert(m_table, "a", 11);
+  EXPECT_TRUE(cache.lookup(m_table, "a", &n_rows));
+  EXPECT_EQ(11, n_rows);
+}
+
+TEST_F(btr0est, evicts_least_recently_used) {
+  Range_est_cache cache;
+  int64_t n_rows = 0;
+
+  srv_btr_range_est_cache_size = 2;
+
+  cache.insert(m_table, "a", 1);
+  cache.insert(m_table, "b", 2);
+
+  /* "b" becomes the least recently used */
+  EXPECT_TRUE(cache.lookup(m_table, "a", &n_rows));
+
+  cache.insert(m_table, "c", 3);
+
+  EXPECT_TRUE(cache.lookup(m_table, "a", &n_rows));
+  EXPECT_EQ(1, n_rows);
+  EXPECT_FALSE(cache.lookup(m_table, "b", &n_rows));
+  EXPECT_TRUE(cache.lookup(m_table, "c", &n_rows));
+  EXPECT_EQ(3, n_rows);
+
+  /* A smaller size takes effect on the next insert */
+  srv_btr_range_est_cache_size = 1;
+  cache.insert(m_table, "d", 4);
+  EXPECT_FALSE(cache.lookup(m_table, "a", &n_rows));
+  EXPECT_FALSE(cache.lookup(m_table, "c", &n_rows));
+  EXPECT_TRUE(cache.lookup(m_table, "d", &n_rows));
+}
+
+TEST_F(btr0est, invalid_after_stats_recalc) {
+  Range_est_cache cache;
+  int64_t n_rows = 0;
+
+  cache.insert(m_table, "a", 10);
+
+  m_table->stats_last_recalc++;
+  EXPECT_FALSE(cache.lookup(m_table, "a", &n_rows));
+
+  /* The stale entry was dropped, not revived by the old stats */
+  m_table->stats_last_recalc--;
+  EXPECT_FALSE(cache.lookup(m_table, "a", &n_rows));
+}
+
+TEST_F(btr0est, invalid_after_modifications) {
+  Range_est_cache cache;
+  int64_t n_rows = 0;
+  const ib_uint64_t allowed =
+      m_table->stat_n_rows / BTR_RANGE_EST_CACHE_MODIFIED_RATIO;
+
+  m_table->stat_modified_counter = 5;
+  cache.insert(m_table, "a", 10);
+  cache.insert(m_table, "b", 10);
+
+  m_table->stat_modified_counter = 5 + allowed;
+  EXPECT_TRUE(cache.lookup(m_table, "a", &n_rows));
+
+  m_table->stat_modified_counter = 5 + allowed + 1;
+  EXPECT_FALSE(cache.lookup(m_table, "a", &n_rows));
+
+  /* The counter is reset when the table is queued for recalculation */
+  m_table->stat_modified_counter = 0;
+  EXPECT_FALSE(cache.lookup(m_table, "b", &n_rows));
+}
+
+TEST_F(btr0est, invalid_after_ttl) {
+  Range_est_cache cache;
+  int64_t n_rows = 0;
+
+  srv_btr_range_est_cache_ttl = 0;
+  cache.insert(m_table, "a", 10);
+
+  os_thread_sleep(1100000);
+
+  EXPECT_FALSE(cache.lookup(m_table, "a", &n_rows));
+}
+
+}  // namespace innodb_btr0est_unittest
@@ -0,0 +1,104 @@
+/* Copyright (c) 2018, 2021, Alibaba and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+
+#include <gtest/gtest.h>
+
+#include "storage/innobase/include/fsp0fsp.h"
+#include "storage/innobase/include/page0size.h"
+#include "storage/innobase/include/univ.i"
+
+namespace innodb_fsp0fsp_unittest {
+
+class fsp0fsp : public ::testing::Test {
+ protected:
+  void SetUp() override { m_saved = fsp_ibd_auto_extend_increment; }
+  void TearDown() override { fsp_ibd_auto_extend_increment = m_saved; }
+
+  ulong m_saved;
+};
+
+/* The default page size, 64 pages per extent */
+static const page_size_t univ_page_size_16k(0, 0, false);
+static const page_no_t EXTENT = 64;
+static const page_no_t MB = 64;
+
+TEST_F(fsp0fsp, extend_ibd_default) {
+  fsp_ibd_auto_extend_increment = 0;
+
+  /* Below 32 extents, one extent at a time */
+  EXPECT_EQ(EXTENT, fsp_get_pages_to_extend_ibd(univ_page_size_16k, 0));
+  EXPECT_EQ(EXTENT,
+            fsp_get_pages_to_extend_ibd(univ_page_size_16k, 32 * EXTENT - 1));
+
+  /* Then FSP_FREE_ADD extents, whatever the size */
+  EXPECT_EQ(FSP_FREE_ADD * EXTENT,
+            fsp_get_pages_to_extend_ibd(univ_page_size_16k, 32 * EXTENT));
+  EXPECT_EQ(FSP_FREE_ADD * EXTENT,
+            fsp_get_pages_to_extend_ibd(univ_page_size_16k, 1024 * 1024));
+}
+
+TEST_F(fsp0fsp, extend_ibd_grows_with_size) {
+  fsp_ibd_auto_extend_increment = 64;
+
+  /* Small tablespaces are not affected */
+  EXPECT_EQ(EXTENT,
+            fsp_get_pages_to_extend_ibd(univ_page_size_16k, 32 * EXTENT - 1));
+  EXPECT_EQ(FSP_FREE_ADD * EXTENT,
+            fsp_get_pages_to_extend_ibd(univ_page_size_16k, 32 * EXTENT));
+
+  /* 1/8 of the size, rounded down to whole extents */
+  EXPECT_EQ(16 * MB, fsp_get_pages_to_extend_ibd(univ_page_size_16k, 128 * MB));
+  EXPECT_EQ(7 * EXTENT,
+            fsp_get_pages_to_extend_ibd(univ_page_size_16k, 63 * EXTENT));
+
+  /* Never more than the configured maximum */
+  EXPECT_EQ(64 * MB, fsp_get_pages_to_extend_ibd(univ_page_size_16k, 512 * MB));
+  EXPECT_EQ(64 * MB,
+            fsp_get_pages_to_extend_ibd(univ_page_size_16k, 1024 * 1024 * MB));
+
+  /* A maximum below FSP_FREE_ADD extents does not make it smaller */
+  fsp_ibd_auto_extend_increment = 1;
+  EXPECT_EQ(FSP_FREE_ADD * EXTENT,
+            fsp_get_pages_to_extend_ibd(univ_page_size_16k, 1024 * MB));
+}
+
+TEST_F(fsp0fsp, extend_ibd_compressed) {
+  /* 8KiB compressed pages, 128 pages per extent */
+  const page_size_t page_size(8192, UNIV_PAGE_SIZE, true);
+  const page_no_t extent = 128;
+
+  fsp_ibd_auto_extend_increment = 64;
+
+  EXPECT_EQ(extent, fsp_get_pages_to_extend_ibd(page_size, 32 * extent - 1));
+  EXPECT_EQ(FSP_FREE_ADD * extent,
+            fsp_get_pages_to_extend_ibd(page_size, 32 * extent));
+
+  /* 64 megabytes of 8KiB pages */
+  EXPECT_EQ(64 * extent,
+            fsp_get_pages_to_extend_ibd(page_size, 1024 * 1024 * extent));
+  EXPECT_EQ(16 * extent, fsp_get_pages_to_extend_ibd(page_size, 128 * extent));
+}
+
+}  // namespace innodb_fsp0fsp_unittest
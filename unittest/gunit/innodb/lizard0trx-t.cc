@@ -0,0 +1,201 @@
+/* Copyright (c) 2018, 2021, Alibaba and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL/Apsara GalaxyEngine hereby grant you an
+   additional permission to link the program and your derivative works with the
+   separately licensed software that they have included with
+   MySQL/Apsara GalaxyEngine.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/* First include (the generated) my_config.h to get correct platform defines. */
+#include "my_config.h"
+
+#include <gtest/gtest.h>
+#include <stddef.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "storage/innobase/include/os0event.h" /* os_event_global_*() */
+#include "storage/innobase/include/os0thread-create.h" /* os_thread_*() */
+#include "storage/innobase/include/os0thread.h" /* os_thread_*() */
+#include "storage/innobase/include/srv0conc.h"  /* srv_max_n_threads */
+#include "storage/innobase/include/sync0debug.h" /* sync_check_init(), sync_check_close() */
+#include "storage/innobase/include/sync0policy.h" /* needed by ib0mutex.h, which is not self contained */
+#include "storage/innobase/include/univ.i"
+#include "storage/innobase/include/ut0dbg.h" /* ut_chrono_t */
+#include "storage/innobase/include/ut0mutex.h" /* mutex_enter() */
+
+#include "storage/innobase/include/lizard0trx.h"
+
+namespace innodb_lizard_trx_unittest {
+
+/** The rw_trx_hash before partitioning: one map under one mutex, which is
+what trx_sys->mutex used to serialize. */
+class single_mutex_hash_t {
+ public:
+  single_mutex_hash_t() { mutex_create(LATCH_ID_TEST_MUTEX, &m_mutex); }
+
+  ~single_mutex_hash_t() { mutex_free(&m_mutex); }
+
+  void insert(const TrxPair &pair) {
+    mutex_enter(&m_mutex);
+    m_map.insert(pair);
+    mutex_exit(&m_mutex);
+  }
+
+  void erase(trx_id_t id) {
+    mutex_enter(&m_mutex);
+    m_map.erase(id);
+    mutex_exit(&m_mutex);
+  }
+
+  trx_t *find(trx_id_t id) {
+    trx_t *trx = nullptr;
+    mutex_enter(&m_mutex);
+    auto it = m_map.find(id);
+    if (it != m_map.end()) trx = it->second;
+    mutex_exit(&m_mutex);
+    return trx;
+  }
+
+ private:
+  ib_mutex_t m_mutex;
+  std::unordered_map<trx_id_t, trx_t *> m_map;
+};
+
+/** Fake transaction handle derived from the id, never dereferenced. */
+inline trx_t *trx_from_id(trx_id_t id) {
+  return reinterpret_cast<trx_t *>(static_cast<uintptr_t>(id << 3));
+}
+
+/** Emulate the transaction lifecycle: start (insert), a few implicit lock
+checks (find) and commit (erase), trx ids are interleaved between threads
+like they are assigned from trx_sys->max_trx_id.
+@param[in,out]	hash		hash to hammer
+@param[in]	thread_id	thread number
+@param[in]	n_threads	total number of threads
+@param[in]	n_trx		number of transactions per thread */
+template <typename H>
+void thread_lifecycle(H *hash, size_t thread_id, size_t n_threads,
+                      size_t n_trx) {
+  for (size_t i = 0; i < n_trx; i++) {
+    const trx_id_t id = 1 + i * n_threads + thread_id;
+
+    hash->insert(TrxPair(id, trx_from_id(id)));
+
+    for (size_t j = 0; j < 4; j++) {
+      ASSERT_EQ(trx_from_id(id), hash->find(id));
+    }
+
+    hash->erase(id);
+
+    ASSERT_EQ(nullptr, hash->find(id));
+  }
+}
+
+template <typename H>
+static void run_multi_threaded(const char *label, size_t n_threads,
+                               size_t n_trx) {
+#ifdef HAVE_UT_CHRONO_T
+  ut_chrono_t chrono(label);
+#endif /* HAVE_UT_CHRONO_T */
+
+  H *hash = new H();
+
+  std::vector<std::thread> threads;
+
+  for (size_t i = 0; i < n_threads; i++) {
+    threads.emplace_back(thread_lifecycle<H>, hash, i, n_threads, n_trx);
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  delete hash;
+}
+
+class lizard0trx : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    srv_max_n_threads = 1024;
+
+    os_event_global_init();
+    sync_check_init(srv_max_n_threads);
+    os_thread_open();
+  }
+
+  static void TearDownTestCase() {
+    os_thread_close();
+    sync_check_close();
+    os_event_global_destroy();
+  }
+};
+
+TEST_F(lizard0trx, rw_trx_hash_single_threaded) {
+  TrxIdHash *hash = new TrxIdHash();
+
+  const size_t n_elements = 16 * 1024;
+
+  for (trx_id_t id = 1; id <= n_elements; id++) {
+    hash->insert(TrxPair(id, trx_from_id(id)));
+  }
+
+  EXPECT_EQ(n_elements, hash->size());
+
+  TrxIdSet ordered;
+  hash->copy_to(ordered);
+
+  ASSERT_EQ(n_elements, ordered.size());
+
+  trx_id_t expected = 1;
+  for (auto &track : ordered) {
+    ASSERT_EQ(expected, track.m_id);
+    ASSERT_EQ(trx_from_id(expected), track.m_trx);
+    expected++;
+  }
+
+  for (trx_id_t id = 1; id <= n_elements; id++) {
+    ASSERT_EQ(trx_from_id(id), hash->find(id));
+    hash->erase(id);
+    ASSERT_EQ(nullptr, hash->find(id));
+  }
+
+  EXPECT_EQ(0U, hash->size());
+
+  delete hash;
+}
+
+/* Enough iterations for the timings that ut_chrono_t prints to compare the
+partitioned hash against the single mutex protected map it replaced, while
+keeping the test short. */
+static const size_t n_trx_per_thread = 16 * 1024;
+
+TEST_F(lizard0trx, rw_trx_hash_multi_threaded_single_mutex) {
+  run_multi_threaded<single_mutex_hash_t>(
+      "rw trx hash, single mutex, 64 threads" /* label */, 64 /* n_threads */,
+      n_trx_per_thread);
+}
+
+TEST_F(lizard0trx, rw_trx_hash_multi_threaded_partitioned) {
+  run_multi_threaded<TrxIdHash>(
+      "rw trx hash, partitioned, 64 threads" /* label */, 64 /* n_threads */,
+      n_trx_per_thread);
+}
+
+}  // namespace innodb_lizard_trx_unittest
@@ -0,0 +1,175 @@
+/* Copyright (c) 2018, 2021, Alibaba and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+
+#include <gtest/gtest.h>
+#include <stddef.h>
+#include <zlib.h>
+
+#include <vector>
+
+#include "storage/innobase/include/page0zip.h"
+#include "storage/innobase/include/univ.i"
+
+namespace innodb_page0zip_unittest {
+
+typedef std::vector<byte> bytes_t;
+
+/* Fill a page worth of bytes that compresses somewhat, like records do. */
+static bytes_t make_payload(ulint seed) {
+  bytes_t payload(UNIV_PAGE_SIZE);
+
+  for (ulint i = 0; i < payload.size(); i++) {
+    payload[i] = static_cast<byte>((i % 97 == 0) ? (seed * 31 + i) : (i / 64));
+  }
+
+  return (payload);
+}
+
+/* Compress the payload the way page_zip_compress() does: a header part
+flushed with Z_FULL_FLUSH, then the rest finished with Z_FINISH. */
+static bytes_t deflate_page(z_stream *stream, const bytes_t &payload) {
+  bytes_t out(compressBound(static_cast<uLong>(payload.size())) + 64);
+  const uInt head = 128;
+
+  stream->next_out = &out[0];
+  stream->avail_out = static_cast<uInt>(out.size());
+
+  stream->next_in = const_cast<byte *>(&payload[0]);
+  stream->avail_in = head;
+  EXPECT_EQ(Z_OK, deflate(stream, Z_FULL_FLUSH));
+  EXPECT_EQ(0U, stream->avail_in);
+
+  stream->avail_in = static_cast<uInt>(payload.size() - head);
+  EXPECT_EQ(Z_STREAM_END, deflate(stream, Z_FINISH));
+
+  out.resize(out.size() - stream->avail_out);
+  return (out);
+}
+
+/* Compress the payload with a newly initialized stream, as
+page_zip_compress() does when the stream is not reused. */
+static bytes_t deflate_page_fresh(ulint level, const bytes_t &payload) {
+  z_stream stream;
+
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+
+  int err = deflateInit2(&stream, static_cast<int>(level), Z_DEFLATED,
+                         UNIV_PAGE_SIZE_SHIFT, MAX_MEM_LEVEL,
+                         Z_DEFAULT_STRATEGY);
+  EXPECT_EQ(Z_OK, err);
+
+  bytes_t out = deflate_page(&stream, payload);
+
+  deflateEnd(&stream);
+  return (out);
+}
+
+static bytes_t inflate_page(const bytes_t &compressed, ulint size) {
+  bytes_t out(size);
+  z_stream stream;
+
+  stream.zalloc = Z_NULL;
+  stream.zfree = Z_NULL;
+  stream.opaque = Z_NULL;
+  stream.next_in = const_cast<byte *>(&compressed[0]);
+  stream.avail_in = static_cast<uInt>(compressed.size());
+
+  EXPECT_EQ(Z_OK, inflateInit2(&stream, UNIV_PAGE_SIZE_SHIFT));
+
+  stream.next_out = &out[0];
+  stream.avail_out = static_cast<uInt>(out.size());
+
+  EXPECT_EQ(Z_STREAM_END, inflate(&stream, Z_FINISH));
+  EXPECT_EQ(0U, stream.avail_out);
+
+  inflateEnd(&stream);
+  return (out);
+}
+
+/* A reused stream must produce exactly what a new stream produces, or the
+compressed page images (and logged page images) would depend on it. */
+TEST(page0zip, reused_stream_matches_fresh_stream) {
+  Page_zip_deflate_stream reused;
+
+  for (ulint i = 0; i < 8; i++) {
+    const bytes_t payload = make_payload(i);
+
+    z_stream *stream = reused.open(DEFAULT_COMPRESSION_LEVEL);
+    const bytes_t compressed = deflate_page(stream, payload);
+
+    EXPECT_EQ(deflate_page_fresh(DEFAULT_COMPRESSION_LEVEL, payload),
+              compressed);
+    EXPECT_EQ(payload, inflate_page(compressed, payload.size()));
+  }
+}
+
+/* An interrupted page (as on a zlib_error exit of page_zip_compress())
+must not leak into the next one. */
+TEST(page0zip, reused_stream_after_failed_page) {
+  Page_zip_deflate_stream reused;
+  const bytes_t payload = make_payload(1);
+  byte small[16];
+
+  z_stream *stream = reused.open(DEFAULT_COMPRESSION_LEVEL);
+  stream->next_in = const_cast<byte *>(&payload[0]);
+  stream->avail_in = static_cast<uInt>(payload.size());
+  stream->next_out = small;
+  stream->avail_out = sizeof small;
+  EXPECT_EQ(Z_OK, deflate(stream, Z_FINISH));
+  EXPECT_EQ(0U, stream->avail_out);
+
+  const bytes_t compressed =
+      deflate_page(reused.open(DEFAULT_COMPRESSION_LEVEL), payload);
+
+  EXPECT_EQ(deflate_page_fresh(DEFAULT_COMPRESSION_LEVEL, payload),
+            compressed);
+  EXPECT_EQ(payload, inflate_page(compressed, payload.size()));
+}
+
+/* A change of innodb_compression_level reinitializes the stream. */
+TEST(page0zip, reused_stream_follows_level) {
+  Page_zip_deflate_stream reused;
+  const bytes_t payload = make_payload(2);
+
+  EXPECT_FALSE(reused.is_open());
+
+  for (ulint level = 1; level <= 9; level++) {
+    const bytes_t compressed = deflate_page(reused.open(level), payload);
+
+    EXPECT_TRUE(reused.is_open());
+    EXPECT_EQ(level, reused.level());
+    EXPECT_EQ(deflate_page_fresh(level, payload), compressed);
+    EXPECT_EQ(payload, inflate_page(compressed, payload.size()));
+  }
+
+  /* Back to a previous level */
+  const bytes_t compressed = deflate_page(reused.open(1), payload);
+  EXPECT_EQ(1U, reused.level());
+  EXPECT_EQ(deflate_page_fresh(1, payload), compressed);
+}
+
+}  // namespace innodb_page0zip_unittest
@@ -0,0 +1,153 @@
+/* Copyright (c) 2018, 2021, Alibaba and/or its affiliates. All rights reserved.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+// First include (the generated) my_config.h, to get correct platform defines.
+#include "my_config.h"
+
+#include <gtest/gtest.h>
+#include <string.h>
+
+#include "my_aes.h"
+
+/*
+  Tests of the AES contexts (my_aes_ctx_*), which must give the same results
+  as my_aes_encrypt() and my_aes_decrypt() with the same key.
+*/
+
+namespace mysys_my_aes_unittest {
+
+static const uint32 SOURCE_LENGTH = 4 * 1024;
+
+class MyAesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (uint32 i = 0; i < sizeof(m_key); i++) {
+      m_key[i] = static_cast<unsigned char>(i * 7 + 3);
+    }
+
+    for (uint32 i = 0; i < SOURCE_LENGTH; i++) {
+      m_source[i] = static_cast<unsigned char>(i * 13 + (i >> 8));
+    }
+  }
+
+  /** IV number n */
+  void make_iv(unsigned char *iv, uint32 n) {
+    for (uint32 i = 0; i < MY_AES_IV_SIZE; i++) {
+      iv[i] = static_cast<unsigned char>(n * 31 + i);
+    }
+  }
+
+  /**
+    Encrypt and decrypt m_source with a context and with the one shot
+    functions, and compare the results.
+  */
+  void round_trip(my_aes_opmode mode, bool padding, uint32 length) {
+    unsigned char iv[MY_AES_IV_SIZE];
+    unsigned char expected[SOURCE_LENGTH + MY_AES_BLOCK_SIZE];
+    unsigned char encrypted[SOURCE_LENGTH + MY_AES_BLOCK_SIZE];
+    unsigned char decrypted[SOURCE_LENGTH + MY_AES_BLOCK_SIZE];
+
+    my_aes_ctx *enc =
+        my_aes_ctx_create(m_key, sizeof(m_key), mode, true, padding);
+    my_aes_ctx *dec =
+        my_aes_ctx_create(m_key, sizeof(m_key), mode, false, padding);
+    ASSERT_NE(nullptr, enc);
+    ASSERT_NE(nullptr, dec);
+
+    /* The same contexts are reused with a different IV each time */
+    for (uint32 n = 0; n < 4; n++) {
+      make_iv(iv, n);
+
+      int expected_len = my_aes_encrypt(m_source, length, expected, m_key,
+                                        sizeof(m_key), mode, iv, padding);
+      ASSERT_GT(expected_len, 0);
+
+      int encrypted_len = my_aes_ctx_crypt(enc, m_source, length, encrypted, iv);
+      ASSERT_EQ(expected_len, encrypted_len);
+      EXPECT_EQ(0, memcmp(expected, encrypted, encrypted_len));
+
+      int decrypted_len =
+          my_aes_ctx_crypt(dec, encrypted, encrypted_len, decrypted, iv);
+      ASSERT_EQ(static_cast<int>(length), decrypted_len);
+      EXPECT_EQ(0, memcmp(m_source, decrypted, length));
+
+      /* And the one shot decryption of what the context encrypted */
+      memset(decrypted, 0, sizeof(decrypted));
+      decrypted_len = my_aes_decrypt(encrypted, encrypted_len, decrypted,
+                                     m_key, sizeof(m_key), mode, iv, padding);
+      ASSERT_EQ(static_cast<int>(length), decrypted_len);
+      EXPECT_EQ(0, memcmp(m_source, decrypted, length));
+    }
+
+    my_aes_ctx_free(enc);
+    my_aes_ctx_free(dec);
+  }
+
+  unsigned char m_key[32];
+  unsigned char m_source[SOURCE_LENGTH];
+};
+
+/* What InnoDB uses for pages and redo log blocks */
+TEST_F(MyAesTest, Cbc256NoPadding) {
+  round_trip(my_aes_256_cbc, false, SOURCE_LENGTH);
+  round_trip(my_aes_256_cbc, false, 512);
+}
+
+TEST_F(MyAesTest, Padding) {
+  round_trip(my_aes_256_cbc, true, SOURCE_LENGTH);
+  round_trip(my_aes_256_cbc, true, SOURCE_LENGTH - 5);
+  round_trip(my_aes_128_ecb, true, 100);
+}
+
+TEST_F(MyAesTest, AllModes) {
+  for (int mode = MY_AES_BEGIN; mode <= MY_AES_END; mode++) {
+    SCOPED_TRACE(my_aes_opmode_names[mode]);
+    round_trip(static_cast<my_aes_opmode>(mode), true, 1000);
+  }
+}
+
+TEST_F(MyAesTest, Errors) {
+  unsigned char encrypted[SOURCE_LENGTH + MY_AES_BLOCK_SIZE];
+
+  /* CBC needs an IV */
+  my_aes_ctx *ctx =
+      my_aes_ctx_create(m_key, sizeof(m_key), my_aes_256_cbc, true, false);
+  ASSERT_NE(nullptr, ctx);
+  EXPECT_EQ(MY_AES_BAD_DATA,
+            my_aes_ctx_crypt(ctx, m_source, SOURCE_LENGTH, encrypted, nullptr));
+
+  /* Without padding, only whole blocks can be encrypted */
+  unsigned char iv[MY_AES_IV_SIZE];
+  make_iv(iv, 0);
+  EXPECT_EQ(MY_AES_BAD_DATA,
+            my_aes_ctx_crypt(ctx, m_source, MY_AES_BLOCK_SIZE + 1, encrypted,
+                             iv));
+
+  /* The context is still usable after an error */
+  EXPECT_EQ(static_cast<int>(SOURCE_LENGTH),
+            my_aes_ctx_crypt(ctx, m_source, SOURCE_LENGTH, encrypted, iv));
+
+  my_aes_ctx_free(ctx);
+  my_aes_ctx_free(nullptr);
+}
+
+}  // namespace mysys_my_aes_unittest
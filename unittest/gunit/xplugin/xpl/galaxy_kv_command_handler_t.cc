@@ -0,0 +1,278 @@
+/* Copyright (c) 2018, 2021, Alibaba and/or its affiliates. All rights reserved.
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL/Apsara GalaxyEngine hereby grant you an
+   additional permission to link the program and your derivative works with the
+   separately licensed software that they have included with
+   MySQL/Apsara GalaxyEngine.
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <initializer_list>
+
+#include "plugin/x/src/galaxy_stmt_command_handler.h"
+#include "plugin/x/src/xpl_error.h"
+#include "unittest/gunit/xplugin/xpl/assert_error_code.h"
+#include "unittest/gunit/xplugin/xpl/mock/session.h"
+#include "unittest/gunit/xplugin/xpl/mysqlx_pb_wrapper.h"
+#include "unittest/gunit/xplugin/xpl/one_row_resultset.h"
+
+namespace xpl {
+namespace test {
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Eq;
+using ::testing::Return;
+using ::testing::ReturnRef;
+using ::testing::StrEq;
+using ::testing::StrictMock;
+
+namespace {
+/** One string column, one row per value. */
+class Column_resultset : public xpl::Collect_resultset {
+ public:
+  using Resultset = Buffering_command_delegate::Resultset;
+  using Row_data = Callback_command_delegate::Row_data;
+  using Field_value = Callback_command_delegate::Field_value;
+
+  Column_resultset(std::initializer_list<const char *> values) {
+    auto &callbacks = get_callbacks();
+    Resultset resultset;
+
+    for (const char *v : values) {
+      Row_data row;
+      row.fields.push_back(
+          ngs::allocate_object<Field_value>(v, std::strlen(v)));
+      resultset.push_back(row);
+    }
+
+    callbacks.set_resultset(resultset);
+    callbacks.set_field_types({{MYSQL_TYPE_STRING, 0}});
+  }
+};
+
+#define ALPHA "alpha"
+#define BETA "beta"
+#define QUOTE(var) "'" var "'"
+#define IDENT(var) "`" var "`"
+#define GET_KEY_COLUMNS                                           \
+  "SELECT COLUMN_NAME FROM information_schema.KEY_COLUMN_USAGE "  \
+  "WHERE CONSTRAINT_NAME = 'PRIMARY' AND TABLE_SCHEMA = " QUOTE( \
+      ALPHA) " AND TABLE_NAME = " QUOTE(BETA) " ORDER BY ORDINAL_POSITION"
+#define GET_COLUMNS                                                   \
+  "SELECT COLUMN_NAME FROM information_schema.COLUMNS "               \
+  "WHERE GENERATION_EXPRESSION = '' AND TABLE_SCHEMA = " QUOTE(ALPHA) \
+  " AND TABLE_NAME = " QUOTE(BETA) " ORDER BY ORDINAL_POSITION"
+#define TABLE IDENT(ALPHA) "." IDENT(BETA)
+#define BY_KEY " WHERE (" IDENT("id") ") IN ((?))"
+#define PUT                                                          \
+  "INSERT INTO " TABLE " (" IDENT("id") "," IDENT("v") ") VALUES (?,?)" \
+  " ON DUPLICATE KEY UPDATE " IDENT("v") "=VALUES(" IDENT("v") ")"
+
+const Column_resultset KEY_COLUMNS{"id"};
+// "g" is generated, the server leaves it out of the column list
+const Column_resultset COLUMNS{"id", "v"};
+}  // namespace
+
+class Galaxy_kv_command_handler_test : public ::testing::Test {
+ public:
+  using Sql = ngs::PFS_string;
+  using Msg = Mysqlx::Sql::GalaxyStmtExecute;
+
+  void SetUp() {
+    EXPECT_CALL(session, data_context())
+        .WillRepeatedly(ReturnRef(data_context));
+    EXPECT_CALL(session, proto()).WillRepeatedly(ReturnRef(encoder));
+    EXPECT_CALL(session, get_notice_output_queue())
+        .WillRepeatedly(ReturnRef(notice_output_queue));
+    EXPECT_CALL(session, get_notice_configuration())
+        .WillRepeatedly(ReturnRef(notice_configuration));
+    EXPECT_CALL(encoder, get_metadata_builder())
+        .WillRepeatedly(Return(&meta_builder));
+  }
+
+  Msg &message(const char *stmt, std::initializer_list<Any> args) {
+    msg.Clear();
+    msg.set_namespace_(Galaxy_kv_command_handler::k_kv_namespace);
+    msg.set_stmt(stmt);
+    msg.set_db_name(ALPHA);
+    for (const auto &arg : args) msg.add_args()->CopyFrom(arg);
+    return msg;
+  }
+
+  void expect_table_info() {
+    EXPECT_CALL(data_context, execute(Eq(Sql(GET_KEY_COLUMNS)), _, _))
+        .WillOnce(DoAll(SetUpResultset(KEY_COLUMNS), Return(ngs::Success())));
+    EXPECT_CALL(data_context, execute(Eq(Sql(GET_COLUMNS)), _, _))
+        .WillOnce(DoAll(SetUpResultset(COLUMNS), Return(ngs::Success())));
+  }
+
+  void expect_prepare(const char *query) {
+    EXPECT_CALL(data_context, prepare_prep_stmt(StrEq(query), _, _))
+        .WillOnce(Return(ngs::Success()));
+  }
+
+  Msg msg;
+  ngs::Metadata_builder meta_builder;
+  StrictMock<ngs::test::Mock_sql_data_context> data_context;
+  StrictMock<ngs::test::Mock_protocol_encoder> encoder;
+  StrictMock<ngs::test::Mock_notice_output_queue> notice_output_queue;
+  StrictMock<ngs::test::Mock_notice_configuration> notice_configuration;
+  StrictMock<ngs::test::Mock_session> session;
+  Galaxy_kv_command_handler handler{&session};
+};
+
+TEST_F(Galaxy_kv_command_handler_test, get_prepares_once) {
+  expect_table_info();
+  expect_prepare("SELECT * FROM " TABLE BY_KEY);
+  EXPECT_CALL(data_context, execute_prep_stmt(0, false, _, 1, _))
+      .Times(2)
+      .WillRepeatedly(Return(ngs::Success()));
+
+  ASSERT_ERROR_CODE(ER_X_SUCCESS, handler.execute(message("get", {BETA, 1})));
+  ASSERT_ERROR_CODE(ER_X_SUCCESS, handler.execute(message("get", {BETA, 2})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, get_missing_key) {
+  ASSERT_ERROR_CODE(ER_X_CMD_NUM_ARGUMENTS,
+                    handler.execute(message("get", {BETA})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, get_too_many_key_values) {
+  expect_table_info();
+  ASSERT_ERROR_CODE(ER_X_CMD_NUM_ARGUMENTS,
+                    handler.execute(message("get", {BETA, 1, 2})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, get_table_without_primary_key) {
+  EXPECT_CALL(data_context, execute(Eq(Sql(GET_KEY_COLUMNS)), _, _))
+      .WillOnce(Return(ngs::Success()));
+  EXPECT_CALL(data_context, execute(Eq(Sql(GET_COLUMNS)), _, _))
+      .WillOnce(Return(ngs::Success()));
+  ASSERT_ERROR_CODE(ER_X_CMD_ARGUMENT_VALUE,
+                    handler.execute(message("get", {BETA, 1})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, get_table_info_error) {
+  EXPECT_CALL(data_context, execute(Eq(Sql(GET_KEY_COLUMNS)), _, _))
+      .WillOnce(Return(ngs::Error(ER_TABLEACCESS_DENIED_ERROR, "denied")));
+  ASSERT_ERROR_CODE(ER_TABLEACCESS_DENIED_ERROR,
+                    handler.execute(message("get", {BETA, 1})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, get_execute_error_evicts_table) {
+  expect_table_info();
+  expect_prepare("SELECT * FROM " TABLE BY_KEY);
+  EXPECT_CALL(data_context, execute_prep_stmt(0, false, _, 1, _))
+      .WillOnce(Return(ngs::Error(ER_NO_SUCH_TABLE, "no such table")));
+  EXPECT_CALL(data_context, deallocate_prep_stmt(0, _))
+      .WillOnce(Return(ngs::Success()));
+  EXPECT_CALL(notice_configuration,
+              is_notice_enabled(ngs::Notice_type::k_warning))
+      .WillOnce(Return(false));
+
+  ASSERT_ERROR_CODE(ER_NO_SUCH_TABLE,
+                    handler.execute(message("get", {BETA, 1})));
+
+  // The table is looked up again on the next use
+  EXPECT_CALL(data_context, execute(Eq(Sql(GET_KEY_COLUMNS)), _, _))
+      .WillOnce(Return(ngs::Error(ER_NO_SUCH_TABLE, "no such table")));
+  ASSERT_ERROR_CODE(ER_NO_SUCH_TABLE,
+                    handler.execute(message("get", {BETA, 1})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, put_skips_generated_columns) {
+  expect_table_info();
+  expect_prepare(PUT);
+  EXPECT_CALL(data_context, execute_prep_stmt(0, false, _, 2, _))
+      .WillOnce(Return(ngs::Success()));
+
+  ASSERT_ERROR_CODE(ER_X_SUCCESS,
+                    handler.execute(message("put", {BETA, 1, "one"})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, put_key_only_table) {
+  EXPECT_CALL(data_context, execute(Eq(Sql(GET_KEY_COLUMNS)), _, _))
+      .WillOnce(DoAll(SetUpResultset(KEY_COLUMNS), Return(ngs::Success())));
+  EXPECT_CALL(data_context, execute(Eq(Sql(GET_COLUMNS)), _, _))
+      .WillOnce(DoAll(SetUpResultset(KEY_COLUMNS), Return(ngs::Success())));
+  expect_prepare("INSERT INTO " TABLE " (" IDENT("id") ") VALUES (?)"
+                 " ON DUPLICATE KEY UPDATE " IDENT("id") "=VALUES(" IDENT(
+                     "id") ")");
+  EXPECT_CALL(data_context, execute_prep_stmt(0, false, _, 1, _))
+      .WillOnce(Return(ngs::Success()));
+
+  ASSERT_ERROR_CODE(ER_X_SUCCESS, handler.execute(message("put", {BETA, 1})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, put_no_writable_column) {
+  // Only a generated primary key
+  EXPECT_CALL(data_context, execute(Eq(Sql(GET_KEY_COLUMNS)), _, _))
+      .WillOnce(DoAll(SetUpResultset(KEY_COLUMNS), Return(ngs::Success())));
+  EXPECT_CALL(data_context, execute(Eq(Sql(GET_COLUMNS)), _, _))
+      .WillOnce(Return(ngs::Success()));
+  ASSERT_ERROR_CODE(ER_X_CMD_ARGUMENT_VALUE,
+                    handler.execute(message("put", {BETA, 1})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, put_missing_value) {
+  expect_table_info();
+  ASSERT_ERROR_CODE(ER_X_CMD_NUM_ARGUMENTS,
+                    handler.execute(message("put", {BETA, 1})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, put_duplicate_key_error) {
+  expect_table_info();
+  expect_prepare(PUT);
+  EXPECT_CALL(data_context, execute_prep_stmt(0, false, _, 2, _))
+      .WillOnce(Return(ngs::Error(ER_DUP_ENTRY, "duplicate entry")));
+  EXPECT_CALL(data_context, deallocate_prep_stmt(0, _))
+      .WillOnce(Return(ngs::Success()));
+  EXPECT_CALL(notice_configuration,
+              is_notice_enabled(ngs::Notice_type::k_warning))
+      .WillOnce(Return(false));
+
+  ASSERT_ERROR_CODE(ER_DUP_ENTRY,
+                    handler.execute(message("put", {BETA, 1, "one"})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, delete_by_key) {
+  expect_table_info();
+  expect_prepare("DELETE FROM " TABLE BY_KEY);
+  EXPECT_CALL(data_context, execute_prep_stmt(0, false, _, 1, _))
+      .WillOnce(Return(ngs::Success()));
+
+  ASSERT_ERROR_CODE(ER_X_SUCCESS,
+                    handler.execute(message("delete", {BETA, 1})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, delete_missing_key) {
+  ASSERT_ERROR_CODE(ER_X_CMD_NUM_ARGUMENTS,
+                    handler.execute(message("delete", {BETA})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, unknown_command) {
+  ASSERT_ERROR_CODE(ER_X_INVALID_ADMIN_COMMAND,
+                    handler.execute(message("scan", {BETA, 1})));
+}
+
+TEST_F(Galaxy_kv_command_handler_test, no_database) {
+  message("get", {BETA, 1}).clear_db_name();
+  ASSERT_ERROR_CODE(ER_NO_DB_ERROR, handler.execute(msg));
+}
+
+}  // namespace test
+}  // namespace xpl
@@ -543,6 +543,7 @@ static int ssl_do(struct st_VioSSLFd *ptr, Vio *vio, long timeout,
 
     DBUG_PRINT("info", ("SSL connection succeeded"));
     DBUG_PRINT("info", ("Using cipher: '%s'", SSL_get_cipher_name(ssl)));
+    DBUG_PRINT("info", ("Kernel TLS: '%s'", vio_ssl_ktls_state(ssl)));
 
     if ((cert = SSL_get_peer_certificate(ssl))) {
       DBUG_PRINT("info", ("Peer certificate:"));
@@ -564,6 +565,28 @@ static int ssl_do(struct st_VioSSLFd *ptr, Vio *vio, long timeout,
   return 0;
 }
 
+/**
+  Tell which directions of an SSL connection are encrypted by the kernel,
+  see VIO_SSL_CTX_KTLS. SSL_write() and SSL_read() then pass the plain data
+  to the socket instead of encrypting it themselves.
+
+  @param ssl  the SSL connection
+  @return "TX,RX", "TX", "RX", or "" if OpenSSL does all the encryption
+*/
+const char *vio_ssl_ktls_state(SSL *ssl) {
+#if !defined(OPENSSL_NO_KTLS) && defined(BIO_get_ktls_send)
+  bool send = BIO_get_ktls_send(SSL_get_wbio(ssl));
+  bool recv = BIO_get_ktls_recv(SSL_get_rbio(ssl));
+
+  if (send && recv) return "TX,RX";
+  if (send) return "TX";
+  if (recv) return "RX";
+#else
+  (void)ssl;
+#endif /* !OPENSSL_NO_KTLS && BIO_get_ktls_send */
+  return "";
+}
+
 int sslaccept(struct st_VioSSLFd *ptr, Vio *vio, long timeout,
               unsigned long *ssl_errno_holder) {
   DBUG_TRACE;
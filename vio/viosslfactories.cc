@@ -557,7 +557,7 @@ static struct st_VioSSLFd *new_VioSSLFd(
 #ifdef HAVE_TLSv13
                      | SSL_OP_NO_TLSv1_3
 #endif /* HAVE_TLSv13 */
-                     | SSL_OP_NO_TICKET);
+                     | SSL_OP_NO_TICKET | VIO_SSL_CTX_KTLS);
   if (!(ssl_fd = ((struct st_VioSSLFd *)my_malloc(
             key_memory_vio_ssl_fd, sizeof(struct st_VioSSLFd), MYF(0)))))
     return 0;